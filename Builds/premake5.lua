@@ -621,3 +621,166 @@ if os.target() == "windows" then
 
 -- create VST3 projects on Windows only
 end
+
+--------------------------------------------------------------------------------
+
+    project ("squeezer_render")
+        kind "ConsoleApp"
+        targetdir "../bin/tools/"
+
+        defines {
+            "SQUEEZER_STEREO=1",
+            "SQUEEZER_EXTERNAL_SIDECHAIN=1",
+            "JucePlugin_Build_Standalone=0",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+              "../Source/tools/offline_renderer.h",
+              "../Source/tools/offline_renderer.cpp",
+              "../Source/tools/squeezer_render.cpp",
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+        filter { "system:linux" }
+            targetname "squeezer_render"
+
+        filter { "system:windows" }
+            targetname "Squeezer (Render"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/render_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/render_release")
+
+--------------------------------------------------------------------------------
+
+    project ("squeezer_batch")
+        kind "ConsoleApp"
+        targetdir "../bin/tools/"
+
+        defines {
+            "SQUEEZER_STEREO=1",
+            "SQUEEZER_EXTERNAL_SIDECHAIN=1",
+            "JucePlugin_Build_Standalone=0",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+              "../Source/tools/offline_renderer.h",
+              "../Source/tools/offline_renderer.cpp",
+              "../Source/tools/batch_renderer.h",
+              "../Source/tools/batch_renderer.cpp",
+              "../Source/tools/squeezer_batch.cpp",
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+        filter { "system:linux" }
+            targetname "squeezer_batch"
+
+        filter { "system:windows" }
+            targetname "Squeezer (Batch"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/batch_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/batch_release")
+
+--------------------------------------------------------------------------------
+
+    project ("squeezer_benchmark")
+        kind "ConsoleApp"
+        targetdir "../bin/tools/"
+
+        defines {
+            "SQUEEZER_STEREO=1",
+            "SQUEEZER_EXTERNAL_SIDECHAIN=1",
+            "JucePlugin_Build_Standalone=0",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+              "../Source/tools/dsp_benchmark.h",
+              "../Source/tools/dsp_benchmark.cpp",
+              "../Source/tools/squeezer_benchmark.cpp",
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+        filter { "system:linux" }
+            targetname "squeezer_benchmark"
+
+        filter { "system:windows" }
+            targetname "Squeezer (Benchmark"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/benchmark_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/benchmark_release")
+
+--------------------------------------------------------------------------------
+
+    project ("squeezer_validate")
+        kind "ConsoleApp"
+        targetdir "../bin/tools/"
+
+        defines {
+            "SQUEEZER_STEREO=1",
+            "SQUEEZER_EXTERNAL_SIDECHAIN=1",
+            "JucePlugin_Build_Standalone=0",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+              "../Source/tools/allocation_hooks.cpp",
+              "../Source/tools/golden_validator.h",
+              "../Source/tools/golden_validator.cpp",
+              "../Source/tools/squeezer_validate.cpp",
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+        filter { "system:linux" }
+            targetname "squeezer_validate"
+
+        filter { "system:windows" }
+            targetname "Squeezer (Validate"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/validate_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/validate_release")
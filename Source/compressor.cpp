@@ -26,28 +26,125 @@
 #include "compressor.h"
 
 
-Compressor::Compressor(int channels, int sample_rate) :
+constexpr double CompressorBase::MaximumLookAhead;
+constexpr int CompressorBase::MaximumOversampling;
+
+
+template <typename SampleType>
+Compressor<SampleType>::Compressor(int channels, int sample_rate, int maximum_block_size) :
     // the meter's sample buffer holds 50 ms worth of samples
     BufferLength(0.050),
     NumberOfChannels(channels),
     SampleRate(sample_rate),
+    ProcessingSampleRate(sample_rate),
     MeterBufferSize((int)(SampleRate * BufferLength)),
-    MeterInputBuffer(NumberOfChannels, MeterBufferSize),
-    MeterOutputBuffer(NumberOfChannels, MeterBufferSize)
+    MaximumBlockSize(maximum_block_size),
+    Ballistics(double(MeterBufferSize) / SampleRate),
+    // work buffers are allocated once so that processing never
+    // allocates memory; they hold blocks at the maximum oversampling
+    // factor
+    BlockInputSamples(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    BlockSidechainSamples(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    BlockSidechainLevels(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    BlockGainReduction(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    BlockGainReductionWithMakeup(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    BlockGainFactors(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    BlockMakeupGains(1, MaximumBlockSize * MaximumOversampling),
+    BlockWetMixes(1, MaximumBlockSize * MaximumOversampling),
+    BlockGainReductionSigns(1, MaximumBlockSize * MaximumOversampling),
+    MeterInputSamples(NumberOfChannels, MaximumBlockSize),
+    // the delay line holds the maximum look-ahead plus the sample
+    // that is written before the delayed sample is read
+    LookAheadDelay(NumberOfChannels,
+                   roundToInt(MaximumLookAhead * SampleRate / 1000.0) + 1),
+    LookAheadSidechainSamples(NumberOfChannels, MaximumBlockSize),
+    SidechainListenDelay(NumberOfChannels,
+                         roundToInt(MaximumLookAhead * SampleRate / 1000.0) + 1),
+    OversampledMainSamples(NumberOfChannels, MaximumBlockSize * MaximumOversampling),
+    OversampledSidechainSamples(NumberOfChannels, MaximumBlockSize * MaximumOversampling)
 {
     jassert((NumberOfChannels == 1) || (NumberOfChannels == 2));
+    jassert(NumberOfChannels <= MeterSnapshot::MaximumNumberOfChannels);
+    jassert(MaximumBlockSize > 0);
 
-    CrestFactor = 20.0;
+    CrestFactor = SampleType(20.0);
+    MeterStandardRequested = Ballistics.getStandard();
     UseUpwardExpansion = false;
+    ProcessingMode = Compressor::ProcessBlockwise;
+
+    // look-ahead is disabled by default (no latency)
+    LookAheadMilliSeconds = 0.0;
+    LookAheadSamplesRequested = 0;
+    LookAheadSamples = 0;
+    LookAheadWritePosition = 0;
+    LookAheadIsActive = false;
+
+    LookAheadDelay.clear();
+    LatencySamples = 0;
+
+    // crossfade runs at the original sample rate (look-ahead is
+    // applied before oversampling)
+    LookAheadSamplesPrevious = 0;
+    LookAheadCrossfade.reset(SampleRate, SideChainBase::SmoothingLength);
+    LookAheadCrossfade.setCurrentAndTargetValue(SampleType(1.0));
+
+    SidechainListenDelay.clear();
+    SidechainListenWritePosition = 0;
+    SidechainListenEnabled = false;
+
+    // oversampling is disabled by default
+    OversamplingFactorRequested = 1;
+    OversamplingFactor = 1;
+
+    MainOversampler = nullptr;
+    SidechainOversampler = nullptr;
 
-    // fall time: 26 dB in 3 seconds (linear)
-    ReleaseCoefLinear = 26.0 * BufferLength / 3.0;
+    for (int Factor = 2; Factor <= MaximumOversampling; Factor *= 2)
+    {
+        MainOversamplers.add(
+            new frut::dsp::Oversampler<SampleType>(
+                NumberOfChannels, Factor, MaximumBlockSize));
+
+        SidechainOversamplers.add(
+            new frut::dsp::Oversampler<SampleType>(
+                NumberOfChannels, Factor, MaximumBlockSize));
+    }
 
     MeterBufferPosition = 0;
 
+    // meters are enabled by default
+    UseMeters = true;
+    EngineUpdatesMeters = false;
+
+    // true-peak meters are disabled by default (no background thread)
+    UseTruePeakMeters = false;
+    TruePeakMetersEnabled = false;
+
+    // loudness meters are disabled by default (no background thread)
+    UseLoudnessMeters = false;
+
+    // gain reduction history is optional
+    History = nullptr;
+
     // reset meter and set up array members
     resetMeters();
 
+    // ramp make-up gain and wet mix to prevent zipper noise
+    SmoothedMakeupGain.reset(ProcessingSampleRate, SideChainBase::SmoothingLength);
+    SmoothedMakeupGain.setCurrentAndTargetValue(SampleType(1.0));
+    MakeupGainTarget = SampleType(1.0);
+    MakeupGain = SampleType(1.0);
+
+    SmoothedWetMix.reset(ProcessingSampleRate, SideChainBase::SmoothingLength);
+    SmoothedWetMix.setCurrentAndTargetValue(SampleType(1.0));
+    WetMixTarget = SampleType(1.0);
+    WetMix = SampleType(1.0);
+    DryMix = SampleType(0.0);
+
+    SmoothedGainReductionSign.reset(ProcessingSampleRate, SideChainBase::SmoothingLength);
+    SmoothedGainReductionSign.setCurrentAndTargetValue(SampleType(-1.0));
+    GainReductionSign = SampleType(-1.0);
+
     WetMixPercentage = 100;
     setBypass(false);
     setDesign(Compressor::DesignFeedForward);
@@ -61,23 +158,18 @@ Compressor::Compressor(int channels, int sample_rate) :
 
     for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
-        SideChainProcessor.add(new SideChain(SampleRate));
-
-        InputSamples.add(0.0);
-        SidechainSamples.add(0.0);
-        OutputSamples.add(0.0);
-
-        // initialise side-chain high-pass filter
-        SidechainFilter_HPF.add(
-            new frut::dsp::IirFilterBox(
-                NumberOfChannels, SampleRate));
-
-        // initialise side-chain low-pass filter
-        SidechainFilter_LPF.add(
-            new frut::dsp::IirFilterBox(
-                NumberOfChannels, SampleRate));
+        InputSamples.add(SampleType(0.0));
+        SidechainSamples.add(SampleType(0.0));
+        OutputSamples.add(SampleType(0.0));
+
+        MeterInputPeaks.add(SampleType(0.0));
+        MeterOutputPeaks.add(SampleType(0.0));
+        MeterInputSumsOfSquares.add(0.0);
+        MeterOutputSumsOfSquares.add(0.0);
     }
 
+    createSideChains();
+
     // disable external side-chain
     setSidechainInput(false);
     setSidechainListen(false);
@@ -85,19 +177,60 @@ Compressor::Compressor(int channels, int sample_rate) :
     // bypass side-chain filters
     setSidechainHPFCutoff(0);
     setSidechainLPFCutoff(0);
+
+    // start with initial values instead of ramping towards them
+    skipSmoothing();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::createSideChains()
+/*  Create side chains and side-chain filters for all oversampling
+    factors and use those of the original sample rate.  This
+    allocates memory, so do not call this function on the audio
+    thread!
+
+    return value: none
+ */
+{
+    for (int Factor = 1; Factor <= MaximumOversampling; Factor *= 2)
+    {
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            AllSideChains.add(new SideChain<SampleType>(SampleRate * Factor));
+
+            // initialise side-chain high-pass filter
+            AllSidechainFilters_HPF.add(
+                new frut::dsp::IirFilterBox(
+                    NumberOfChannels, SampleRate * Factor));
+
+            // initialise side-chain low-pass filter
+            AllSidechainFilters_LPF.add(
+                new frut::dsp::IirFilterBox(
+                    NumberOfChannels, SampleRate * Factor));
+        }
+    }
+
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        SideChainProcessor.add(AllSideChains[CurrentChannel]);
+        SidechainFilter_HPF.add(AllSidechainFilters_HPF[CurrentChannel]);
+        SidechainFilter_LPF.add(AllSidechainFilters_LPF[CurrentChannel]);
+    }
 }
 
 
-void Compressor::resetMeters()
+template <typename SampleType>
+void Compressor<SampleType>::resetMeters()
 {
-    double MeterMinimumDecibel = -(70.01 + CrestFactor);
+    double MeterMinimumDecibel = -(70.01 + getMeterCrestFactor());
 
     // loop through all audio channels
     for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
         // set gain reduction to zero
-        GainReduction.set(CurrentChannel, 0.0);
-        GainReductionWithMakeup.set(CurrentChannel, 0.0);
+        GainReduction.set(CurrentChannel, SampleType(0.0));
+        GainReductionWithMakeup.set(CurrentChannel, SampleType(0.0));
 
         // set peak meter levels to meter minimum
         PeakMeterInputLevels.set(CurrentChannel, MeterMinimumDecibel);
@@ -107,618 +240,1769 @@ void Compressor::resetMeters()
         AverageMeterInputLevels.set(CurrentChannel, MeterMinimumDecibel);
         AverageMeterOutputLevels.set(CurrentChannel, MeterMinimumDecibel);
     }
+
+    resetTruePeakMeters();
 }
 
 
-bool Compressor::getBypass()
-/*  Get current bypass state.
+template <typename SampleType>
+int Compressor<SampleType>::getMeterCrestFactor()
+/*  Get headroom of the requested metering standard.  May be called
+    from any thread.
 
-    return value (boolean): returns current bypass state
+    return value (integer): crest factor in decibels
  */
 {
-    return CompressorIsBypassed;
+    return frut::dsp::MeterBallistics::getCrestFactor(
+               MeterStandardRequested.get());
 }
 
 
-void Compressor::setBypass(bool CompressorIsBypassedNew)
-/*  Set new bypass state.
-
-    CompressorIsBypassedNew (boolean): new bypass state
+template <typename SampleType>
+void Compressor<SampleType>::resetTruePeakMeters()
+/*  Set true-peak meter levels to meter minimum.
 
     return value: none
  */
 {
-    CompressorIsBypassed = CompressorIsBypassedNew;
-    CompressorIsBypassedCombined = (CompressorIsBypassed || (WetMixPercentage == 0));
-}
-
-
-double Compressor::getRmsWindowSize()
-/*  Get current detector RMS window size.
-
-    return value (double): returns current current detector RMS window
-    size
-*/
-{
-    return SideChainProcessor[0]->getRmsWindowSize();
-}
-
-
-void Compressor::setRmsWindowSize(double RmsWindowSizeMilliSecondsNew)
-/*  Set new detector RMS window size.
-
-    RmsWindowSizeMilliSecondsNew (double): new detector RMS window size
+    double MeterMinimumDecibel = -(70.01 + getMeterCrestFactor());
 
-    return value: none
-*/
-{
     for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
-        SideChainProcessor[CurrentChannel]->setRmsWindowSize(RmsWindowSizeMilliSecondsNew);
+        TruePeakMeterInputLevels.set(CurrentChannel, MeterMinimumDecibel);
+        TruePeakMeterOutputLevels.set(CurrentChannel, MeterMinimumDecibel);
     }
 }
 
 
-int Compressor::getDesign()
-/*  Get current compressor design.
+template <typename SampleType>
+void Compressor<SampleType>::reset()
+/*  Clear processing state (envelopes, filters, meters), so that the
+    next block is processed as if the compressor had just been
+    created.  Parameters and allocated buffers are kept, so a single
+    instance can process several unrelated signals in a row.
 
-    return value (integer): returns the current compressor design
+    return value: none
  */
 {
-    return CompressorDesign;
-}
-
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        SideChainProcessor[CurrentChannel]->reset();
 
-void Compressor::setDesign(int CompressorDesignNew)
-/*  Set new compressor design.
+        SidechainFilter_HPF[CurrentChannel]->resetDelays();
+        SidechainFilter_LPF[CurrentChannel]->resetDelays();
 
-    CompressorDesignNew (integer): new compressor design
+        InputSamples.set(CurrentChannel, SampleType(0.0));
+        SidechainSamples.set(CurrentChannel, SampleType(0.0));
+        OutputSamples.set(CurrentChannel, SampleType(0.0));
+    }
 
-    return value: none
- */
-{
-    CompressorDesign = CompressorDesignNew;
-    DesignIsFeedForward = (CompressorDesign == Compressor::DesignFeedForward);
-}
+    LookAheadDelay.clear();
+    LookAheadWritePosition = 0;
 
+    SidechainListenDelay.clear();
+    SidechainListenWritePosition = 0;
 
-double Compressor::getThreshold()
-/*  Get current threshold.
+    if (MainOversampler)
+    {
+        MainOversampler->reset();
+        SidechainOversampler->reset();
+    }
 
-    return value (double): returns the current threshold in decibels
- */
-{
-    return SideChainProcessor[0]->getThreshold();
+    restartMeters();
+    resetLoudnessMeters();
+    skipSmoothing();
 }
 
 
-void Compressor::setThreshold(double ThresholdNew)
-/*  Set new threshold.
-
-    ThresholdNew (double): new threshold in decibels
+template <typename SampleType>
+void Compressor<SampleType>::restartMeters()
+/*  Discard partially filled meter buffer and reset meters.
 
     return value: none
  */
 {
     for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
-        SideChainProcessor[CurrentChannel]->setThreshold(ThresholdNew);
+        MeterInputPeaks.set(CurrentChannel, SampleType(0.0));
+        MeterOutputPeaks.set(CurrentChannel, SampleType(0.0));
+        MeterInputSumsOfSquares.set(CurrentChannel, 0.0);
+        MeterOutputSumsOfSquares.set(CurrentChannel, 0.0);
     }
+
+    MeterBufferPosition = 0;
+
+    resetMeters();
 }
 
 
-double Compressor::getRatio()
-/*  Get current compression ratio.
+template <typename SampleType>
+void Compressor<SampleType>::skipSmoothing()
+/*  Finish all parameter ramps by jumping to their target values.
+    Call this after setting up the compressor, so that processing
+    does not start with ramps from the default values.
 
-    return value (double): returns the current compression ratio
+    return value: none
  */
 {
-    double RatioNew = SideChainProcessor[0]->getRatio();
-
-    if (UseUpwardExpansion)
-    {
-        return 1.0 / RatioNew;
-    }
-    else
-    {
-        return RatioNew;
-    }
-}
+    SmoothedMakeupGain.setCurrentAndTargetValue(
+        MakeupGainTarget.get());
+    MakeupGain = SmoothedMakeupGain.getCurrentValue();
 
+    SmoothedWetMix.setCurrentAndTargetValue(
+        WetMixTarget.get());
+    WetMix = SmoothedWetMix.getCurrentValue();
+    DryMix = SampleType(1.0) - WetMix;
 
-void Compressor::setRatio(double RatioNew)
-/*  Set new compression ratio.
+    SmoothedGainReductionSign.setCurrentAndTargetValue(
+        UseUpwardExpansion.get() ? SampleType(1.0) : SampleType(-1.0));
+    GainReductionSign = SmoothedGainReductionSign.getCurrentValue();
 
-    RatioNew (double): new compression ratio
+    updateCombinedBypass();
 
-    return value: none
- */
-{
-    if (RatioNew < 1.0)
-    {
-        UseUpwardExpansion = true;
-        RatioNew = 1.0 / RatioNew;
-    }
-    else
-    {
-        UseUpwardExpansion = false;
-    }
+    // a running crossfade would defer the latest look-ahead, so
+    // finish it before and after switching
+    LookAheadCrossfade.setCurrentAndTargetValue(SampleType(1.0));
+    applyLatencyChanges();
+    LookAheadCrossfade.setCurrentAndTargetValue(SampleType(1.0));
 
     for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
-        SideChainProcessor[CurrentChannel]->setRatio(RatioNew);
+        SideChainProcessor[CurrentChannel]->skipSmoothing();
     }
 }
 
 
-double Compressor::getKneeWidth()
-/*  Get current knee width.
+template <typename SampleType>
+int Compressor<SampleType>::getProcessingMode()
+/*  Get current processing mode.
 
-    return value (double): returns the current knee width in decibels
+    return value (integer): returns the current processing mode
  */
 {
-    return SideChainProcessor[0]->getKneeWidth();
+    return ProcessingMode;
 }
 
 
-void Compressor::setKneeWidth(double KneeWidthNew)
-/*  Set new knee width.
+template <typename SampleType>
+void Compressor<SampleType>::setProcessingMode(int ProcessingModeNew)
+/*  Set new processing mode.  The per-sample engine is kept as a
+    reference for the block-based engine, which converts levels using
+    fast approximations; output of both engines differs by far less
+    than 0.001 dB.
 
-    KneeWidthNew (double): new knee width in decibels
+    ProcessingModeNew (integer): new processing mode
 
     return value: none
  */
 {
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
-    {
-        SideChainProcessor[CurrentChannel]->setKneeWidth(KneeWidthNew);
-    }
-
+    ProcessingMode = ProcessingModeNew;
 }
 
 
-double Compressor::getAttackRate()
-/*  Get current attack rate.
+template <typename SampleType>
+bool Compressor<SampleType>::getBypass()
+/*  Get current bypass state.
 
-    return value (double): returns the current attack rate in
-    milliseconds
+    return value (boolean): returns current bypass state
  */
 {
-    return SideChainProcessor[0]->getAttackRate();
+    return CompressorIsBypassed;
 }
 
 
-void Compressor::setAttackRate(double AttackRateNew)
-/*  Set new attack rate.
+template <typename SampleType>
+void Compressor<SampleType>::setBypass(bool CompressorIsBypassedNew)
+/*  Set new bypass state.
 
-    AttackRateNew (double): new attack rate in milliseconds
+    CompressorIsBypassedNew (boolean): new bypass state
 
     return value: none
  */
 {
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
-    {
-        SideChainProcessor[CurrentChannel]->setAttackRate(AttackRateNew);
-    }
+    // combined bypass state is updated by the audio thread
+    CompressorIsBypassed = CompressorIsBypassedNew;
 }
 
 
-int Compressor::getReleaseRate()
-/*  Get current release rate.
+template <typename SampleType>
+double Compressor<SampleType>::getLookAhead()
+/*  Get current look-ahead.
 
-    return value (integer): returns the current release rate in
+    return value (double): returns the current look-ahead in
     milliseconds
  */
 {
-    return SideChainProcessor[0]->getReleaseRate();
+    return LookAheadMilliSeconds;
 }
 
 
-void Compressor::setReleaseRate(int ReleaseRateNew)
-/*  Set new release rate.
+template <typename SampleType>
+void Compressor<SampleType>::setLookAhead(double LookAheadMilliSecondsNew)
+/*  Set new look-ahead.  The main path is delayed by the look-ahead
+    while the side chain is not, so gain reduction sets in before the
+    audio arrives.  The audio thread switches to the new look-ahead
+    when it starts the next block and crossfades from the previous
+    delay, so this function never allocates memory and may be called
+    from any thread.
 
-    ReleaseRateNew (integer): new release rate in milliseconds
+    LookAheadMilliSecondsNew (double): new look-ahead in milliseconds
+    (0 disables look-ahead)
 
     return value: none
  */
 {
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
-    {
-        SideChainProcessor[CurrentChannel]->setReleaseRate(ReleaseRateNew);
-    }
+    LookAheadMilliSeconds = jlimit(0.0, MaximumLookAhead,
+                                   LookAheadMilliSecondsNew);
+
+    LookAheadSamplesRequested = roundToInt(
+                                    LookAheadMilliSeconds * SampleRate / 1000.0);
 }
 
 
-int Compressor::getCurve()
-/*  Get current compressor curve type.
+template <typename SampleType>
+int Compressor<SampleType>::getOversampling()
+/*  Get current oversampling factor.
 
-    return value (integer): returns compressor curve type
+    return value (integer): returns the current oversampling factor
+    (1 means no oversampling)
  */
 {
-    return SideChainProcessor[0]->getCurve();
+    return OversamplingFactorRequested.get();
 }
 
 
-void Compressor::setCurve(int CurveTypeNew)
-/*  Set new compressor curve type.
+template <typename SampleType>
+void Compressor<SampleType>::setOversampling(int OversamplingFactorNew)
+/*  Set new oversampling factor.  Side chain, gain stage and gain
+    multiplication run at the oversampled rate; the compressor's
+    settings are kept.  The audio thread switches to the new factor
+    when it starts the next block, so this function never allocates
+    memory and may be called from any thread.
 
-    CurveTypeNew (integer): new compressor curve type
+    OversamplingFactorNew (integer): new oversampling factor (1
+    disables oversampling; 2, 4 and 8 are supported)
 
     return value: none
  */
 {
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    if (!frut::dsp::Oversampler<SampleType>::isValidOversamplingFactor(
+                OversamplingFactorNew))
     {
-        SideChainProcessor[CurrentChannel]->setCurve(CurveTypeNew);
+        OversamplingFactorNew = 1;
     }
+
+    OversamplingFactorRequested = OversamplingFactorNew;
 }
 
 
-int Compressor::getGainStage()
-/*  Get current compressor gain stage type.
+template <typename SampleType>
+int Compressor<SampleType>::getLatencySamples()
+/*  Get latency caused by look-ahead and oversampling.  Changed
+    settings only count once the audio thread has switched to them
+    (or "skipSmoothing" has been called), so this is the latency of
+    the audio that is actually being processed.
 
-    return value (integer): returns compressor gain stage type
+    return value (integer): returns the latency in samples
  */
 {
-    return SideChainProcessor[0]->getGainStage();
+    return LatencySamples.get();
 }
 
 
-void Compressor::setGainStage(int GainStageTypeNew)
-/*  Set new compressor gain stage type.
-
-    GainStageTypeNew (integer): new compressor gain stage type
+template <typename SampleType>
+void Compressor<SampleType>::updateCombinedBypass()
+/*  Update combined bypass state.  A wet mix of 0 percent bypasses
+    the compressor, but only after the wet mix has finished ramping
+    down.
 
     return value: none
  */
 {
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
-    {
-        SideChainProcessor[CurrentChannel]->setGainStage(GainStageTypeNew);
-    }
+    CompressorIsBypassedCombined = (CompressorIsBypassed ||
+                                    ((SmoothedWetMix.getTargetValue() == SampleType(0.0)) &&
+                                     !SmoothedWetMix.isSmoothing()));
 }
 
 
-int Compressor::getStereoLink()
-/*  Get current stereo link percentage.
+template <typename SampleType>
+void Compressor<SampleType>::updateSmoothingTargets()
+/*  Let parameter ramps head for the latest targets.  Must only be
+    called by the audio thread (before processing a block).
 
-    return value (integer): returns the current stereo link percentage
-    (0 to 100)
+    return value: none
  */
 {
-    return StereoLinkPercentage;
-}
+    // does nothing if the target has not changed
+    SmoothedMakeupGain.setTargetValue(MakeupGainTarget.get());
+    SmoothedWetMix.setTargetValue(WetMixTarget.get());
+    SmoothedGainReductionSign.setTargetValue(
+        UseUpwardExpansion.get() ? SampleType(1.0) : SampleType(-1.0));
 
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        SideChainProcessor[CurrentChannel]->updateSmoothingTargets();
+    }
+}
 
-void Compressor::setStereoLink(int StereoLinkPercentageNew)
-/*  Set new stereo link percentage.
 
-    StereoLinkPercentageNew (integer): new stereo link percentage (0 to 100)
+template <typename SampleType>
+void Compressor<SampleType>::applyLatencyChanges()
+/*  Switch to the latest look-ahead and oversampling factor and
+    update the reported latency.  Must only be called by the audio
+    thread (before processing a block) or while the compressor is not
+    processing.
 
     return value: none
  */
 {
-    StereoLinkPercentage = StereoLinkPercentageNew;
+    int OversamplingFactorNew = OversamplingFactorRequested.get();
 
-    // amplification factor for other channel ranging from 0.0 (no
-    // stereo linking) to 0.5 (full stereo linking)
-    StereoLinkWeightOther = StereoLinkPercentage / 200.0;
+    if (OversamplingFactorNew != OversamplingFactor)
+    {
+        OversamplingFactor = OversamplingFactorNew;
+        ProcessingSampleRate = SampleRate * OversamplingFactor;
 
-    // amplification factor for original channel ranging from 1.0 (no
-    // stereo linking) to 0.5 (full stereo linking)
-    StereoLinkWeight = 1.0 - StereoLinkWeightOther;
-}
+        int FactorIndex = 0;
 
+        for (int Factor = 1; Factor < OversamplingFactor; Factor *= 2)
+        {
+            ++FactorIndex;
+        }
 
-double Compressor::getInputTrim()
-/*  Get current input trim gain.
+        if (OversamplingFactor > 1)
+        {
+            MainOversampler = MainOversamplers[FactorIndex - 1];
+            SidechainOversampler = SidechainOversamplers[FactorIndex - 1];
 
-    return value (double): returns the current input trim gain in
-    decibels
- */
-{
-    return InputTrim;
-}
+            MainOversampler->reset();
+            SidechainOversampler->reset();
+        }
+        else
+        {
+            MainOversampler = nullptr;
+            SidechainOversampler = nullptr;
+        }
 
+        // start side chains of new factor with current settings
+        // instead of ramping towards them
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            int Index = FactorIndex * NumberOfChannels + CurrentChannel;
 
-void Compressor::setInputTrim(double InputTrimNew)
-/*  Set new input trim gain.
+            SideChainProcessor.set(CurrentChannel, AllSideChains[Index]);
+            SidechainFilter_HPF.set(CurrentChannel, AllSidechainFilters_HPF[Index]);
+            SidechainFilter_LPF.set(CurrentChannel, AllSidechainFilters_LPF[Index]);
 
-    InputTrimNew (double): new input trim gain in decibels
+            SideChainProcessor[CurrentChannel]->reset();
+            SideChainProcessor[CurrentChannel]->skipSmoothing();
 
-    return value: none
- */
-{
-    InputTrim = InputTrimNew;
-}
+            SidechainFilter_HPF[CurrentChannel]->resetDelays();
+            SidechainFilter_LPF[CurrentChannel]->resetDelays();
+        }
 
+        // ramps run at the processing sample rate
+        SmoothedMakeupGain.reset(ProcessingSampleRate, SideChainBase::SmoothingLength);
+        SmoothedWetMix.reset(ProcessingSampleRate, SideChainBase::SmoothingLength);
+        SmoothedGainReductionSign.reset(ProcessingSampleRate, SideChainBase::SmoothingLength);
+    }
 
-bool Compressor::getAutoMakeupGain()
-/*  Get current auto make-up gain state.
+    int LookAheadSamplesNew = LookAheadSamplesRequested.get();
 
-    return value (boolean): returns current auto make-up gain state
- */
-{
-    return UseAutoMakeupGain;
-}
+    // the delay line holds the latest input, so fade from the
+    // previous delay to the new one; further changes wait for the
+    // running crossfade to finish
+    if ((LookAheadSamplesNew != LookAheadSamples) &&
+            !LookAheadCrossfade.isSmoothing())
+    {
+        LookAheadSamplesPrevious = LookAheadSamples;
+        LookAheadSamples = LookAheadSamplesNew;
 
+        LookAheadCrossfade.setCurrentAndTargetValue(SampleType(0.0));
+        LookAheadCrossfade.setTargetValue(SampleType(1.0));
+    }
 
-void Compressor::setAutoMakeupGain(bool UseAutoMakeupGainNew)
-/*  Set new auto make-up gain state.
+    int LatencySamplesNew = LookAheadSamples;
 
-    UseAutoMakeupGainNew (boolean): new auto make-up gain state
+    if (MainOversampler)
+    {
+        LatencySamplesNew += MainOversampler->getLatencySamples();
+    }
 
-    return value: none
- */
-{
-    UseAutoMakeupGain = UseAutoMakeupGainNew;
+    LatencySamples = LatencySamplesNew;
 }
 
 
-double Compressor::getMakeupGain()
-/*  Get current make-up gain.
+template <typename SampleType>
+void Compressor<SampleType>::delaySamples(
+    AudioBuffer<SampleType> &Buffer,
+    AudioBuffer<SampleType> &DelayLine,
+    int &WritePosition,
+    int NumberOfSamples)
+/*  Delay buffer in place by the current look-ahead.  While the
+    look-ahead changes, the output crossfades from the previous
+    delay to the new one.  Does not advance the crossfade, so that
+    several buffers can be delayed alike.
 
-    return value (double): returns the current make-up gain in decibels
- */
-{
-    return MakeupGainDecibel;
-}
+    Buffer (AudioBuffer): input and output samples
 
+    DelayLine (AudioBuffer): delay line holding the maximum
+    look-ahead
 
-void Compressor::setMakeupGain(double MakeupGainNew)
-/*  Set new make-up gain.
+    WritePosition (integer): current position in delay line;
+    updated
 
-    nMakeupGainNew (double): new make-up gain in decibels
+    NumberOfSamples (integer): number of samples to delay
 
     return value: none
  */
 {
-    MakeupGainDecibel = MakeupGainNew;
-    MakeupGain = SideChain::decibel2level(MakeupGainDecibel);
-}
+    int DelayLength = DelayLine.getNumSamples();
+    int WritePositionNew = WritePosition;
+    bool IsCrossfading = LookAheadCrossfade.isSmoothing();
 
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        SampleType *Samples = Buffer.getWritePointer(CurrentChannel);
+        SampleType *DelayedSamples = DelayLine.getWritePointer(CurrentChannel);
 
-int Compressor::getWetMix()
-/*  Get current wet mix percentage.
+        // every channel is faded alike
+        SmoothedValue<SampleType> Crossfade = LookAheadCrossfade;
+        WritePositionNew = WritePosition;
 
-    return value (integer): returns the current wet mix percentage
-    (0 to 100)
- */
-{
-    return WetMixPercentage;
-}
+        for (int Sample = 0; Sample < NumberOfSamples; ++Sample)
+        {
+            // write current sample first, so that a look-ahead of
+            // zero samples passes it through unchanged
+            DelayedSamples[WritePositionNew] = Samples[Sample];
 
+            int ReadPosition = WritePositionNew - LookAheadSamples;
 
-void Compressor::setWetMix(int WetMixPercentageNew)
-/*  Set new wet mix percentage.
+            if (ReadPosition < 0)
+            {
+                ReadPosition += DelayLength;
+            }
 
-    WetMixPercentageNew (integer): new wet mix percentage (0 to 100)
+            SampleType OutputSample = DelayedSamples[ReadPosition];
 
-    return value: none
+            if (IsCrossfading)
+            {
+                int ReadPositionPrevious = WritePositionNew - LookAheadSamplesPrevious;
+
+                if (ReadPositionPrevious < 0)
+                {
+                    ReadPositionPrevious += DelayLength;
+                }
+
+                SampleType PreviousSample = DelayedSamples[ReadPositionPrevious];
+
+                OutputSample = PreviousSample +
+                               (OutputSample - PreviousSample) * Crossfade.getNextValue();
+            }
+
+            Samples[Sample] = OutputSample;
+
+            if (++WritePositionNew >= DelayLength)
+            {
+                WritePositionNew = 0;
+            }
+        }
+    }
+
+    WritePosition = WritePositionNew;
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getRmsWindowSize()
+/*  Get current detector RMS window size.
+
+    return value (double): returns current current detector RMS window
+    size
+*/
+{
+    return SideChainProcessor[0]->getRmsWindowSize();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setRmsWindowSize(double RmsWindowSizeMilliSecondsNew)
+/*  Set new detector RMS window size.
+
+    RmsWindowSizeMilliSecondsNew (double): new detector RMS window size
+
+    return value: none
+*/
+{
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setRmsWindowSize(RmsWindowSizeMilliSecondsNew);
+    }
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getDesign()
+/*  Get current compressor design.
+
+    return value (integer): returns the current compressor design
+ */
+{
+    return CompressorDesign;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setDesign(int CompressorDesignNew)
+/*  Set new compressor design.
+
+    CompressorDesignNew (integer): new compressor design
+
+    return value: none
+ */
+{
+    CompressorDesign = CompressorDesignNew;
+    DesignIsFeedForward = (CompressorDesign == Compressor::DesignFeedForward);
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getThreshold()
+/*  Get current threshold.
+
+    return value (double): returns the current threshold in decibels
+ */
+{
+    return SideChainProcessor[0]->getThreshold();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setThreshold(double ThresholdNew)
+/*  Set new threshold.  The threshold ramps towards the new value
+    while processing.
+
+    ThresholdNew (double): new threshold in decibels
+
+    return value: none
+ */
+{
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setThreshold(ThresholdNew);
+    }
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getRatio()
+/*  Get current compression ratio.
+
+    return value (double): returns the current compression ratio
+ */
+{
+    double RatioNew = SideChainProcessor[0]->getRatio();
+
+    if (UseUpwardExpansion.get())
+    {
+        return 1.0 / RatioNew;
+    }
+    else
+    {
+        return RatioNew;
+    }
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setRatio(double RatioNew)
+/*  Set new compression ratio.  The ratio ramps towards the new
+    value while processing.  Ratios below 1:1 select upward
+    expansion; the audio thread crossfades between compression and
+    expansion.
+
+    RatioNew (double): new compression ratio
+
+    return value: none
+ */
+{
+    if (RatioNew < 1.0)
+    {
+        UseUpwardExpansion = true;
+        RatioNew = 1.0 / RatioNew;
+    }
+    else
+    {
+        UseUpwardExpansion = false;
+    }
+
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setRatio(RatioNew);
+    }
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getKneeWidth()
+/*  Get current knee width.
+
+    return value (double): returns the current knee width in decibels
+ */
+{
+    return SideChainProcessor[0]->getKneeWidth();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setKneeWidth(double KneeWidthNew)
+/*  Set new knee width.
+
+    KneeWidthNew (double): new knee width in decibels
+
+    return value: none
+ */
+{
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setKneeWidth(KneeWidthNew);
+    }
+
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getAttackRate()
+/*  Get current attack rate.
+
+    return value (double): returns the current attack rate in
+    milliseconds
+ */
+{
+    return SideChainProcessor[0]->getAttackRate();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setAttackRate(double AttackRateNew)
+/*  Set new attack rate.
+
+    AttackRateNew (double): new attack rate in milliseconds
+
+    return value: none
+ */
+{
+    int Index = 0;
+
+    // all channels of an oversampling factor share the same attack
+    // coefficient, so calculate it only once per factor
+    for (int Factor = 1; Factor <= MaximumOversampling; Factor *= 2)
+    {
+        SampleType AttackCoefficient = SideChain<SampleType>::calculateAttackCoefficient(
+                                           AttackRateNew, SampleRate * Factor);
+
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            AllSideChains[Index]->setAttackRate(
+                AttackRateNew, AttackCoefficient);
+
+            ++Index;
+        }
+    }
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getReleaseRate()
+/*  Get current release rate.
+
+    return value (integer): returns the current release rate in
+    milliseconds
+ */
+{
+    return SideChainProcessor[0]->getReleaseRate();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setReleaseRate(int ReleaseRateNew)
+/*  Set new release rate.
+
+    ReleaseRateNew (integer): new release rate in milliseconds
+
+    return value: none
+ */
+{
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setReleaseRate(ReleaseRateNew);
+    }
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getCurve()
+/*  Get current compressor curve type.
+
+    return value (integer): returns compressor curve type
+ */
+{
+    return SideChainProcessor[0]->getCurve();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setCurve(int CurveTypeNew)
+/*  Set new compressor curve type.
+
+    CurveTypeNew (integer): new compressor curve type
+
+    return value: none
+ */
+{
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setCurve(CurveTypeNew);
+    }
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getGainStage()
+/*  Get current compressor gain stage type.
+
+    return value (integer): returns compressor gain stage type
+ */
+{
+    return SideChainProcessor[0]->getGainStage();
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setGainStage(int GainStageTypeNew)
+/*  Set new compressor gain stage type.
+
+    GainStageTypeNew (integer): new compressor gain stage type
+
+    return value: none
+ */
+{
+    // keep side chains of all oversampling factors up to date
+    for (int Index = 0; Index < AllSideChains.size(); ++Index)
+    {
+        AllSideChains[Index]->setGainStage(GainStageTypeNew);
+    }
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getStereoLink()
+/*  Get current stereo link percentage.
+
+    return value (integer): returns the current stereo link percentage
+    (0 to 100)
+ */
+{
+    return StereoLinkPercentage;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setStereoLink(int StereoLinkPercentageNew)
+/*  Set new stereo link percentage.
+
+    StereoLinkPercentageNew (integer): new stereo link percentage (0 to 100)
+
+    return value: none
+ */
+{
+    StereoLinkPercentage = StereoLinkPercentageNew;
+
+    // amplification factor for other channel ranging from 0.0 (no
+    // stereo linking) to 0.5 (full stereo linking)
+    StereoLinkWeightOther = SampleType(StereoLinkPercentage / 200.0);
+
+    // amplification factor for original channel ranging from 1.0 (no
+    // stereo linking) to 0.5 (full stereo linking)
+    StereoLinkWeight = SampleType(1.0) - StereoLinkWeightOther;
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getInputTrim()
+/*  Get current input trim gain.
+
+    return value (double): returns the current input trim gain in
+    decibels
+ */
+{
+    return InputTrim;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setInputTrim(double InputTrimNew)
+/*  Set new input trim gain.
+
+    InputTrimNew (double): new input trim gain in decibels
+
+    return value: none
+ */
+{
+    InputTrim = SampleType(InputTrimNew);
+}
+
+
+template <typename SampleType>
+bool Compressor<SampleType>::getAutoMakeupGain()
+/*  Get current auto make-up gain state.
+
+    return value (boolean): returns current auto make-up gain state
+ */
+{
+    return UseAutoMakeupGain;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setAutoMakeupGain(bool UseAutoMakeupGainNew)
+/*  Set new auto make-up gain state.
+
+    UseAutoMakeupGainNew (boolean): new auto make-up gain state
+
+    return value: none
+ */
+{
+    UseAutoMakeupGain = UseAutoMakeupGainNew;
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getMakeupGain()
+/*  Get current make-up gain.
+
+    return value (double): returns the current make-up gain in decibels
+ */
+{
+    return MakeupGainDecibel;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setMakeupGain(double MakeupGainNew)
+/*  Set new make-up gain.  The make-up gain ramps towards the new
+    value while processing.
+
+    nMakeupGainNew (double): new make-up gain in decibels
+
+    return value: none
+ */
+{
+    MakeupGainDecibel = MakeupGainNew;
+    MakeupGainTarget = SideChain<SampleType>::decibel2level(
+                           SampleType(MakeupGainDecibel));
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getWetMix()
+/*  Get current wet mix percentage.
+
+    return value (integer): returns the current wet mix percentage
+    (0 to 100)
+ */
+{
+    return WetMixPercentage;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setWetMix(int WetMixPercentageNew)
+/*  Set new wet mix percentage.  The wet mix ramps towards the new
+    value while processing.
+
+    WetMixPercentageNew (integer): new wet mix percentage (0 to 100)
+
+    return value: none
  */
 {
+    // combined bypass state is updated by the audio thread
     WetMixPercentage = WetMixPercentageNew;
+    WetMixTarget = SampleType(WetMixPercentage / 100.0);
+}
+
+
+template <typename SampleType>
+bool Compressor<SampleType>::getSidechainInput()
+/*  Get current side-chain input.
+
+    return value (boolean): returns current side-chain input (true ==
+    external input)
+ */
+{
+    return EnableExternalInput;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setSidechainInput(bool EnableExternalInputNew)
+/*  Set new side-chain input.
+
+    EnableExternalInputNew (boolean): new side-chain input (true ==
+    external input)
+
+    return value: none
+ */
+{
+    EnableExternalInput = EnableExternalInputNew;
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getSidechainHPFCutoff()
+/*  Get current side-chain high-pass filter cutoff frequency.
+
+    return value (integer): side-chain high-pass filter cutoff
+    frequency (in Hertz)
+ */
+{
+    return SidechainHPFCutoff;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setSidechainHPFCutoff(int SidechainHPFCutoffNew)
+/*  Set new side-chain high-pass filter cutoff frequency.
+
+    SidechainHPFCutoff (integer): new side-chain high-pass filter
+    cutoff frequency (in Hertz)
+
+    return value: none
+ */
+{
+    SidechainHPFCutoff = SidechainHPFCutoffNew;
+
+    bool IsHPFEnabledOld = IsHPFEnabled;
+    IsHPFEnabled = (SidechainHPFCutoff > 20);
+
+    // keep filters of all oversampling factors up to date
+    for (int Index = 0; Index < AllSidechainFilters_HPF.size(); ++Index)
+    {
+        if (IsHPFEnabled != IsHPFEnabledOld)
+        {
+            AllSidechainFilters_HPF[Index]->resetDelays();
+        }
+
+        AllSidechainFilters_HPF[Index]->passFilterSecondOrder(
+            SidechainHPFCutoff, 0.707, false);
+    }
+}
+
+
+template <typename SampleType>
+int Compressor<SampleType>::getSidechainLPFCutoff()
+/*  Get current side-chain low-pass filter cutoff frequency.
+
+    return value (integer): side-chain low-pass filter cutoff
+    frequency (in Hertz)
+ */
+{
+    return SidechainLPFCutoff;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setSidechainLPFCutoff(int SidechainLPFCutoffNew)
+/*  Set new side-chain low-pass filter cutoff frequency.
+
+    SidechainLPFCutoff (integer): new side-chain low-pass filter
+    cutoff frequency (in Hertz)
+
+    return value: none
+ */
+{
+    SidechainLPFCutoff = SidechainLPFCutoffNew;
+
+    bool IsLPFEnabledOld = IsLPFEnabled;
+    IsLPFEnabled = (SidechainLPFCutoff < 15000);
+
+    // keep filters of all oversampling factors up to date
+    for (int Index = 0; Index < AllSidechainFilters_LPF.size(); ++Index)
+    {
+        if (IsLPFEnabled != IsLPFEnabledOld)
+        {
+            AllSidechainFilters_LPF[Index]->resetDelays();
+        }
+
+        AllSidechainFilters_LPF[Index]->passFilterSecondOrder(
+            SidechainLPFCutoff, 0.707, true);
+    }
+}
+
+
+template <typename SampleType>
+bool Compressor<SampleType>::getSidechainListen()
+/*  Get current side-chain listen state.
+
+    return value (boolean): returns current side-chain listen state
+ */
+{
+    return ListenToSidechain;
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setSidechainListen(bool ListenToSidechainNew)
+/*  Set new side-chain listen state.  With look-ahead, the side chain
+    is delayed like the main path (unless it is fed from the output
+    of a feed-back design, which is delayed already).
+
+    ListenToSidechainNew (boolean): new side-chain listen state
+
+    return value: none
+ */
+{
+    ListenToSidechain = ListenToSidechainNew;
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getGainReduction(int CurrentChannel)
+/*  Get current gain reduction.
+
+    CurrentChannel (integer): queried audio channel
+
+    return value (double): returns the current gain reduction in
+    decibel
+ */
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    if (CompressorIsBypassedCombined)
+    {
+        return 0.0;
+    }
+    else
+    {
+        return GainReduction[CurrentChannel];
+    }
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getPeakMeterInputLevel(int CurrentChannel)
+/*  Get current input peak level.
+
+    CurrentChannel (integer): selected audio channel
+
+    return value (double): returns current input peak level in decibel
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return PeakMeterInputLevels[CurrentChannel] + getMeterCrestFactor();
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getPeakMeterOutputLevel(int CurrentChannel)
+/*  Get current output peak level.
+
+    CurrentChannel (integer): selected audio channel
+
+    return value (double): returns current output peak level in decibel
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return PeakMeterOutputLevels[CurrentChannel] + getMeterCrestFactor();
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getAverageMeterInputLevel(int CurrentChannel)
+/*  Get current input average level.
+
+    CurrentChannel (integer): selected audio channel
+
+    return value (double): returns current input average level in
+    decibel
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return AverageMeterInputLevels[CurrentChannel] + getMeterCrestFactor();
+}
+
+
+template <typename SampleType>
+double Compressor<SampleType>::getAverageMeterOutputLevel(int CurrentChannel)
+/*  Get current output average level.
 
-    WetMix = WetMixPercentage / 100.0;
-    DryMix = 1.0 - WetMix;
+    CurrentChannel (integer): selected audio channel
+
+    return value (double): returns current output average level in
+    decibel
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
 
-    CompressorIsBypassedCombined = (CompressorIsBypassed || (WetMixPercentage == 0));
+    return AverageMeterOutputLevels[CurrentChannel] + getMeterCrestFactor();
 }
 
 
-bool Compressor::getSidechainInput()
-/*  Get current side-chain input.
+template <typename SampleType>
+bool Compressor<SampleType>::getMetering()
+/*  Get current state of meters.
 
-    return value (boolean): returns current side-chain input (true ==
-    external input)
+    return value (boolean): returns true if meters are enabled
  */
 {
-    return EnableExternalInput;
+    return UseMeters;
 }
 
 
-void Compressor::setSidechainInput(bool EnableExternalInputNew)
-/*  Set new side-chain input.
+template <typename SampleType>
+void Compressor<SampleType>::setMetering(bool UseMetersNew)
+/*  Enable or disable meters.  Disabled meters skip all metering work
+    (levels, ballistics, true-peak measurement and snapshots), so
+    disable them when nobody reads the meters.  Does not allocate
+    memory.
 
-    EnableExternalInputNew (boolean): new side-chain input (true ==
-    external input)
+    UseMetersNew (boolean): new state of meters
 
     return value: none
  */
 {
-    EnableExternalInput = EnableExternalInputNew;
+    if (UseMetersNew == UseMeters)
+    {
+        return;
+    }
+
+    UseMeters = UseMetersNew;
+
+    // enabled meters must not show stale readings
+    if (UseMeters)
+    {
+        restartMeters();
+    }
 }
 
 
-int Compressor::getSidechainHPFCutoff()
-/*  Get current side-chain high-pass filter cutoff frequency.
+template <typename SampleType>
+int Compressor<SampleType>::getMeterBallistics()
+/*  Get current metering standard.
 
-    return value (integer): side-chain high-pass filter cutoff
-    frequency (in Hertz)
+    return value (integer): returns current metering standard
+    (frut::dsp::MeterBallistics::Standard)
  */
 {
-    return SidechainHPFCutoff;
+    return MeterStandardRequested.get();
 }
 
 
-void Compressor::setSidechainHPFCutoff(int SidechainHPFCutoffNew)
-/*  Set new side-chain high-pass filter cutoff frequency.
+template <typename SampleType>
+void Compressor<SampleType>::setMeterBallistics(int MeterStandardNew)
+/*  Set metering standard (ballistics and crest factor of meters).
+    The audio thread switches to the new standard when it starts the
+    next block, so this function never allocates memory and may be
+    called from any thread.
 
-    SidechainHPFCutoff (integer): new side-chain high-pass filter
-    cutoff frequency (in Hertz)
+    MeterStandardNew (integer): new metering standard
+    (frut::dsp::MeterBallistics::Standard)
 
     return value: none
  */
 {
-    SidechainHPFCutoff = SidechainHPFCutoffNew;
-
-    bool IsHPFEnabledOld = IsHPFEnabled;
-    IsHPFEnabled = (SidechainHPFCutoff > 20);
-
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
-    {
-        if (IsHPFEnabled != IsHPFEnabledOld)
-        {
-            SidechainFilter_HPF[CurrentChannel]->resetDelays();
-        }
+    jassert(isPositiveAndBelow(MeterStandardNew,
+                               (int) frut::dsp::MeterBallistics::numberOfStandards));
 
-        SidechainFilter_HPF[CurrentChannel]->passFilterSecondOrder(
-            SidechainHPFCutoff, 0.707, false);
-    }
+    MeterStandardRequested = MeterStandardNew;
 }
 
 
-int Compressor::getSidechainLPFCutoff()
-/*  Get current side-chain low-pass filter cutoff frequency.
+template <typename SampleType>
+bool Compressor<SampleType>::getTruePeakMetering()
+/*  Get current state of true-peak meters.
 
-    return value (integer): side-chain low-pass filter cutoff
-    frequency (in Hertz)
+    return value (boolean): returns true if true-peak meters are
+    enabled
  */
 {
-    return SidechainLPFCutoff;
+    return UseTruePeakMeters.get();
 }
 
 
-void Compressor::setSidechainLPFCutoff(int SidechainLPFCutoffNew)
-/*  Set new side-chain low-pass filter cutoff frequency.
+template <typename SampleType>
+void Compressor<SampleType>::setTruePeakMetering(bool UseTruePeakMetersNew)
+/*  Enable or disable true-peak meters (ITU-R BS.1770).  Meter buffers
+    are measured on a background thread that only runs while the
+    meters are enabled.  Starting and stopping this thread blocks (and
+    the analyser is created when the meters are first enabled), so
+    only call this function from the message thread or while the
+    compressor is not processing!
 
-    SidechainLPFCutoff (integer): new side-chain low-pass filter
-    cutoff frequency (in Hertz)
+    UseTruePeakMetersNew (boolean): new state of true-peak meters
 
     return value: none
  */
 {
-    SidechainLPFCutoff = SidechainLPFCutoffNew;
-
-    bool IsLPFEnabledOld = IsLPFEnabled;
-    IsLPFEnabled = (SidechainLPFCutoff < 15000);
+    if (UseTruePeakMetersNew == UseTruePeakMeters.get())
+    {
+        return;
+    }
 
-    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    // meter levels are reset by the audio thread once it notices the
+    // change
+    if (UseTruePeakMetersNew)
     {
-        if (IsLPFEnabled != IsLPFEnabledOld)
+        if (!TruePeakMeters)
         {
-            SidechainFilter_LPF[CurrentChannel]->resetDelays();
+            TruePeakMeters.reset(
+                new TruePeakAnalyser<SampleType>(NumberOfChannels, MeterBufferSize));
         }
 
-        SidechainFilter_LPF[CurrentChannel]->passFilterSecondOrder(
-            SidechainLPFCutoff, 0.707, true);
+        // the audio thread only pushes samples once the analyser
+        // runs
+        TruePeakMeters->start();
+        UseTruePeakMeters = true;
+    }
+    else
+    {
+        // the analyser is kept, as the audio thread may still be
+        // pushing samples
+        UseTruePeakMeters = false;
+        TruePeakMeters->stop();
     }
 }
 
 
-bool Compressor::getSidechainListen()
-/*  Get current side-chain listen state.
+template <typename SampleType>
+double Compressor<SampleType>::getTruePeakMeterInputLevel(int CurrentChannel)
+/*  Get current input true-peak level.
 
-    return value (boolean): returns current side-chain listen state
- */
+    CurrentChannel (integer): selected audio channel
+
+    return value (double): returns current input true-peak level in
+    decibel (meter minimum when true-peak meters are disabled)
+*/
 {
-    return ListenToSidechain;
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return TruePeakMeterInputLevels[CurrentChannel] + getMeterCrestFactor();
 }
 
 
-void Compressor::setSidechainListen(bool ListenToSidechainNew)
-/*  Set new side-chain listen state.
+template <typename SampleType>
+double Compressor<SampleType>::getTruePeakMeterOutputLevel(int CurrentChannel)
+/*  Get current output true-peak level.
 
-    ListenToSidechainNew (boolean): new side-chain listen state
+    CurrentChannel (integer): selected audio channel
 
-    return value: none
+    return value (double): returns current output true-peak level in
+    decibel (meter minimum when true-peak meters are disabled)
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return TruePeakMeterOutputLevels[CurrentChannel] + getMeterCrestFactor();
+}
+
+
+template <typename SampleType>
+bool Compressor<SampleType>::getLoudnessMetering()
+/*  Get current state of loudness meters.
+
+    return value (boolean): returns true if loudness meters are
+    enabled
  */
 {
-    ListenToSidechain = ListenToSidechainNew;
+    return UseLoudnessMeters.get();
 }
 
 
-double Compressor::getGainReduction(int CurrentChannel)
-/*  Get current gain reduction.
+template <typename SampleType>
+void Compressor<SampleType>::setLoudnessMetering(bool UseLoudnessMetersNew)
+/*  Enable or disable loudness meters (ITU-R BS.1770, EBU R 128).
+    Blocks are measured on a background thread that only runs while
+    the meters are enabled.  Starting and stopping this thread blocks
+    (and the analyser is created when the meters are first enabled),
+    so only call this function from the message thread or while the
+    compressor is not processing!
 
-    CurrentChannel (integer): queried audio channel
+    UseLoudnessMetersNew (boolean): new state of loudness meters
 
-    return value (double): returns the current gain reduction in
-    decibel
+    return value: none
  */
 {
-    jassert(CurrentChannel >= 0);
-    jassert(CurrentChannel < NumberOfChannels);
+    if (UseLoudnessMetersNew == UseLoudnessMeters.get())
+    {
+        return;
+    }
 
-    if (CompressorIsBypassedCombined)
+    if (UseLoudnessMetersNew)
     {
-        return 0.0;
+        if (!LoudnessMeters)
+        {
+            LoudnessMeters.reset(
+                new LoudnessAnalyser<SampleType>(NumberOfChannels, SampleRate));
+        }
+
+        // integration starts over whenever loudness meters are
+        // enabled; the audio thread only pushes samples once the
+        // analyser runs
+        LoudnessMeters->start();
+        UseLoudnessMeters = true;
     }
     else
     {
-        return GainReduction[CurrentChannel];
+        // the analyser is kept, as the audio thread may still be
+        // pushing samples
+        UseLoudnessMeters = false;
+        LoudnessMeters->stop();
     }
 }
 
 
-double Compressor::getPeakMeterInputLevel(int CurrentChannel)
-/*  Get current input peak level.
+template <typename SampleType>
+void Compressor<SampleType>::resetLoudnessMeters()
+/*  Clear loudness measurements (including integrated loudness and
+    loudness range).  Lock-free.
 
-    CurrentChannel (integer): selected audio channel
+    return value: none
+ */
+{
+    if (LoudnessMeters)
+    {
+        LoudnessMeters->reset();
+    }
+}
 
-    return value (double): returns current input peak level in decibel
+
+template <typename SampleType>
+float Compressor<SampleType>::getInputLoudness(int Measurement)
+/*  Get current input loudness.  Lock-free.
+
+    Measurement (integer): selected measurement
+    (LoudnessAnalyser::Measurements)
+
+    return value (float): returns input loudness in LUFS or loudness
+    range in LU (absolute gate of -70 LUFS when nothing has been
+    measured)
 */
 {
-    jassert(CurrentChannel >= 0);
-    jassert(CurrentChannel < NumberOfChannels);
+    if (!LoudnessMeters)
+    {
+        return (Measurement == LoudnessAnalyser<SampleType>::LoudnessRange) ?
+               0.0f : float(LoudnessAnalyser<SampleType>::MinimumLoudness);
+    }
 
-    return PeakMeterInputLevels[CurrentChannel] + CrestFactor;
+    return LoudnessMeters->getInputLoudness(Measurement);
 }
 
 
-double Compressor::getPeakMeterOutputLevel(int CurrentChannel)
-/*  Get current output peak level.
+template <typename SampleType>
+float Compressor<SampleType>::getOutputLoudness(int Measurement)
+/*  Get current output loudness.  Lock-free.
 
-    CurrentChannel (integer): selected audio channel
+    Measurement (integer): selected measurement
+    (LoudnessAnalyser::Measurements)
 
-    return value (double): returns current output peak level in decibel
+    return value (float): returns output loudness in LUFS or loudness
+    range in LU (absolute gate of -70 LUFS when nothing has been
+    measured)
 */
 {
-    jassert(CurrentChannel >= 0);
-    jassert(CurrentChannel < NumberOfChannels);
+    if (!LoudnessMeters)
+    {
+        return (Measurement == LoudnessAnalyser<SampleType>::LoudnessRange) ?
+               0.0f : float(LoudnessAnalyser<SampleType>::MinimumLoudness);
+    }
 
-    return PeakMeterOutputLevels[CurrentChannel] + CrestFactor;
+    return LoudnessMeters->getOutputLoudness(Measurement);
 }
 
 
-double Compressor::getAverageMeterInputLevel(int CurrentChannel)
-/*  Get current input average level.
+template <typename SampleType>
+bool Compressor<SampleType>::getMeterSnapshot(MeterSnapshot &Snapshot)
+/*  Get latest meter readings.  Meter readings are published by the
+    audio thread after each processed block and must only be read by
+    a single thread (usually the editor).
 
-    CurrentChannel (integer): selected audio channel
+    Snapshot (MeterSnapshot): receives latest meter readings (only
+    changed when new readings have been published)
 
-    return value (double): returns current input average level in
-    decibel
+    return value (boolean): returns true if new meter readings have
+    been published since the last call
 */
 {
-    jassert(CurrentChannel >= 0);
-    jassert(CurrentChannel < NumberOfChannels);
+    return MeterSnapshots.read(Snapshot);
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::setGainReductionHistory(GainReductionHistory *HistoryNew)
+/*  Set gain reduction history.  The history must outlive the
+    compressor and is fed whether or not meters are enabled.
+
+    HistoryNew (GainReductionHistory pointer): new gain reduction
+    history (nullptr disables history)
 
-    return AverageMeterInputLevels[CurrentChannel] + CrestFactor;
+    return value: none
+ */
+{
+    History = HistoryNew;
 }
 
 
-double Compressor::getAverageMeterOutputLevel(int CurrentChannel)
-/*  Get current output average level.
+template <typename SampleType>
+void Compressor<SampleType>::process(
+    AudioBuffer<SampleType> &MainBuffer,
+    AudioBuffer<SampleType> &SideChainBuffer)
+/*  Process main buffer in place.  The side chain buffer may refer to
+    the main buffer's channels, as all side chain samples are read
+    before the corresponding output samples are written.
 
-    CurrentChannel (integer): selected audio channel
+    MainBuffer (AudioBuffer): main input and output samples
 
-    return value (double): returns current output average level in
-    decibel
+    SideChainBuffer (AudioBuffer): external side chain samples
+
+    return value: none
 */
 {
-    jassert(CurrentChannel >= 0);
-    jassert(CurrentChannel < NumberOfChannels);
+    int nNumSamples = MainBuffer.getNumSamples();
+    jassert(SideChainBuffer.getNumSamples() == nNumSamples);
+
+    // nothing to do (the engines expect at least one sample)
+    if (nNumSamples == 0)
+    {
+        return;
+    }
+
+    // block is larger than the work buffers, so process it in chunks
+    // (creating buffers that refer to existing data does not
+    // allocate memory)
+    if (nNumSamples > MaximumBlockSize)
+    {
+        for (int nStartSample = 0; nStartSample < nNumSamples; nStartSample += MaximumBlockSize)
+        {
+            int nChunkSize = jmin(MaximumBlockSize, nNumSamples - nStartSample);
+
+            AudioBuffer<SampleType> MainChunk(
+                MainBuffer.getArrayOfWritePointers(),
+                MainBuffer.getNumChannels(),
+                nStartSample, nChunkSize);
+
+            AudioBuffer<SampleType> SideChainChunk(
+                SideChainBuffer.getArrayOfWritePointers(),
+                SideChainBuffer.getNumChannels(),
+                nStartSample, nChunkSize);
+
+            process(MainChunk, SideChainChunk);
+        }
+
+        return;
+    }
+
+    // pick up parameter changes from other threads
+    updateSmoothingTargets();
+
+    // bypass compressor once wet mix has ramped down to 0 percent
+    updateCombinedBypass();
+
+    // switch to changed look-ahead
+    applyLatencyChanges();
+
+    // read state of true-peak meters once, so that the whole block
+    // is metered consistently; disabled meters fall to the meter
+    // minimum immediately, and enabled meters must not show stale
+    // readings
+    if (UseTruePeakMeters.get() != TruePeakMetersEnabled)
+    {
+        TruePeakMetersEnabled = !TruePeakMetersEnabled;
+        resetTruePeakMeters();
+    }
+
+    // switch to requested metering standard (coefficients of all
+    // standards have already been calculated)
+    int MeterStandardNew = MeterStandardRequested.get();
+
+    if (MeterStandardNew != Ballistics.getStandard())
+    {
+        Ballistics.setStandard(MeterStandardNew);
+    }
+
+    // read state of loudness meters once, so that input samples are
+    // stored whenever they are pushed to the analyser
+    bool LoudnessMetersEnabled = UseLoudnessMeters.get();
+
+    // read state of side-chain listen once, so that the engines and
+    // the listen delay agree for the whole block; the listen delay
+    // only holds stale side-chain samples, so restart it with
+    // silence
+    if (ListenToSidechain != SidechainListenEnabled)
+    {
+        SidechainListenEnabled = ListenToSidechain;
+
+        SidechainListenDelay.clear();
+        SidechainListenWritePosition = 0;
+    }
+
+    // unless the side chain is fed from the (delayed) output, it runs
+    // ahead of the main path by the look-ahead
+    bool DelaysSidechainListen = SidechainListenEnabled &&
+                                 (DesignIsFeedForward || EnableExternalInput);
+
+    // look-ahead: delay main path, but feed the side chain with
+    // undelayed samples
+    LookAheadIsActive = (LookAheadSamples > 0) || LookAheadCrossfade.isSmoothing();
+
+    if (LookAheadIsActive)
+    {
+        // never allocates memory, as blocks do not exceed the maximum
+        // block size
+        LookAheadSidechainSamples.setSize(NumberOfChannels, nNumSamples,
+                                          false, false, true);
+
+        // the side chain buffer may refer to the main buffer's
+        // channels, so copy side chain before delaying main path
+        const AudioBuffer<SampleType> &SideChainSource =
+            EnableExternalInput ? SideChainBuffer : MainBuffer;
+
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            LookAheadSidechainSamples.copyFrom(CurrentChannel, 0, SideChainSource,
+                                               CurrentChannel, 0, nNumSamples);
+        }
+    }
+
+    // without look-ahead, this passes the main path through and only
+    // keeps the delay line filled, so that switching look-ahead on
+    // does not play back stale samples
+    delaySamples(MainBuffer, LookAheadDelay, LookAheadWritePosition,
+                 nNumSamples);
+
+    // samples the side chain is fed from
+    AudioBuffer<SampleType> &SideChainInput =
+        LookAheadIsActive ? LookAheadSidechainSamples :
+        (EnableExternalInput ? SideChainBuffer : MainBuffer);
+
+    // at the original sample rate, the engines add input and output
+    // samples to the meters while processing; a delayed side-chain
+    // listen signal is only complete after processing
+    EngineUpdatesMeters = UseMeters && (MainOversampler == nullptr) &&
+                          !DelaysSidechainListen;
+
+    // store input samples for metering (the main buffer is
+    // overwritten with the output samples); only needed by loudness
+    // and true-peak meters and for oversampled blocks
+    if (LoudnessMetersEnabled ||
+            (UseMeters && (TruePeakMetersEnabled || !EngineUpdatesMeters)))
+    {
+        MeterInputSamples.setSize(NumberOfChannels, nNumSamples,
+                                  false, false, true);
+
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            MeterInputSamples.copyFrom(CurrentChannel, 0, MainBuffer,
+                                       CurrentChannel, 0, nNumSamples);
+        }
+    }
+
+    // both engines widen this range
+    GainReductionMinimum = std::numeric_limits<SampleType>::max();
+    GainReductionMaximum = std::numeric_limits<SampleType>::lowest();
+
+    AudioBuffer<SampleType> *ProcessingMainBuffer = &MainBuffer;
+    AudioBuffer<SampleType> *ProcessingSideChainBuffer = &SideChainInput;
+
+    // oversampling: process up-sampled copies of main and side chain
+    if (MainOversampler)
+    {
+        int nNumSamplesOversampled = nNumSamples * OversamplingFactor;
+
+        // never allocates memory, as blocks do not exceed the maximum
+        // block size
+        OversampledMainSamples.setSize(NumberOfChannels, nNumSamplesOversampled,
+                                       false, false, true);
+        OversampledSidechainSamples.setSize(NumberOfChannels, nNumSamplesOversampled,
+                                            false, false, true);
+
+        // the side chain is up-sampled even while the engines read
+        // the main buffer, so that switching look-ahead or external
+        // input on does not play back stale filter states
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            MainOversampler->upsample(
+                CurrentChannel,
+                MainBuffer.getReadPointer(CurrentChannel),
+                OversampledMainSamples.getWritePointer(CurrentChannel),
+                nNumSamples);
+
+            SidechainOversampler->upsample(
+                CurrentChannel,
+                SideChainInput.getReadPointer(CurrentChannel),
+                OversampledSidechainSamples.getWritePointer(CurrentChannel),
+                nNumSamples);
+        }
+
+        ProcessingMainBuffer = &OversampledMainSamples;
+        ProcessingSideChainBuffer = &OversampledSidechainSamples;
+    }
+
+    if (EngineUpdatesMeters)
+    {
+        // split block at the end of each meter buffer, so the engines
+        // can add samples to the current meter buffer (creating
+        // buffers that refer to existing data does not allocate
+        // memory)
+        int nStartSample = 0;
+
+        while (nStartSample < nNumSamples)
+        {
+            int nSegmentSize = jmin(nNumSamples - nStartSample,
+                                    MeterBufferSize - MeterBufferPosition);
+
+            AudioBuffer<SampleType> MainSegment(
+                MainBuffer.getArrayOfWritePointers(),
+                MainBuffer.getNumChannels(),
+                nStartSample, nSegmentSize);
+
+            AudioBuffer<SampleType> SideChainSegment(
+                SideChainInput.getArrayOfWritePointers(),
+                SideChainInput.getNumChannels(),
+                nStartSample, nSegmentSize);
+
+            processWithEngine(MainSegment, SideChainSegment);
+
+            // update meter ballistics and increment buffer location
+            updateMeterBallistics(nSegmentSize);
+            nStartSample += nSegmentSize;
+        }
+    }
+    else
+    {
+        processWithEngine(*ProcessingMainBuffer, *ProcessingSideChainBuffer);
+    }
+
+    if (MainOversampler)
+    {
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            MainOversampler->downsample(
+                CurrentChannel,
+                OversampledMainSamples.getReadPointer(CurrentChannel),
+                MainBuffer.getWritePointer(CurrentChannel),
+                nNumSamples);
+        }
+    }
+
+    // the engines output the undelayed side chain, so line it up
+    // with the main path
+    if (DelaysSidechainListen)
+    {
+        delaySamples(MainBuffer, SidechainListenDelay,
+                     SidechainListenWritePosition, nNumSamples);
+    }
+
+    // both delays have used the crossfade of this block
+    LookAheadCrossfade.skip(nNumSamples);
+
+    // loudness is integrated over time, so keep measuring while
+    // nobody reads the meters
+    if (LoudnessMetersEnabled)
+    {
+        LoudnessMeters->push(MeterInputSamples, MainBuffer, nNumSamples);
+    }
+
+    // the history is recorded while nobody reads the meters, so it
+    // has no gaps once the editor is opened
+    if (History != nullptr)
+    {
+        // there is no gain reduction while the compressor is bypassed
+        if (CompressorIsBypassedCombined)
+        {
+            GainReductionMinimum = SampleType(0.0);
+            GainReductionMaximum = SampleType(0.0);
+        }
+
+        SampleType PeakLevel = SampleType(0.0);
+
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            PeakLevel = jmax(PeakLevel,
+                             MainBuffer.getMagnitude(CurrentChannel, 0, nNumSamples));
+        }
+
+        History->push((float) GainReductionMinimum,
+                      (float) GainReductionMaximum,
+                      (float) SideChain<SampleType>::level2decibel(PeakLevel),
+                      nNumSamples);
+    }
+
+    // nobody reads the meters
+    if (!UseMeters)
+    {
+        return;
+    }
+
+    // true-peak meters collect their own meter buffers
+    if (TruePeakMetersEnabled)
+    {
+        TruePeakMeters->push(MeterInputSamples, MainBuffer, nNumSamples);
+    }
+
+    // meters run at the original sample rate; they reflect the real
+    // output, so when the user listens to the side-chain, the output
+    // meter will also display the side-chain's level!
+    if (!EngineUpdatesMeters)
+    {
+        updateMeterLevels(MeterInputSamples, MainBuffer, nNumSamples);
+    }
 
-    return AverageMeterOutputLevels[CurrentChannel] + CrestFactor;
+    // hand meter readings to editor
+    publishMeterSnapshot();
 }
 
 
-void Compressor::process(
-    AudioBuffer<double> &MainBuffer,
-    AudioBuffer<double> &SideChainBuffer)
+template <typename SampleType>
+void Compressor<SampleType>::processWithEngine(
+    AudioBuffer<SampleType> &MainBuffer,
+    AudioBuffer<SampleType> &SideChainBuffer)
 {
-    jassert(MainBuffer.getNumSamples() == SideChainBuffer.getNumSamples());
+    // in feed-back designs, the side chain of each sample depends on
+    // the output of the previous sample, so these designs have to be
+    // processed sample by sample
+    if ((ProcessingMode == Compressor::ProcessPerSample) ||
+            (!DesignIsFeedForward))
+    {
+        processPerSample(MainBuffer, SideChainBuffer);
+    }
+    else
+    {
+        processBlockwise(MainBuffer, SideChainBuffer);
+    }
+}
 
+
+template <typename SampleType>
+void Compressor<SampleType>::processPerSample(
+    AudioBuffer<SampleType> &MainBuffer,
+    AudioBuffer<SampleType> &SideChainBuffer)
+{
     int nNumSamples = MainBuffer.getNumSamples();
 
     for (int nSample = 0; nSample < nNumSamples; ++nSample)
@@ -728,14 +2012,10 @@ void Compressor::process(
         for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
         {
             // get current input sample
-            double InputSample = MainBuffer.getSample(CurrentChannel, nSample);
+            SampleType InputSample = MainBuffer.getSample(CurrentChannel, nSample);
 
             // store de-normalised input sample
             InputSamples.set(CurrentChannel, InputSample);
-
-            // store input sample in buffer for input meter
-            MeterInputBuffer.setSample(
-                CurrentChannel, MeterBufferPosition, InputSample);
         }
 
         // compressor is bypassed (or mix is set to 0 percent)
@@ -743,44 +2023,66 @@ void Compressor::process(
         {
             for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
             {
-                // store de-normalised (!) input sample in buffer for
-                // output meter
-                MeterOutputBuffer.copyFrom(
-                    CurrentChannel, MeterBufferPosition, MeterInputBuffer,
-                    CurrentChannel, nSample, 1);
+                // store gain reduction now
+                GainReduction.set(CurrentChannel, SampleType(0.0));
+                GainReductionWithMakeup.set(CurrentChannel, SampleType(0.0));
+
+                // output equals input
+                if (EngineUpdatesMeters)
+                {
+                    SampleType InputSample = InputSamples[CurrentChannel];
 
-                // store gain reduction now
-                GainReduction.set(CurrentChannel, 0.0);
-                GainReductionWithMakeup.set(CurrentChannel, 0.0);
-            }
+                    accumulateMeterLevel(InputSample,
+                                         MeterInputPeaks.getReference(CurrentChannel),
+                                         MeterInputSumsOfSquares.getReference(CurrentChannel));
 
-            // update meter ballistics and increment buffer location
-            updateMeterBallistics();
+                    accumulateMeterLevel(InputSample,
+                                         MeterOutputPeaks.getReference(CurrentChannel),
+                                         MeterOutputSumsOfSquares.getReference(CurrentChannel));
+                }
+            }
 
             // get next sample and thus skip compression
             continue;
         }
 
+        // advance parameter ramps
+        if (SmoothedMakeupGain.isSmoothing())
+        {
+            MakeupGain = SmoothedMakeupGain.getNextValue();
+        }
+
+        if (SmoothedWetMix.isSmoothing())
+        {
+            WetMix = SmoothedWetMix.getNextValue();
+            DryMix = SampleType(1.0) - WetMix;
+        }
+
+        if (SmoothedGainReductionSign.isSmoothing())
+        {
+            GainReductionSign = SmoothedGainReductionSign.getNextValue();
+        }
+
         // process side chain
         for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
         {
-            double SideChainSample;
+            SampleType SideChainSample;
 
             // compress channels (feed-forward design)
             if (DesignIsFeedForward)
             {
-                // side chain is fed from *input* channel
-                if (EnableExternalInput)
+                // side chain is fed from *input* channel; with
+                // look-ahead, the side-chain buffer also holds the
+                // undelayed main input
+                if (EnableExternalInput || LookAheadIsActive)
                 {
                     // feed side chain from external input
-                    SideChainSample = (double) SideChainBuffer.getSample(
-                                          CurrentChannel, nSample);
+                    SideChainSample = SideChainBuffer.getSample(CurrentChannel, nSample);
                 }
                 else
                 {
                     // feed side chain from main input
-                    SideChainSample = (double) MainBuffer.getSample(
-                                          CurrentChannel, nSample);
+                    SideChainSample = MainBuffer.getSample(CurrentChannel, nSample);
                 }
             }
             // compress channels (feed-back design)
@@ -794,14 +2096,13 @@ void Compressor::process(
                 if (UseAlternativeFeedbackMode)
                 {
                     // feed side chain from external input
-                    SideChainSample = (double) SideChainBuffer.getSample(
-                                          CurrentChannel, nSample);
+                    SideChainSample = SideChainBuffer.getSample(CurrentChannel, nSample);
 
                     // retrieve last gain reduction
-                    double LastGainReduction = -GainReductionWithMakeup[CurrentChannel];
+                    SampleType LastGainReduction = -GainReductionWithMakeup[CurrentChannel];
 
                     // apply feedback-loop
-                    SideChainSample *= SideChain::decibel2level(LastGainReduction);
+                    SideChainSample *= SideChain<SampleType>::decibel2level(LastGainReduction);
                 }
                 // "normal" feed-back mode (external side
                 // chain not supported)
@@ -833,12 +2134,12 @@ void Compressor::process(
         // calculate the side chain level
         for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
         {
-            double SideChainLevel;
+            SampleType SideChainLevel;
 
             // stereo linking is off (save some processing time)
             if (StereoLinkPercentage == 0)
             {
-                SideChainLevel = fabs(SidechainSamples[CurrentChannel]);
+                SideChainLevel = std::abs(SidechainSamples[CurrentChannel]);
             }
             // stereo linking is on
             else
@@ -850,11 +2151,11 @@ void Compressor::process(
                 // getting the absolute value of each channel
                 // *separately* allows for a certain kind of M/S
                 // compression
-                SideChainLevel = fabs(SidechainSamples[CurrentChannel] * StereoLinkWeight) + fabs(SidechainSamples[OtherChannel] * StereoLinkWeightOther);
+                SideChainLevel = std::abs(SidechainSamples[CurrentChannel] * StereoLinkWeight) + std::abs(SidechainSamples[OtherChannel] * StereoLinkWeightOther);
             }
 
             // convert side chain level to decibels
-            SideChainLevel = SideChain::level2decibel(SideChainLevel);
+            SideChainLevel = SideChain<SampleType>::level2decibel(SideChainLevel);
 
             // apply crest factor
             SideChainLevel += CrestFactor;
@@ -871,33 +2172,38 @@ void Compressor::process(
             GainReduction.set(CurrentChannel, SideChainProcessor[CurrentChannel]->getGainReduction(false));
             GainReductionWithMakeup.set(CurrentChannel, SideChainProcessor[CurrentChannel]->getGainReduction(true));
 
+            // range of gain reduction (read by history)
+            if (History != nullptr)
+            {
+                GainReductionMinimum = jmin(GainReductionMinimum, GainReduction[CurrentChannel]);
+                GainReductionMaximum = jmax(GainReductionMaximum, GainReduction[CurrentChannel]);
+            }
+
             // apply gain reduction to current input sample
             //
             //  feed-forward design:  current gain reduction
             //  feed-back design:     "old" gain reduction
-            double CurrentGainReduction;
+            SampleType CurrentGainReduction;
 
             if (UseAutoMakeupGain)
             {
-                CurrentGainReduction = -GainReductionWithMakeup[CurrentChannel];
+                CurrentGainReduction = GainReductionWithMakeup[CurrentChannel];
             }
             else
             {
-                CurrentGainReduction = -GainReduction[CurrentChannel];
+                CurrentGainReduction = GainReduction[CurrentChannel];
             }
 
-            // invert gain reduction for upward expansion
-            if (UseUpwardExpansion)
-            {
-                CurrentGainReduction = -CurrentGainReduction;
-            }
+            // invert gain reduction for compression, but not for
+            // upward expansion
+            CurrentGainReduction *= GainReductionSign;
 
             // retrieve input sample
-            double InputSample = InputSamples[CurrentChannel];
-            double OutputSample = InputSample;
+            SampleType InputSample = InputSamples[CurrentChannel];
+            SampleType OutputSample = InputSample;
 
             // apply gain reduction
-            OutputSample *= SideChain::decibel2level(CurrentGainReduction);
+            OutputSample *= SideChain<SampleType>::decibel2level(CurrentGainReduction);
 
             // apply make-up gain
             OutputSample *= MakeupGain;
@@ -907,7 +2213,7 @@ void Compressor::process(
             OutputSamples.set(CurrentChannel, OutputSample);
 
             // listen to side-chain (already de-normalised)
-            if (ListenToSidechain)
+            if (SidechainListenEnabled)
             {
                 OutputSample = SidechainSamples[CurrentChannel];
             }
@@ -916,7 +2222,7 @@ void Compressor::process(
             {
                 // dry shall be mixed in (test to save some processing
                 // time)
-                if (WetMixPercentage < 100)
+                if (WetMix < SampleType(1.0))
                 {
                     OutputSample = OutputSample * WetMix +
                                    InputSample * DryMix;
@@ -926,150 +2232,617 @@ void Compressor::process(
             // write output sample to main buffer
             MainBuffer.setSample(CurrentChannel, nSample, OutputSample);
 
-            // store output sample for metering (reflects real output,
-            // so when the user listens to the side-chain, the output
-            // meter will also display the side-chain's level!)
-            MeterOutputBuffer.copyFrom(CurrentChannel, MeterBufferPosition, MainBuffer, CurrentChannel, nSample, 1);
-        }
+            if (EngineUpdatesMeters)
+            {
+                accumulateMeterLevel(InputSample,
+                                     MeterInputPeaks.getReference(CurrentChannel),
+                                     MeterInputSumsOfSquares.getReference(CurrentChannel));
 
-        // update meter ballistics and increment buffer location
-        updateMeterBallistics();
+                accumulateMeterLevel(OutputSample,
+                                     MeterOutputPeaks.getReference(CurrentChannel),
+                                     MeterOutputSumsOfSquares.getReference(CurrentChannel));
+            }
+        }
     }
 }
 
 
-void Compressor::updateMeterBallistics()
+template <typename SampleType>
+void Compressor<SampleType>::processBlockwise(
+    AudioBuffer<SampleType> &MainBuffer,
+    AudioBuffer<SampleType> &SideChainBuffer)
 {
-    // update metering buffer position
-    ++MeterBufferPosition;
+    int nNumSamples = MainBuffer.getNumSamples();
 
-    // meter will only be updated when buffer is full
-    if (MeterBufferPosition < MeterBufferSize)
+    // never allocates memory, as blocks do not exceed the maximum
+    // block size
+    BlockInputSamples.setSize(NumberOfChannels, nNumSamples,
+                              false, false, true);
+
+    // store input samples (the main buffer is overwritten with the
+    // output samples, but the input is still needed for dry mix and
+    // metering)
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        BlockInputSamples.copyFrom(CurrentChannel, 0, MainBuffer,
+                                   CurrentChannel, 0, nNumSamples);
+    }
+
+    // compressor is bypassed (or mix is set to 0 percent)
+    if (CompressorIsBypassedCombined)
     {
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            // store gain reduction now
+            GainReduction.set(CurrentChannel, SampleType(0.0));
+            GainReductionWithMakeup.set(CurrentChannel, SampleType(0.0));
+
+            // output equals input, so a single pass serves both meters
+            if (EngineUpdatesMeters)
+            {
+                SampleType Peak = SampleType(0.0);
+                double SumOfSquares = 0.0;
+
+                accumulateMeterLevels(
+                    BlockInputSamples.getReadPointer(CurrentChannel),
+                    nNumSamples, Peak, SumOfSquares);
+
+                SampleType &InputPeak = MeterInputPeaks.getReference(CurrentChannel);
+                SampleType &OutputPeak = MeterOutputPeaks.getReference(CurrentChannel);
+
+                InputPeak = jmax(InputPeak, Peak);
+                OutputPeak = jmax(OutputPeak, Peak);
+
+                MeterInputSumsOfSquares.getReference(CurrentChannel) += SumOfSquares;
+                MeterOutputSumsOfSquares.getReference(CurrentChannel) += SumOfSquares;
+            }
+        }
+
+        // skip compression
         return;
     }
 
-    // reset buffer location
-    MeterBufferPosition = 0;
+    BlockSidechainSamples.setSize(NumberOfChannels, nNumSamples,
+                                  false, false, true);
+    BlockSidechainLevels.setSize(NumberOfChannels, nNumSamples,
+                                 false, false, true);
+    BlockGainReduction.setSize(NumberOfChannels, nNumSamples,
+                               false, false, true);
+    BlockGainReductionWithMakeup.setSize(NumberOfChannels, nNumSamples,
+                                         false, false, true);
+    BlockGainFactors.setSize(NumberOfChannels, nNumSamples,
+                             false, false, true);
+
+    // parameter ramps are shared by all channels, so calculate them
+    // once per block (settled parameters use the constant values)
+    bool IsMakeupGainSmoothing = SmoothedMakeupGain.isSmoothing();
+    bool IsWetMixSmoothing = SmoothedWetMix.isSmoothing();
+    bool IsGainReductionSignSmoothing = SmoothedGainReductionSign.isSmoothing();
+
+    if (IsMakeupGainSmoothing)
+    {
+        BlockMakeupGains.setSize(1, nNumSamples, false, false, true);
+        SampleType *MakeupGains = BlockMakeupGains.getWritePointer(0);
 
-    // loop over channels
+        for (int nSample = 0; nSample < nNumSamples; ++nSample)
+        {
+            MakeupGains[nSample] = SmoothedMakeupGain.getNextValue();
+        }
+
+        MakeupGain = MakeupGains[nNumSamples - 1];
+    }
+
+    if (IsWetMixSmoothing)
+    {
+        BlockWetMixes.setSize(1, nNumSamples, false, false, true);
+        SampleType *WetMixes = BlockWetMixes.getWritePointer(0);
+
+        for (int nSample = 0; nSample < nNumSamples; ++nSample)
+        {
+            WetMixes[nSample] = SmoothedWetMix.getNextValue();
+        }
+
+        WetMix = WetMixes[nNumSamples - 1];
+        DryMix = SampleType(1.0) - WetMix;
+    }
+
+    if (IsGainReductionSignSmoothing)
+    {
+        BlockGainReductionSigns.setSize(1, nNumSamples, false, false, true);
+        SampleType *GainReductionSigns = BlockGainReductionSigns.getWritePointer(0);
+
+        for (int nSample = 0; nSample < nNumSamples; ++nSample)
+        {
+            GainReductionSigns[nSample] = SmoothedGainReductionSign.getNextValue();
+        }
+
+        GainReductionSign = GainReductionSigns[nNumSamples - 1];
+    }
+
+    // stage 1: get and filter side-chain samples (feed-forward
+    // design, so side chain is fed from *input* channel)
     for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
-        // determine peak levels
-        double InputPeak = MeterInputBuffer.getMagnitude(CurrentChannel, 0, MeterBufferSize);
-        double OutputPeak = MeterOutputBuffer.getMagnitude(CurrentChannel, 0, MeterBufferSize);
+        // with look-ahead, the side-chain buffer also holds the
+        // undelayed main input
+        if (EnableExternalInput || LookAheadIsActive)
+        {
+            // feed side chain from external input
+            BlockSidechainSamples.copyFrom(CurrentChannel, 0, SideChainBuffer,
+                                           CurrentChannel, 0, nNumSamples);
+        }
+        else
+        {
+            // feed side chain from main input
+            BlockSidechainSamples.copyFrom(CurrentChannel, 0, BlockInputSamples,
+                                           CurrentChannel, 0, nNumSamples);
+        }
 
-        // convert peak meter levels from linear scale to decibels
-        InputPeak = SideChain::level2decibel(InputPeak);
-        OutputPeak = SideChain::level2decibel(OutputPeak);
+        SampleType *SideChainSamples = BlockSidechainSamples.getWritePointer(CurrentChannel);
 
-        // apply peak meter ballistics
-        peakMeterBallistics(InputPeak, PeakMeterInputLevels.getReference(CurrentChannel));
-        peakMeterBallistics(OutputPeak, PeakMeterOutputLevels.getReference(CurrentChannel));
+        // filter side-chain samples (the filter's output is already
+        // de-normalised!)
+        if (IsHPFEnabled)
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SidechainFilter_HPF[CurrentChannel]->processSample(
+                    SideChainSamples[nSample], CurrentChannel);
+            }
+        }
 
-        // note: due to the compressor's attack and release times,
-        // there is no need to apply peak gain reduction ballistics
+        if (IsLPFEnabled)
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SidechainFilter_LPF[CurrentChannel]->processSample(
+                    SideChainSamples[nSample], CurrentChannel);
+            }
+        }
+    }
 
-        // determine average levels
-        double InputRms = MeterInputBuffer.getRMSLevel(CurrentChannel, 0, MeterBufferSize);
-        double OutputRms = MeterOutputBuffer.getRMSLevel(CurrentChannel, 0, MeterBufferSize);
+    // stage 2: all channels of side chain have been processed; now
+    // we can calculate the side chain levels
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        const SampleType *SideChainSamples = BlockSidechainSamples.getReadPointer(CurrentChannel);
+        SampleType *SideChainLevels = BlockSidechainLevels.getWritePointer(CurrentChannel);
 
-        // convert average meter levels from linear scale to
-        // decibels
-        InputRms = SideChain::level2decibel(InputRms);
-        OutputRms = SideChain::level2decibel(OutputRms);
+        // stereo linking is off (save some processing time)
+        if (StereoLinkPercentage == 0)
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SideChainLevels[nSample] = std::abs(SideChainSamples[nSample]);
+            }
+        }
+        // stereo linking is on, but there is no other channel (the
+        // per-sample engine treats it as silent, so do the same)
+        else if (NumberOfChannels == 1)
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SideChainLevels[nSample] = std::abs(SideChainSamples[nSample] * StereoLinkWeight);
+            }
+        }
+        // stereo linking is on
+        else
+        {
+            // get ID of other stereo channel
+            int OtherChannel = (CurrentChannel == 0) ? 1 : 0;
+            const SampleType *OtherSamples = BlockSidechainSamples.getReadPointer(OtherChannel);
+
+            // mix side chain according to stereo link percentage;
+            // getting the absolute value of each channel
+            // *separately* allows for a certain kind of M/S
+            // compression
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SideChainLevels[nSample] = std::abs(SideChainSamples[nSample] * StereoLinkWeight) + std::abs(OtherSamples[nSample] * StereoLinkWeightOther);
+            }
+        }
 
-        // apply average meter ballistics
-        averageMeterBallistics(InputRms, AverageMeterInputLevels.getReference(CurrentChannel));
-        averageMeterBallistics(OutputRms, AverageMeterOutputLevels.getReference(CurrentChannel));
+        // convert side chain levels to decibels
+        SideChain<SampleType>::level2decibel(SideChainLevels, SideChainLevels, nNumSamples);
+
+        for (int nSample = 0; nSample < nNumSamples; ++nSample)
+        {
+            SampleType SideChainLevel = SideChainLevels[nSample];
+
+            // apply crest factor
+            SideChainLevel += CrestFactor;
+
+            // apply input trim
+            SideChainLevels[nSample] = SideChainLevel + InputTrim;
+        }
+    }
+
+    // stage 3: send trim-adjusted side chain levels to gain computer
+    // and envelope
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        SideChainProcessor[CurrentChannel]->processBlock(
+            BlockSidechainLevels.getReadPointer(CurrentChannel),
+            BlockGainReduction.getWritePointer(CurrentChannel),
+            BlockGainReductionWithMakeup.getWritePointer(CurrentChannel),
+            nNumSamples);
+
+        // range of gain reduction (read by history)
+        if (History != nullptr)
+        {
+            Range<SampleType> BlockRange = FloatVectorOperations::findMinAndMax(
+                                               BlockGainReduction.getReadPointer(CurrentChannel),
+                                               nNumSamples);
+
+            GainReductionMinimum = jmin(GainReductionMinimum, BlockRange.getStart());
+            GainReductionMaximum = jmax(GainReductionMaximum, BlockRange.getEnd());
+        }
+    }
+
+    // stage 4: apply gain reduction and save output samples
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        const SampleType *InputSamplesBlock = BlockInputSamples.getReadPointer(CurrentChannel);
+        const SampleType *SideChainSamples = BlockSidechainSamples.getReadPointer(CurrentChannel);
+        SampleType *OutputSamplesBlock = MainBuffer.getWritePointer(CurrentChannel);
+
+        const SampleType *GainReductions;
+
+        if (UseAutoMakeupGain)
+        {
+            GainReductions = BlockGainReductionWithMakeup.getReadPointer(CurrentChannel);
+        }
+        else
+        {
+            GainReductions = BlockGainReduction.getReadPointer(CurrentChannel);
+        }
+
+        // invert gain reduction for compression, but not for upward
+        // expansion
+        SampleType *GainFactors = BlockGainFactors.getWritePointer(CurrentChannel);
+
+        if (IsGainReductionSignSmoothing)
+        {
+            const SampleType *GainReductionSigns = BlockGainReductionSigns.getReadPointer(0);
+
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                GainFactors[nSample] = GainReductionSigns[nSample] * GainReductions[nSample];
+            }
+        }
+        else
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                GainFactors[nSample] = GainReductionSign * GainReductions[nSample];
+            }
+        }
+
+        // convert gain reduction to linear scale for the whole block
+        SideChain<SampleType>::decibel2level(GainFactors, GainFactors, nNumSamples);
+
+        SampleType OutputSample = SampleType(0.0);
+
+        if (IsMakeupGainSmoothing)
+        {
+            const SampleType *MakeupGains = BlockMakeupGains.getReadPointer(0);
+
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SampleType InputSample = InputSamplesBlock[nSample];
+                OutputSample = InputSample;
+
+                // apply gain reduction
+                OutputSample *= GainFactors[nSample];
+
+                // apply ramped make-up gain
+                OutputSample *= MakeupGains[nSample];
+
+                OutputSamplesBlock[nSample] = OutputSample;
+            }
+        }
+        else
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SampleType InputSample = InputSamplesBlock[nSample];
+                OutputSample = InputSample;
+
+                // apply gain reduction
+                OutputSample *= GainFactors[nSample];
+
+                // apply make-up gain
+                OutputSample *= MakeupGain;
+
+                OutputSamplesBlock[nSample] = OutputSample;
+            }
+        }
+
+        // store last output sample (used by side chain in case the
+        // user switches to feed-back design)
+        OutputSamples.set(CurrentChannel, OutputSample);
+
+        // listen to side-chain (already de-normalised)
+        if (SidechainListenEnabled)
+        {
+            MainBuffer.copyFrom(CurrentChannel, 0, SideChainSamples,
+                                nNumSamples);
+        }
+        // wet mix is ramping
+        else if (IsWetMixSmoothing)
+        {
+            const SampleType *WetMixes = BlockWetMixes.getReadPointer(0);
+
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                SampleType WetMixCurrent = WetMixes[nSample];
+                SampleType DryMixCurrent = SampleType(1.0) - WetMixCurrent;
+
+                OutputSamplesBlock[nSample] = OutputSamplesBlock[nSample] * WetMixCurrent +
+                                              InputSamplesBlock[nSample] * DryMixCurrent;
+            }
+        }
+        // dry shall be mixed in (test to save some processing time)
+        else if (WetMix < SampleType(1.0))
+        {
+            for (int nSample = 0; nSample < nNumSamples; ++nSample)
+            {
+                OutputSamplesBlock[nSample] = OutputSamplesBlock[nSample] * WetMix +
+                                              InputSamplesBlock[nSample] * DryMix;
+            }
+        }
+
+        // add input and output of this channel to the meters while
+        // they are still cached
+        if (EngineUpdatesMeters)
+        {
+            accumulateMeterLevels(
+                InputSamplesBlock, nNumSamples,
+                MeterInputPeaks.getReference(CurrentChannel),
+                MeterInputSumsOfSquares.getReference(CurrentChannel));
+
+            accumulateMeterLevels(
+                OutputSamplesBlock, nNumSamples,
+                MeterOutputPeaks.getReference(CurrentChannel),
+                MeterOutputSumsOfSquares.getReference(CurrentChannel));
+        }
+
+        // store gain reduction of last sample
+        GainReduction.set(CurrentChannel, BlockGainReduction.getSample(
+                              CurrentChannel, nNumSamples - 1));
+        GainReductionWithMakeup.set(CurrentChannel, BlockGainReductionWithMakeup.getSample(
+                                        CurrentChannel, nNumSamples - 1));
     }
 }
 
 
-void Compressor::peakMeterBallistics(double PeakLevelCurrent, double &PeakLevelOld)
-/*  Calculate ballistics for peak meter levels.
+template <typename SampleType>
+void Compressor<SampleType>::updateMeterLevels(
+    const AudioBuffer<SampleType> &InputBuffer,
+    const AudioBuffer<SampleType> &OutputBuffer,
+    int NumberOfSamples)
+/*  Add input and output samples to meters.  Only used for oversampled
+    blocks, as the engines add samples to the meters while processing
+    at the original sample rate.
 
-    PeakLevelCurrent (double): current peak meter level in decibel
+    InputBuffer (AudioBuffer): input samples
 
-    PeakLevelOld (double): old peak meter reading in decibel (will be
-    overwritten!)
+    OutputBuffer (AudioBuffer): output samples
+
+    NumberOfSamples (integer): number of samples to add
 
     return value: none
 */
 {
-    // limit peak level
-    if (PeakLevelCurrent >= 0.0)
+    int StartSample = 0;
+
+    while (StartSample < NumberOfSamples)
     {
-        // immediate rise time, but limit current peak to top mark
-        PeakLevelOld = 0.0;
+        // accumulate samples up to the end of the meter buffer
+        int SamplesToAccumulate = jmin(NumberOfSamples - StartSample,
+                                       MeterBufferSize - MeterBufferPosition);
+
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            accumulateMeterLevels(
+                InputBuffer.getReadPointer(CurrentChannel, StartSample),
+                SamplesToAccumulate,
+                MeterInputPeaks.getReference(CurrentChannel),
+                MeterInputSumsOfSquares.getReference(CurrentChannel));
+
+            accumulateMeterLevels(
+                OutputBuffer.getReadPointer(CurrentChannel, StartSample),
+                SamplesToAccumulate,
+                MeterOutputPeaks.getReference(CurrentChannel),
+                MeterOutputSumsOfSquares.getReference(CurrentChannel));
+        }
+
+        // update meter ballistics and increment buffer location
+        updateMeterBallistics(SamplesToAccumulate);
+        StartSample += SamplesToAccumulate;
     }
-    // apply rise time if peak level is above old level
-    else if (PeakLevelCurrent >= PeakLevelOld)
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::accumulateMeterLevels(
+    const SampleType *Samples,
+    int NumberOfSamples,
+    SampleType &Peak,
+    double &SumOfSquares)
+/*  Update peak level and sum of squares of meter buffer in a single
+    pass.
+
+    Samples (SampleType*): samples to add to meter buffer
+
+    NumberOfSamples (integer): number of samples
+
+    Peak (SampleType): peak level (will be overwritten!)
+
+    SumOfSquares (double): sum of squared samples (will be
+    overwritten!)
+
+    return value: none
+*/
+{
+    // independent partial results keep the additions and comparisons
+    // from waiting for each other (and can be vectorised)
+    SampleType Peaks[4] = {Peak, Peak, Peak, Peak};
+    SampleType Sums[4] = {SampleType(0.0), SampleType(0.0),
+                          SampleType(0.0), SampleType(0.0)
+                         };
+
+    int Sample = 0;
+
+    for (; Sample <= NumberOfSamples - 4; Sample += 4)
     {
-        // immediate rise time, so return current peak level as new
-        // peak meter reading
-        PeakLevelOld = PeakLevelCurrent;
+        for (int Lane = 0; Lane < 4; ++Lane)
+        {
+            SampleType Value = Samples[Sample + Lane];
+            SampleType Magnitude = std::abs(Value);
+
+            Peaks[Lane] = (Magnitude > Peaks[Lane]) ? Magnitude : Peaks[Lane];
+            Sums[Lane] += Value * Value;
+        }
     }
-    // otherwise, apply fall time
-    else
+
+    for (; Sample < NumberOfSamples; ++Sample)
     {
-        // apply fall time and return new peak meter reading (linear
-        // fall time: 26 dB in 3 seconds)
-        PeakLevelOld -= ReleaseCoefLinear;
+        SampleType Value = Samples[Sample];
+        SampleType Magnitude = std::abs(Value);
 
-        // make sure that meter doesn't fall below current level
-        if (PeakLevelCurrent > PeakLevelOld)
-        {
-            PeakLevelOld = PeakLevelCurrent;
-        }
+        Peaks[0] = (Magnitude > Peaks[0]) ? Magnitude : Peaks[0];
+        Sums[0] += Value * Value;
     }
+
+    Peak = jmax(jmax(Peaks[0], Peaks[1]), jmax(Peaks[2], Peaks[3]));
+    SumOfSquares += double(Sums[0] + Sums[1]) + double(Sums[2] + Sums[3]);
 }
 
 
-void Compressor::averageMeterBallistics(double AverageLevelCurrent, double &AverageLevelOld)
-/*  Calculate ballistics for average meter levels and update readout.
+template <typename SampleType>
+void Compressor<SampleType>::accumulateMeterLevel(
+    SampleType Sample,
+    SampleType &Peak,
+    double &SumOfSquares)
+/*  Update peak level and sum of squares of meter buffer with a single
+    sample.
 
-    AverageLevelCurrent (double): current average meter level in
-    decibel
+    Sample (SampleType): sample to add to meter buffer
 
-    AverageLevelOld (double): old average meter reading in decibel
-    (will be overwritten!)
+    Peak (SampleType): peak level (will be overwritten!)
+
+    SumOfSquares (double): sum of squared samples (will be
+    overwritten!)
 
     return value: none
 */
 {
-    // the meter reaches 99% of the final reading in 300 ms
-    // (logarithmic)
-    logMeterBallistics(0.300, BufferLength, AverageLevelCurrent, AverageLevelOld);
+    SampleType Magnitude = std::abs(Sample);
+
+    Peak = (Magnitude > Peak) ? Magnitude : Peak;
+    SumOfSquares += double(Sample * Sample);
 }
 
 
-void Compressor::logMeterBallistics(double MeterInertia, double TimePassed, double Level, double &Readout)
-/*  Calculate logarithmic meter ballistics.
+template <typename SampleType>
+void Compressor<SampleType>::updateMeterBallistics(int NumberOfSamples)
+{
+    // update metering buffer position
+    MeterBufferPosition += NumberOfSamples;
+    jassert(MeterBufferPosition <= MeterBufferSize);
+
+    // meter will only be updated when buffer is full
+    if (MeterBufferPosition < MeterBufferSize)
+    {
+        return;
+    }
+
+    // reset buffer location
+    MeterBufferPosition = 0;
+
+    // loop over channels
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+    {
+        // determine peak levels
+        SampleType InputPeak = MeterInputPeaks[CurrentChannel];
+        SampleType OutputPeak = MeterOutputPeaks[CurrentChannel];
+
+        // convert peak meter levels from linear scale to decibels
+        InputPeak = SideChain<SampleType>::level2decibel(InputPeak);
+        OutputPeak = SideChain<SampleType>::level2decibel(OutputPeak);
+
+        // apply peak meter ballistics
+        Ballistics.peak(InputPeak, PeakMeterInputLevels.getReference(CurrentChannel));
+        Ballistics.peak(OutputPeak, PeakMeterOutputLevels.getReference(CurrentChannel));
 
-    MeterInertia (double): time needed to reach 99% of the final
-    readout (in fractional seconds)
+        // note: due to the compressor's attack and release times,
+        // there is no need to apply peak gain reduction ballistics
 
-    TimePassed (double): time that has passed since last update (in
-    fractional seconds)
+        // determine average levels
+        SampleType InputRms = SampleType(std::sqrt(
+                                             MeterInputSumsOfSquares[CurrentChannel] / MeterBufferSize));
+        SampleType OutputRms = SampleType(std::sqrt(
+                                              MeterOutputSumsOfSquares[CurrentChannel] / MeterBufferSize));
 
-    Level (double): new meter level
+        // start accumulating next meter buffer
+        MeterInputPeaks.set(CurrentChannel, SampleType(0.0));
+        MeterOutputPeaks.set(CurrentChannel, SampleType(0.0));
+        MeterInputSumsOfSquares.set(CurrentChannel, 0.0);
+        MeterOutputSumsOfSquares.set(CurrentChannel, 0.0);
 
-    Readout (reference to double): old meter readout; this variable
-    will be updated by this function
+        // convert average meter levels from linear scale to
+        // decibels
+        InputRms = SideChain<SampleType>::level2decibel(InputRms);
+        OutputRms = SideChain<SampleType>::level2decibel(OutputRms);
 
-    return value: none
-*/
+        // apply average meter ballistics
+        Ballistics.average(InputRms, AverageMeterInputLevels.getReference(CurrentChannel));
+        Ballistics.average(OutputRms, AverageMeterOutputLevels.getReference(CurrentChannel));
+
+        if (TruePeakMetersEnabled)
+        {
+            // determine true-peak levels measured since the last
+            // meter update (zero if measurement has not finished yet)
+            SampleType InputTruePeak = TruePeakMeters->popInputLevel(CurrentChannel);
+            SampleType OutputTruePeak = TruePeakMeters->popOutputLevel(CurrentChannel);
+
+            // convert true-peak levels from linear scale to decibels
+            InputTruePeak = SideChain<SampleType>::level2decibel(InputTruePeak);
+            OutputTruePeak = SideChain<SampleType>::level2decibel(OutputTruePeak);
+
+            // apply peak meter ballistics
+            Ballistics.peak(InputTruePeak, TruePeakMeterInputLevels.getReference(CurrentChannel));
+            Ballistics.peak(OutputTruePeak, TruePeakMeterOutputLevels.getReference(CurrentChannel));
+        }
+    }
+}
+
+
+template <typename SampleType>
+void Compressor<SampleType>::publishMeterSnapshot()
 {
-    // we only have to calculate meter ballistics if meter level and
-    // meter readout are not equal
-    if (Level != Readout)
+    // never blocks and never allocates memory
+    MeterSnapshot &Snapshot = MeterSnapshots.getWriteSnapshot();
+
+    for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
     {
-        // Thanks to Bram de Jong for the code snippet!
-        // (http://www.musicdsp.org/showone.php?id=136)
-        //
-        // rise and fall: 99% of final reading in "fMeterInertia" seconds
-        double AttackReleaseCoef = pow(0.01, TimePassed / MeterInertia);
-        Readout = AttackReleaseCoef * (Readout - Level) + Level;
+        Snapshot.PeakInputLevels[CurrentChannel] = (float) getPeakMeterInputLevel(CurrentChannel);
+        Snapshot.PeakOutputLevels[CurrentChannel] = (float) getPeakMeterOutputLevel(CurrentChannel);
+
+        Snapshot.AverageInputLevels[CurrentChannel] = (float) getAverageMeterInputLevel(CurrentChannel);
+        Snapshot.AverageOutputLevels[CurrentChannel] = (float) getAverageMeterOutputLevel(CurrentChannel);
+
+        Snapshot.TruePeakInputLevels[CurrentChannel] = (float) getTruePeakMeterInputLevel(CurrentChannel);
+        Snapshot.TruePeakOutputLevels[CurrentChannel] = (float) getTruePeakMeterOutputLevel(CurrentChannel);
+
+        Snapshot.GainReduction[CurrentChannel] = (float) getGainReduction(CurrentChannel);
     }
+
+    MeterSnapshots.publish();
 }
+
+
+// explicit instantiation of all template instances
+template class Compressor<float>;
+template class Compressor<double>;
@@ -27,10 +27,14 @@
 #define SQUEEZER_COMPRESSOR_H
 
 #include "FrutHeader.h"
+#include "gain_reduction_history.h"
+#include "loudness_analyser.h"
+#include "meter_snapshot.h"
 #include "side_chain.h"
+#include "true_peak_analyser.h"
 
 
-class Compressor
+class CompressorBase
 {
 public:
     enum Parameters  // public namespace!
@@ -43,16 +47,48 @@ public:
         KneeMedium,
         KneeSoft,
         NumberOfKneeSettings,
+
+        ProcessBlockwise = 0,
+        ProcessPerSample,
+        NumberOfProcessingModes,
     };
 
+    // maximum look-ahead in milliseconds
+    static constexpr double MaximumLookAhead = 20.0;
+
+    // maximum oversampling factor (supported factors are powers of
+    // two)
+    static constexpr int MaximumOversampling = 8;
+};
+
+
+template <typename SampleType>
+class Compressor :
+    public CompressorBase
+{
+public:
     Compressor(int channels,
-               int sample_rate);
+               int sample_rate,
+               int maximum_block_size);
 
+    void reset();
     void resetMeters();
+    void skipSmoothing();
+
+    int getProcessingMode();
+    void setProcessingMode(int ProcessingModeNew);
 
     bool getBypass();
     void setBypass(bool CompressorIsBypassedNew);
 
+    double getLookAhead();
+    void setLookAhead(double LookAheadMilliSecondsNew);
+
+    int getOversampling();
+    void setOversampling(int OversamplingFactorNew);
+
+    int getLatencySamples();
+
     double getRmsWindowSize();
     void setRmsWindowSize(double RmsWindowSizeMilliSecondsNew);
 
@@ -115,42 +151,130 @@ public:
     double getAverageMeterInputLevel(int CurrentChannel);
     double getAverageMeterOutputLevel(int CurrentChannel);
 
-    void process(AudioBuffer<double> &MainBuffer,
-                 AudioBuffer<double> &SideChainBuffer);
+    bool getMetering();
+    void setMetering(bool UseMetersNew);
+
+    int getMeterBallistics();
+    void setMeterBallistics(int MeterStandardNew);
+
+    bool getTruePeakMetering();
+    void setTruePeakMetering(bool UseTruePeakMetersNew);
+
+    double getTruePeakMeterInputLevel(int CurrentChannel);
+    double getTruePeakMeterOutputLevel(int CurrentChannel);
+
+    bool getLoudnessMetering();
+    void setLoudnessMetering(bool UseLoudnessMetersNew);
+    void resetLoudnessMeters();
+
+    float getInputLoudness(int Measurement);
+    float getOutputLoudness(int Measurement);
+
+    bool getMeterSnapshot(MeterSnapshot &Snapshot);
+
+    void setGainReductionHistory(GainReductionHistory *HistoryNew);
+
+    void process(AudioBuffer<SampleType> &MainBuffer,
+                 AudioBuffer<SampleType> &SideChainBuffer);
 
 private:
     JUCE_LEAK_DETECTOR(Compressor);
 
+    // benchmarks private hot paths such as meter ballistics
+    friend class DspBenchmark;
+
     const double BufferLength;
 
-    void updateMeterBallistics();
+    void processWithEngine(AudioBuffer<SampleType> &MainBuffer,
+                           AudioBuffer<SampleType> &SideChainBuffer);
 
-    void peakMeterBallistics(double PeakLevelCurrent,
-                             double &PeakLevelOld);
+    void processPerSample(AudioBuffer<SampleType> &MainBuffer,
+                          AudioBuffer<SampleType> &SideChainBuffer);
 
-    void averageMeterBallistics(double AverageLevelCurrent,
-                                double &AverageLevelOld);
+    void processBlockwise(AudioBuffer<SampleType> &MainBuffer,
+                          AudioBuffer<SampleType> &SideChainBuffer);
 
-    void logMeterBallistics(double MeterInertia,
-                            double TimePassed,
-                            double Level,
-                            double &Readout);
+    void updateCombinedBypass();
+    void updateSmoothingTargets();
+    void applyLatencyChanges();
+    void delaySamples(AudioBuffer<SampleType> &Buffer,
+                      AudioBuffer<SampleType> &DelayLine,
+                      int &WritePosition,
+                      int NumberOfSamples);
+    void restartMeters();
+    void resetTruePeakMeters();
+    int getMeterCrestFactor();
+    void createSideChains();
+
+    void updateMeterLevels(const AudioBuffer<SampleType> &InputBuffer,
+                           const AudioBuffer<SampleType> &OutputBuffer,
+                           int NumberOfSamples);
+
+    static void accumulateMeterLevels(const SampleType *Samples,
+                                      int NumberOfSamples,
+                                      SampleType &Peak,
+                                      double &SumOfSquares);
+
+    static void accumulateMeterLevel(SampleType Sample,
+                                     SampleType &Peak,
+                                     double &SumOfSquares);
+
+    void updateMeterBallistics(int NumberOfSamples);
+    void publishMeterSnapshot();
 
     int NumberOfChannels;
     int SampleRate;
+    int ProcessingSampleRate;
     int MeterBufferPosition;
     int MeterBufferSize;
-
-    AudioBuffer<double> MeterInputBuffer;
-    AudioBuffer<double> MeterOutputBuffer;
-
-    OwnedArray<SideChain> SideChainProcessor;
-    OwnedArray<frut::dsp::IirFilterBox> SidechainFilter_HPF;
-    OwnedArray<frut::dsp::IirFilterBox> SidechainFilter_LPF;
-
-    Array<double> InputSamples;
-    Array<double> SidechainSamples;
-    Array<double> OutputSamples;
+    int MaximumBlockSize;
+
+    // meters are updated whenever the meter buffer is full; the
+    // standard is set by any thread, but ballistics are only touched
+    // by the audio thread
+    frut::dsp::MeterBallistics Ballistics;
+    Atomic<int> MeterStandardRequested;
+
+    // peak levels and sums of squares of the current meter buffer;
+    // updated for every processed block, so samples need not be
+    // stored and scanned again
+    Array<SampleType> MeterInputPeaks;
+    Array<SampleType> MeterOutputPeaks;
+    Array<double> MeterInputSumsOfSquares;
+    Array<double> MeterOutputSumsOfSquares;
+
+    // side chains and side-chain filters exist for every
+    // oversampling factor (indexed by factor and channel), so that
+    // switching factors never allocates memory
+    OwnedArray<SideChain<SampleType>> AllSideChains;
+    OwnedArray<frut::dsp::IirFilterBox> AllSidechainFilters_HPF;
+    OwnedArray<frut::dsp::IirFilterBox> AllSidechainFilters_LPF;
+
+    // side chains and side-chain filters of the current oversampling
+    // factor (one per channel)
+    Array<SideChain<SampleType> *> SideChainProcessor;
+    Array<frut::dsp::IirFilterBox *> SidechainFilter_HPF;
+    Array<frut::dsp::IirFilterBox *> SidechainFilter_LPF;
+
+    Array<SampleType> InputSamples;
+    Array<SampleType> SidechainSamples;
+    Array<SampleType> OutputSamples;
+
+    // work buffers of block-based engine (one contiguous array per
+    // channel and processing stage)
+    AudioBuffer<SampleType> BlockInputSamples;
+    AudioBuffer<SampleType> BlockSidechainSamples;
+    AudioBuffer<SampleType> BlockSidechainLevels;
+    AudioBuffer<SampleType> BlockGainReduction;
+    AudioBuffer<SampleType> BlockGainReductionWithMakeup;
+    AudioBuffer<SampleType> BlockGainFactors;
+    AudioBuffer<SampleType> BlockMakeupGains;
+    AudioBuffer<SampleType> BlockWetMixes;
+    AudioBuffer<SampleType> BlockGainReductionSigns;
+
+    // input samples of current block at the original sample rate
+    // (read by the meters)
+    AudioBuffer<SampleType> MeterInputSamples;
 
     Array<double> PeakMeterInputLevels;
     Array<double> PeakMeterOutputLevels;
@@ -158,37 +282,132 @@ private:
     Array<double> AverageMeterInputLevels;
     Array<double> AverageMeterOutputLevels;
 
-    Array<double> GainReduction;
-    Array<double> GainReductionWithMakeup;
+    bool UseMeters;
 
-    double CrestFactor;
-    int CompressorDesign;
+    // engines add processed samples to the meters (only possible
+    // while they run at the original sample rate; blocks are then
+    // split at the end of each meter buffer)
+    bool EngineUpdatesMeters;
+
+    // true-peak levels are measured on a background thread and lag
+    // behind the other meters by one meter buffer
+    // analyser is created when true-peak meters are first enabled,
+    // and its thread only runs while they are enabled
+    Atomic<bool> UseTruePeakMeters;
+    std::unique_ptr<TruePeakAnalyser<SampleType>> TruePeakMeters;
+
+    // state of true-peak meters for the current block; only touched
+    // by the audio thread
+    bool TruePeakMetersEnabled;
 
-    double ReleaseCoefLinear;
+    Array<double> TruePeakMeterInputLevels;
+    Array<double> TruePeakMeterOutputLevels;
+
+    // loudness is measured on a background thread; unlike the other
+    // meters, it is measured while nobody reads the meters; the
+    // analyser is created when loudness meters are first enabled,
+    // and its thread only runs while they are enabled
+    Atomic<bool> UseLoudnessMeters;
+    std::unique_ptr<LoudnessAnalyser<SampleType>> LoudnessMeters;
+
+    Array<SampleType> GainReduction;
+    Array<SampleType> GainReductionWithMakeup;
+
+    // range of gain reduction in current block (all channels); fed
+    // into gain reduction history (along with the output level),
+    // which is owned by the caller
+    SampleType GainReductionMinimum;
+    SampleType GainReductionMaximum;
+    GainReductionHistory *History;
+
+    MeterSnapshotBuffer MeterSnapshots;
+
+    SampleType CrestFactor;
+    int CompressorDesign;
+    int ProcessingMode;
+
+    // look-ahead delays the main path, so the side chain runs ahead
+    // of the audio; the delay line holds the maximum look-ahead and
+    // is always written, so the audio thread can change the
+    // look-ahead in place
+    double LookAheadMilliSeconds;
+    Atomic<int> LookAheadSamplesRequested;
+    int LookAheadSamples;
+    AudioBuffer<SampleType> LookAheadDelay;
+    int LookAheadWritePosition;
+    AudioBuffer<SampleType> LookAheadSidechainSamples;
+
+    // main path is delayed in the current block (look-ahead or
+    // crossfade from previous look-ahead)
+    bool LookAheadIsActive;
+
+    // changing the look-ahead crossfades from the previous delay to
+    // the new one instead of jumping between them
+    int LookAheadSamplesPrevious;
+    SmoothedValue<SampleType> LookAheadCrossfade;
+
+    // the side chain the user listens to is delayed like the main
+    // path, so that both line up
+    AudioBuffer<SampleType> SidechainListenDelay;
+    int SidechainListenWritePosition;
+
+    // oversampling runs side chain, gain stage and gain multiplication
+    // at a multiple of the sample rate, which keeps fast attacks from
+    // aliasing; oversamplers exist for every factor, so the audio
+    // thread can switch factors in place
+    Atomic<int> OversamplingFactorRequested;
+    int OversamplingFactor;
+    OwnedArray<frut::dsp::Oversampler<SampleType>> MainOversamplers;
+    OwnedArray<frut::dsp::Oversampler<SampleType>> SidechainOversamplers;
+    frut::dsp::Oversampler<SampleType> *MainOversampler;
+    frut::dsp::Oversampler<SampleType> *SidechainOversampler;
+    AudioBuffer<SampleType> OversampledMainSamples;
+    AudioBuffer<SampleType> OversampledSidechainSamples;
+
+    // latency of the settings the audio thread currently uses
+    Atomic<int> LatencySamples;
 
     bool CompressorIsBypassed;
     bool CompressorIsBypassedCombined;
     bool DesignIsFeedForward;
-    bool UseUpwardExpansion;
 
     int StereoLinkPercentage;
-    double StereoLinkWeight;
-    double StereoLinkWeightOther;
+    SampleType StereoLinkWeight;
+    SampleType StereoLinkWeightOther;
 
-    double InputTrim;
+    SampleType InputTrim;
     bool UseAutoMakeupGain;
-    double MakeupGain;
+    SampleType MakeupGain;
     double MakeupGainDecibel;
 
+    // targets are set by any thread, but ramps are only touched by
+    // the audio thread
+    Atomic<SampleType> MakeupGainTarget;
+    Atomic<SampleType> WetMixTarget;
+    Atomic<bool> UseUpwardExpansion;
+
+    SmoothedValue<SampleType, ValueSmoothingTypes::Multiplicative> SmoothedMakeupGain;
+
     int WetMixPercentage;
-    double WetMix;
-    double DryMix;
+    SampleType WetMix;
+    SampleType DryMix;
+    SmoothedValue<SampleType> SmoothedWetMix;
+
+    // gain reduction is multiplied by -1 for compression and +1 for
+    // upward expansion; the sign is ramped, so that the gain passes
+    // through unity instead of jumping when the ratio crosses 1:1
+    SampleType GainReductionSign;
+    SmoothedValue<SampleType> SmoothedGainReductionSign;
 
     bool EnableExternalInput;
     bool IsHPFEnabled;
     bool IsLPFEnabled;
     bool ListenToSidechain;
 
+    // state of side-chain listen for the current block; only touched
+    // by the audio thread
+    bool SidechainListenEnabled;
+
     int SidechainHPFCutoff;
     int SidechainLPFCutoff;
 };
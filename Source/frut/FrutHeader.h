@@ -33,6 +33,14 @@
 #define FRUT_DSP_USE_FFTW 0
 #endif
 
+#ifndef FRUT_AUDIO_ALLOCATION_GUARD
+#ifdef DEBUG
+#define FRUT_AUDIO_ALLOCATION_GUARD 1
+#else
+#define FRUT_AUDIO_ALLOCATION_GUARD 0
+#endif
+#endif
+
 
 namespace frut
 {
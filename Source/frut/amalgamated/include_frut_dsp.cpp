@@ -36,6 +36,8 @@
 #include "../dsp/filter_chebyshev_stage.cpp"
 #include "../dsp/fir_filter_box.cpp"
 #include "../dsp/iir_filter_box.cpp"
+#include "../dsp/meter_ballistics.cpp"
+#include "../dsp/oversampler.cpp"
 #include "../dsp/rate_converter.cpp"
 #include "../dsp/true_peak_meter.cpp"
 
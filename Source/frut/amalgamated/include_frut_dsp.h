@@ -42,6 +42,8 @@
 #include "../dsp/filter_chebyshev_stage.h"
 #include "../dsp/fir_filter_box.h"
 #include "../dsp/iir_filter_box.h"
+#include "../dsp/meter_ballistics.h"
+#include "../dsp/oversampler.h"
 #include "../dsp/rate_converter.h"
 #include "../dsp/true_peak_meter.h"
 
@@ -30,6 +30,7 @@
 #include "../FrutHeader.h"
 
 #include "../math/averager.cpp"
+#include "../math/fast_math.cpp"
 
 
 #endif  // FRUT_AMALGAMATED_MATH_CPP
@@ -29,6 +29,7 @@
 
 // normal includes
 #include "../math/averager.h"
+#include "../math/fast_math.h"
 #include "../math/simple_math.h"
 
 
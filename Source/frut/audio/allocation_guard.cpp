@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace audio
+{
+
+#if FRUT_AUDIO_ALLOCATION_GUARD
+
+namespace
+{
+// number of guards that are alive on the current thread
+thread_local int activeGuards = 0;
+}
+
+
+/// Forbid allocations on the current thread until this guard goes
+/// out of scope.
+///
+AllocationGuard::AllocationGuard()
+{
+    ++activeGuards;
+}
+
+
+AllocationGuard::~AllocationGuard()
+{
+    --activeGuards;
+}
+
+
+/// Check whether a guard is alive on the current thread.
+///
+/// @return **true** if allocations are forbidden, **false**
+///         otherwise
+///
+bool AllocationGuard::isActive()
+{
+    return activeGuards > 0;
+}
+
+
+/// Assert if a guard is alive on the current thread.  Called for
+/// each allocation.
+///
+void AllocationGuard::checkAllocation()
+{
+    if (activeGuards > 0)
+    {
+        // assertions allocate memory for logging, so suspend guards
+        // to prevent infinite recursion
+        int suspendedGuards = activeGuards;
+        activeGuards = 0;
+
+        // memory has been allocated in real-time code
+        jassertfalse;
+
+        activeGuards = suspendedGuards;
+    }
+}
+
+#else
+
+AllocationGuard::AllocationGuard()
+{
+}
+
+
+AllocationGuard::~AllocationGuard()
+{
+}
+
+
+bool AllocationGuard::isActive()
+{
+    return false;
+}
+
+
+void AllocationGuard::checkAllocation()
+{
+}
+
+#endif
+
+}
+}
@@ -0,0 +1,63 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_AUDIO_ALLOCATION_GUARD_H
+#define FRUT_AUDIO_ALLOCATION_GUARD_H
+
+namespace frut
+{
+namespace audio
+{
+
+/// Scoped guard for real-time code.  While a guard is alive, every
+/// call to "operator new" on the same thread triggers an assertion.
+/// Guards may be nested.
+///
+/// The check is only compiled when FRUT_AUDIO_ALLOCATION_GUARD is
+/// non-zero (default for debug builds); otherwise, this class does
+/// nothing at all.  Allocations are only detected by executables that
+/// replace the global allocation functions and call
+/// checkAllocation() from them.  Plug-ins must not do this, as the
+/// replacement would affect the whole host process; here, guards
+/// merely mark real-time code.  Memory that is allocated by calling
+/// "malloc" directly (such as JUCE's HeapBlock) cannot be detected.
+///
+class AllocationGuard
+{
+public:
+    AllocationGuard();
+    ~AllocationGuard();
+
+    static bool isActive();
+    static void checkAllocation();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(AllocationGuard);
+};
+
+}
+}
+
+#endif  // FRUT_AUDIO_ALLOCATION_GUARD_H
@@ -183,6 +183,18 @@ void BiquadFilter::processSample(
 }
 
 
+void BiquadFilter::processSample(
+    float &sampleValue,
+    const int channel)
+{
+    // filter state is kept in double precision
+    double sampleValueDouble = sampleValue;
+    processSample(sampleValueDouble, channel);
+
+    sampleValue = static_cast<float>(sampleValueDouble);
+}
+
+
 void BiquadFilter::processInPlace(
     AudioBuffer<double> &buffer)
 {
@@ -41,6 +41,7 @@ public:
     void resetDelays();
 
     void processSample(double &sampleValue, const int channel);
+    void processSample(float &sampleValue, const int channel);
     void processInPlace(AudioBuffer<double> &buffer);
     AudioBuffer<double> process(const AudioBuffer<double> &inputBuffer);
 
@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace dsp
+{
+
+// definition of a metering standard
+struct MeterBallisticsDefinition
+{
+    // linear fall of peak meter in decibels per second
+    double peakFallRate;
+
+    // time needed by average meter to reach 99% of the final readout
+    // (in fractional seconds)
+    double averageInertia;
+
+    // headroom of meter scale in decibels
+    int crestFactor;
+};
+
+
+// indexed by MeterBallistics::Standard
+static const MeterBallisticsDefinition meterBallisticsDefinitions[] =
+{
+    {26.0 / 3.0, 0.300, 20},  // default
+    {20.0 / 1.5, 0.300, 20},  // PPM Type I (fall-back only)
+    {24.0 / 2.8, 0.300, 20},  // PPM Type II (fall-back only)
+    {26.0 / 3.0, 0.300, 18},  // VU
+    {26.0 / 3.0, 0.600, 20},  // K-20
+    {26.0 / 3.0, 0.600, 14},  // K-14
+    {26.0 / 3.0, 0.600, 12},  // K-12
+};
+
+
+/// Create meter ballistics of all standards.  The default standard
+/// is selected.
+///
+/// @param updateInterval time between meter updates (in fractional
+///        seconds)
+///
+MeterBallistics::MeterBallistics(
+    const double updateInterval) :
+
+    updateInterval_(updateInterval)
+{
+    static_assert(sizeof(meterBallisticsDefinitions) /
+                  sizeof(meterBallisticsDefinitions[0]) == numberOfStandards,
+                  "every metering standard needs a definition");
+
+    jassert(updateInterval_ > 0.0);
+
+    for (int standard = 0; standard < numberOfStandards; ++standard)
+    {
+        const MeterBallisticsDefinition &definition =
+            meterBallisticsDefinitions[standard];
+
+        peakFallsPerUpdate_[standard] =
+            definition.peakFallRate * updateInterval_;
+
+        // Thanks to Bram de Jong for the code snippet!
+        // (http://www.musicdsp.org/showone.php?id=136)
+        //
+        // rise and fall: 99% of final reading in "averageInertia"
+        // seconds
+        averageCoefficients_[standard] =
+            pow(0.01, updateInterval_ / definition.averageInertia);
+    }
+
+    setStandard(standardDefault);
+}
+
+
+/// Get current metering standard.
+///
+/// @return metering standard
+///
+int MeterBallistics::getStandard() const
+{
+    return standard_;
+}
+
+
+/// Set metering standard.  Does not allocate memory.
+///
+/// @param standard new metering standard
+///
+void MeterBallistics::setStandard(
+    const int standard)
+{
+    jassert(isPositiveAndBelow(standard, static_cast<int>(numberOfStandards)));
+
+    standard_ = standard;
+
+    peakFallPerUpdate_ = peakFallsPerUpdate_[standard_];
+    averageCoefficient_ = averageCoefficients_[standard_];
+}
+
+
+/// Get time between meter updates.
+///
+/// @return update interval (in fractional seconds)
+///
+double MeterBallistics::getUpdateInterval() const
+{
+    return updateInterval_;
+}
+
+
+/// Get headroom of current metering standard's scale.
+///
+/// @return crest factor in decibels
+///
+int MeterBallistics::getCrestFactor() const
+{
+    return getCrestFactor(standard_);
+}
+
+
+/// Get headroom of a metering standard's scale.
+///
+/// @param standard metering standard
+///
+/// @return crest factor in decibels
+///
+int MeterBallistics::getCrestFactor(
+    const int standard)
+{
+    jassert(isPositiveAndBelow(standard, static_cast<int>(numberOfStandards)));
+
+    return meterBallisticsDefinitions[standard].crestFactor;
+}
+
+}
+}
@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_DSP_METER_BALLISTICS_H
+#define FRUT_DSP_METER_BALLISTICS_H
+
+namespace frut
+{
+namespace dsp
+{
+
+/// Meter ballistics of common metering standards.  Peak meters rise
+/// instantly and fall linearly (in decibels), average meters rise
+/// and fall logarithmically.  Meters are updated in fixed intervals;
+/// the coefficients of all standards are calculated once for this
+/// interval, so neither switching standards nor updating readouts
+/// calls pow().
+///
+/// Readouts are stored in decibels relative to full scale.  The
+/// crest factor of a standard is the headroom of its scale (the
+/// reference level lies this many decibels below full scale).
+///
+class MeterBallistics
+{
+public:
+    /// Metering standards.
+    enum Standard  // public namespace!
+    {
+        /// peak: 26 dB fall in 3 s; average: 300 ms; reference:
+        /// -20 dBFS
+        standardDefault = 0,
+
+        /// PPM fall-back only: fall time of IEC 60268-10 Type I
+        /// (DIN) PPM (20 dB in 1.5 s); peaks rise instantly instead
+        /// of using the integration time of the standard
+        standardPpmType1,
+
+        /// PPM fall-back only: fall time of IEC 60268-10 Type IIa
+        /// (BBC, EBU) PPM (24 dB in 2.8 s); peaks rise instantly
+        /// instead of using the integration time of the standard
+        standardPpmType2,
+
+        /// IEC 60268-17 VU meter: average reaches 99% in 300 ms;
+        /// reference: -18 dBFS (EBU R68)
+        standardVu,
+
+        /// K-System (Bob Katz): average reaches 99% in 600 ms;
+        /// reference: -20 dBFS
+        standardK20,
+
+        /// K-System: reference -14 dBFS
+        standardK14,
+
+        /// K-System: reference -12 dBFS
+        standardK12,
+
+        numberOfStandards
+    };
+
+    explicit MeterBallistics(const double updateInterval);
+
+    int getStandard() const;
+    void setStandard(const int standard);
+
+    double getUpdateInterval() const;
+    int getCrestFactor() const;
+
+    static int getCrestFactor(const int standard);
+
+    /// Update peak meter readout.  Peak levels at or above full scale
+    /// are shown as full scale.
+    ///
+    /// @param level current peak level in decibels
+    ///
+    /// @param readout old peak meter readout in decibels (will be
+    ///        overwritten!)
+    ///
+    inline void peak(const double level,
+                     double &readout) const
+    {
+        // limit peak level to top mark
+        if (level >= 0.0)
+        {
+            readout = 0.0;
+        }
+        // immediate rise time
+        else if (level >= readout)
+        {
+            readout = level;
+        }
+        // linear fall time (meter doesn't fall below current level)
+        else
+        {
+            readout = jmax(readout - peakFallPerUpdate_, level);
+        }
+    }
+
+
+    /// Update average meter readout.
+    ///
+    /// @param level current average level in decibels
+    ///
+    /// @param readout old average meter readout in decibels (will be
+    ///        overwritten!)
+    ///
+    inline void average(const double level,
+                        double &readout) const
+    {
+        readout = averageCoefficient_ * (readout - level) + level;
+    }
+
+private:
+    JUCE_LEAK_DETECTOR(MeterBallistics);
+
+    double updateInterval_;
+    int standard_;
+
+    // coefficients of current standard
+    double peakFallPerUpdate_;
+    double averageCoefficient_;
+
+    // coefficients of all standards for the update interval
+    double peakFallsPerUpdate_[numberOfStandards];
+    double averageCoefficients_[numberOfStandards];
+};
+
+}
+}
+
+#endif  // FRUT_DSP_METER_BALLISTICS_H
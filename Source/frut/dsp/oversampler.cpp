@@ -0,0 +1,727 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define FRUT_DSP_OVERSAMPLER_SSE2 1
+#endif
+
+
+namespace frut
+{
+namespace dsp
+{
+
+// non-zero odd coefficients of each stage's half-band filter (the
+// filter has "2 * n - 1" taps); later stages see a much wider
+// transition band and get away with shorter filters
+static const int oversamplerStageCoefficients[] = {32, 12, 8};
+
+// Kaiser window; pass band is flat to 0.0005 dB up to 0.4 times the
+// original sample rate, aliases are attenuated by more than 80 dB
+static const double oversamplerKaiserBeta = 9.0;
+
+
+// zeroth-order modified Bessel function of the first kind
+static double besselI0(
+    const double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+
+    for (int k = 1; k < 50; ++k)
+    {
+        double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+
+        if (term < sum * 1e-17)
+        {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+
+// FIR filter: "output[n] = sum(coefficients[i] * input[n - i])"; the
+// input must be preceded by "numberOfCoefficients - 1" samples of
+// history.  Vectors hold neighbouring output samples, so all code
+// paths add the products in the same order.  Four vectors are
+// processed at once to hide the latency of the additions.
+static void convolve(
+    const float *input,
+    const float *coefficients,
+    const int numberOfCoefficients,
+    float *output,
+    const int numberOfSamples)
+{
+    int n = 0;
+
+#if defined(__AVX2__)
+
+    for (; n <= numberOfSamples - 32; n += 32)
+    {
+        __m256 c = _mm256_set1_ps(coefficients[0]);
+
+        __m256 sum_0 = _mm256_mul_ps(c, _mm256_loadu_ps(input + n));
+        __m256 sum_1 = _mm256_mul_ps(c, _mm256_loadu_ps(input + n + 8));
+        __m256 sum_2 = _mm256_mul_ps(c, _mm256_loadu_ps(input + n + 16));
+        __m256 sum_3 = _mm256_mul_ps(c, _mm256_loadu_ps(input + n + 24));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            const float *x = input + n - i;
+            c = _mm256_set1_ps(coefficients[i]);
+
+            sum_0 = _mm256_add_ps(sum_0, _mm256_mul_ps(c, _mm256_loadu_ps(x)));
+            sum_1 = _mm256_add_ps(sum_1, _mm256_mul_ps(c, _mm256_loadu_ps(x + 8)));
+            sum_2 = _mm256_add_ps(sum_2, _mm256_mul_ps(c, _mm256_loadu_ps(x + 16)));
+            sum_3 = _mm256_add_ps(sum_3, _mm256_mul_ps(c, _mm256_loadu_ps(x + 24)));
+        }
+
+        _mm256_storeu_ps(output + n, sum_0);
+        _mm256_storeu_ps(output + n + 8, sum_1);
+        _mm256_storeu_ps(output + n + 16, sum_2);
+        _mm256_storeu_ps(output + n + 24, sum_3);
+    }
+
+    for (; n <= numberOfSamples - 8; n += 8)
+    {
+        __m256 sum = _mm256_mul_ps(_mm256_set1_ps(coefficients[0]),
+                                   _mm256_loadu_ps(input + n));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(coefficients[i]),
+                                                   _mm256_loadu_ps(input + n - i)));
+        }
+
+        _mm256_storeu_ps(output + n, sum);
+    }
+
+#elif defined(FRUT_DSP_OVERSAMPLER_SSE2)
+
+    for (; n <= numberOfSamples - 16; n += 16)
+    {
+        __m128 c = _mm_set1_ps(coefficients[0]);
+
+        __m128 sum_0 = _mm_mul_ps(c, _mm_loadu_ps(input + n));
+        __m128 sum_1 = _mm_mul_ps(c, _mm_loadu_ps(input + n + 4));
+        __m128 sum_2 = _mm_mul_ps(c, _mm_loadu_ps(input + n + 8));
+        __m128 sum_3 = _mm_mul_ps(c, _mm_loadu_ps(input + n + 12));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            const float *x = input + n - i;
+            c = _mm_set1_ps(coefficients[i]);
+
+            sum_0 = _mm_add_ps(sum_0, _mm_mul_ps(c, _mm_loadu_ps(x)));
+            sum_1 = _mm_add_ps(sum_1, _mm_mul_ps(c, _mm_loadu_ps(x + 4)));
+            sum_2 = _mm_add_ps(sum_2, _mm_mul_ps(c, _mm_loadu_ps(x + 8)));
+            sum_3 = _mm_add_ps(sum_3, _mm_mul_ps(c, _mm_loadu_ps(x + 12)));
+        }
+
+        _mm_storeu_ps(output + n, sum_0);
+        _mm_storeu_ps(output + n + 4, sum_1);
+        _mm_storeu_ps(output + n + 8, sum_2);
+        _mm_storeu_ps(output + n + 12, sum_3);
+    }
+
+    for (; n <= numberOfSamples - 4; n += 4)
+    {
+        __m128 sum = _mm_mul_ps(_mm_set1_ps(coefficients[0]),
+                                _mm_loadu_ps(input + n));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(coefficients[i]),
+                                             _mm_loadu_ps(input + n - i)));
+        }
+
+        _mm_storeu_ps(output + n, sum);
+    }
+
+#endif
+
+    for (; n < numberOfSamples; ++n)
+    {
+        float sum = coefficients[0] * input[n];
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            sum += coefficients[i] * input[n - i];
+        }
+
+        output[n] = sum;
+    }
+}
+
+
+static void convolve(
+    const double *input,
+    const double *coefficients,
+    const int numberOfCoefficients,
+    double *output,
+    const int numberOfSamples)
+{
+    int n = 0;
+
+#if defined(__AVX2__)
+
+    for (; n <= numberOfSamples - 16; n += 16)
+    {
+        __m256d c = _mm256_set1_pd(coefficients[0]);
+
+        __m256d sum_0 = _mm256_mul_pd(c, _mm256_loadu_pd(input + n));
+        __m256d sum_1 = _mm256_mul_pd(c, _mm256_loadu_pd(input + n + 4));
+        __m256d sum_2 = _mm256_mul_pd(c, _mm256_loadu_pd(input + n + 8));
+        __m256d sum_3 = _mm256_mul_pd(c, _mm256_loadu_pd(input + n + 12));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            const double *x = input + n - i;
+            c = _mm256_set1_pd(coefficients[i]);
+
+            sum_0 = _mm256_add_pd(sum_0, _mm256_mul_pd(c, _mm256_loadu_pd(x)));
+            sum_1 = _mm256_add_pd(sum_1, _mm256_mul_pd(c, _mm256_loadu_pd(x + 4)));
+            sum_2 = _mm256_add_pd(sum_2, _mm256_mul_pd(c, _mm256_loadu_pd(x + 8)));
+            sum_3 = _mm256_add_pd(sum_3, _mm256_mul_pd(c, _mm256_loadu_pd(x + 12)));
+        }
+
+        _mm256_storeu_pd(output + n, sum_0);
+        _mm256_storeu_pd(output + n + 4, sum_1);
+        _mm256_storeu_pd(output + n + 8, sum_2);
+        _mm256_storeu_pd(output + n + 12, sum_3);
+    }
+
+    for (; n <= numberOfSamples - 4; n += 4)
+    {
+        __m256d sum = _mm256_mul_pd(_mm256_set1_pd(coefficients[0]),
+                                    _mm256_loadu_pd(input + n));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(coefficients[i]),
+                                                   _mm256_loadu_pd(input + n - i)));
+        }
+
+        _mm256_storeu_pd(output + n, sum);
+    }
+
+#elif defined(FRUT_DSP_OVERSAMPLER_SSE2)
+
+    for (; n <= numberOfSamples - 8; n += 8)
+    {
+        __m128d c = _mm_set1_pd(coefficients[0]);
+
+        __m128d sum_0 = _mm_mul_pd(c, _mm_loadu_pd(input + n));
+        __m128d sum_1 = _mm_mul_pd(c, _mm_loadu_pd(input + n + 2));
+        __m128d sum_2 = _mm_mul_pd(c, _mm_loadu_pd(input + n + 4));
+        __m128d sum_3 = _mm_mul_pd(c, _mm_loadu_pd(input + n + 6));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            const double *x = input + n - i;
+            c = _mm_set1_pd(coefficients[i]);
+
+            sum_0 = _mm_add_pd(sum_0, _mm_mul_pd(c, _mm_loadu_pd(x)));
+            sum_1 = _mm_add_pd(sum_1, _mm_mul_pd(c, _mm_loadu_pd(x + 2)));
+            sum_2 = _mm_add_pd(sum_2, _mm_mul_pd(c, _mm_loadu_pd(x + 4)));
+            sum_3 = _mm_add_pd(sum_3, _mm_mul_pd(c, _mm_loadu_pd(x + 6)));
+        }
+
+        _mm_storeu_pd(output + n, sum_0);
+        _mm_storeu_pd(output + n + 2, sum_1);
+        _mm_storeu_pd(output + n + 4, sum_2);
+        _mm_storeu_pd(output + n + 6, sum_3);
+    }
+
+    for (; n <= numberOfSamples - 2; n += 2)
+    {
+        __m128d sum = _mm_mul_pd(_mm_set1_pd(coefficients[0]),
+                                 _mm_loadu_pd(input + n));
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(coefficients[i]),
+                                             _mm_loadu_pd(input + n - i)));
+        }
+
+        _mm_storeu_pd(output + n, sum);
+    }
+
+#endif
+
+    for (; n < numberOfSamples; ++n)
+    {
+        double sum = coefficients[0] * input[n];
+
+        for (int i = 1; i < numberOfCoefficients; ++i)
+        {
+            sum += coefficients[i] * input[n - i];
+        }
+
+        output[n] = sum;
+    }
+}
+
+
+/// Create a new 2x stage.
+///
+/// @param numberOfChannels number of audio channels
+///
+/// @param numberOfCoefficients number of non-zero odd coefficients
+///        of the half-band filter (must be even)
+///
+/// @param maximumBlockSize maximum number of samples per block (at
+///        the lower sample rate)
+///
+template <typename Type>
+Oversampler<Type>::HalfBandStage::HalfBandStage(
+    const int numberOfChannels,
+    const int numberOfCoefficients,
+    const int maximumBlockSize) :
+
+    numberOfCoefficients_(numberOfCoefficients),
+    evenHistoryLength_(numberOfCoefficients - 1),
+    oddHistoryLength_(numberOfCoefficients / 2),
+    upsamplerHistory_(numberOfChannels,
+                      evenHistoryLength_ + maximumBlockSize),
+    upsamplerEvenSamples_(1, maximumBlockSize),
+    downsamplerEvenHistory_(numberOfChannels,
+                            evenHistoryLength_ + maximumBlockSize),
+    downsamplerOddHistory_(numberOfChannels,
+                           oddHistoryLength_ + maximumBlockSize)
+{
+    jassert(numberOfCoefficients_ % 2 == 0);
+
+    upsamplerCoefficients_.malloc(numberOfCoefficients_);
+    downsamplerCoefficients_.malloc(numberOfCoefficients_);
+
+    // calculate Kaiser-windowed sinc; the centre tap lies between
+    // the two middle coefficients
+    int centre = numberOfCoefficients_ - 1;
+    double windowNormalisation = besselI0(oversamplerKaiserBeta);
+    double coefficientSum = 0.0;
+
+    for (int i = 0; i < numberOfCoefficients_; ++i)
+    {
+        // distance to centre tap (always odd)
+        int distance = 2 * i - centre;
+        double position = double(distance) / double(centre);
+
+        double sinc = sin(M_PI * distance / 2.0) / (M_PI * distance);
+        double window = besselI0(oversamplerKaiserBeta * sqrt(1.0 - position * position)) / windowNormalisation;
+
+        downsamplerCoefficients_[i] = static_cast<Type>(sinc * window);
+        coefficientSum += sinc * window;
+    }
+
+    // normalise filter kernel for unity gain at DC (the centre tap
+    // contributes one half); the up-sampler's gain is doubled to make
+    // up for the zeros that are stuffed between the input samples
+    for (int i = 0; i < numberOfCoefficients_; ++i)
+    {
+        double coefficient = 0.5 * downsamplerCoefficients_[i] / coefficientSum;
+
+        upsamplerCoefficients_[i] = static_cast<Type>(2.0 * coefficient);
+        downsamplerCoefficients_[i] = static_cast<Type>(coefficient);
+    }
+
+    reset();
+}
+
+
+template <typename Type>
+void Oversampler<Type>::HalfBandStage::reset()
+{
+    upsamplerHistory_.clear();
+    downsamplerEvenHistory_.clear();
+    downsamplerOddHistory_.clear();
+}
+
+
+/// Double the sample rate of a block.
+///
+/// @param channel audio channel
+///
+/// @param input input samples
+///
+/// @param output receives "2 * numberOfSamples" output samples
+///        (must not overlap input)
+///
+/// @param numberOfSamples number of input samples
+///
+template <typename Type>
+void Oversampler<Type>::HalfBandStage::upsample(
+    const int channel,
+    const Type *input,
+    Type *output,
+    const int numberOfSamples)
+{
+    Type *history = upsamplerHistory_.getWritePointer(channel);
+    Type *evenSamples = upsamplerEvenSamples_.getWritePointer(0);
+
+    // append input to history, so that each coefficient can be
+    // applied to a contiguous block of samples
+    FloatVectorOperations::copy(history + evenHistoryLength_,
+                                input, numberOfSamples);
+
+    const Type *current = history + evenHistoryLength_;
+
+    // first branch holds the non-zero odd coefficients
+    convolve(current, upsamplerCoefficients_, numberOfCoefficients_,
+             evenSamples, numberOfSamples);
+
+    // second branch only holds the centre tap, which delays the
+    // input
+    const Type *delayed = current - (oddHistoryLength_ - 1);
+
+    for (int sample = 0; sample < numberOfSamples; ++sample)
+    {
+        output[2 * sample] = evenSamples[sample];
+        output[2 * sample + 1] = delayed[sample];
+    }
+
+    // keep latest input samples for next block
+    memmove(history, history + numberOfSamples,
+            evenHistoryLength_ * sizeof(Type));
+}
+
+
+/// Halve the sample rate of a block.
+///
+/// @param channel audio channel
+///
+/// @param input "2 * numberOfSamples" input samples
+///
+/// @param output receives output samples (must not overlap input)
+///
+/// @param numberOfSamples number of output samples
+///
+template <typename Type>
+void Oversampler<Type>::HalfBandStage::downsample(
+    const int channel,
+    const Type *input,
+    Type *output,
+    const int numberOfSamples)
+{
+    Type *evenHistory = downsamplerEvenHistory_.getWritePointer(channel);
+    Type *oddHistory = downsamplerOddHistory_.getWritePointer(channel);
+
+    // split input into polyphase branches
+    for (int sample = 0; sample < numberOfSamples; ++sample)
+    {
+        evenHistory[evenHistoryLength_ + sample] = input[2 * sample];
+        oddHistory[oddHistoryLength_ + sample] = input[2 * sample + 1];
+    }
+
+    // non-zero odd coefficients (even input samples)
+    convolve(evenHistory + evenHistoryLength_,
+             downsamplerCoefficients_, numberOfCoefficients_,
+             output, numberOfSamples);
+
+    // centre tap (odd input samples)
+    for (int sample = 0; sample < numberOfSamples; ++sample)
+    {
+        output[sample] += Type(0.5) * oddHistory[sample];
+    }
+
+    // keep latest input samples for next block
+    memmove(evenHistory, evenHistory + numberOfSamples,
+            evenHistoryLength_ * sizeof(Type));
+    memmove(oddHistory, oddHistory + numberOfSamples,
+            oddHistoryLength_ * sizeof(Type));
+}
+
+
+/// Create a new oversampler.
+///
+/// @param numberOfChannels number of audio channels
+///
+/// @param oversamplingFactor oversampling factor (2, 4 or 8)
+///
+/// @param maximumBlockSize maximum number of samples per block (at
+///        the original sample rate)
+///
+template <typename Type>
+Oversampler<Type>::Oversampler(
+    const int numberOfChannels,
+    const int oversamplingFactor,
+    const int maximumBlockSize) :
+
+    numberOfChannels_(numberOfChannels),
+    oversamplingFactor_(oversamplingFactor),
+    maximumBlockSize_(maximumBlockSize),
+    numberOfStages_(getNumberOfStages(oversamplingFactor))
+{
+    jassert(numberOfChannels_ > 0);
+    jassert(isValidOversamplingFactor(oversamplingFactor_));
+    jassert(maximumBlockSize_ > 0);
+
+    int stageBlockSize = maximumBlockSize_;
+
+    for (int stage = 0; stage < numberOfStages_; ++stage)
+    {
+        stages_.add(new HalfBandStage(numberOfChannels_,
+                                      oversamplerStageCoefficients[stage],
+                                      stageBlockSize));
+
+        stageBlockSize *= 2;
+    }
+
+    intermediateSamples_.setSize(jmax(1, numberOfStages_ - 1),
+                                 maximumBlockSize_ * oversamplingFactor_ / 2);
+
+    int stageLatency = calculateStageLatency(oversamplingFactor_);
+
+    paddingSamples_ = (oversamplingFactor_ - stageLatency % oversamplingFactor_) %
+                      oversamplingFactor_;
+    latencySamples_ = (stageLatency + paddingSamples_) / oversamplingFactor_;
+
+    paddingDelay_.setSize(numberOfChannels_,
+                          paddingSamples_ + maximumBlockSize_ * oversamplingFactor_);
+
+    reset();
+}
+
+
+template <typename Type>
+void Oversampler<Type>::reset()
+{
+    for (int stage = 0; stage < numberOfStages_; ++stage)
+    {
+        stages_[stage]->reset();
+    }
+
+    paddingDelay_.clear();
+}
+
+
+template <typename Type>
+int Oversampler<Type>::getNumberOfChannels() const
+{
+    return numberOfChannels_;
+}
+
+
+template <typename Type>
+int Oversampler<Type>::getOversamplingFactor() const
+{
+    return oversamplingFactor_;
+}
+
+
+/// Get latency of up-sampling followed by down-sampling.
+///
+/// @return latency in samples (at the original sample rate)
+///
+template <typename Type>
+int Oversampler<Type>::getLatencySamples() const
+{
+    return latencySamples_;
+}
+
+
+template <typename Type>
+bool Oversampler<Type>::isValidOversamplingFactor(
+    const int oversamplingFactor)
+{
+    return (oversamplingFactor == 2) ||
+           (oversamplingFactor == 4) ||
+           (oversamplingFactor == 8);
+}
+
+
+/// Calculate latency of up-sampling followed by down-sampling
+/// without creating an oversampler.
+///
+/// @param oversamplingFactor oversampling factor (1 disables
+///        oversampling)
+///
+/// @return latency in samples (at the original sample rate)
+///
+template <typename Type>
+int Oversampler<Type>::calculateLatencySamples(
+    const int oversamplingFactor)
+{
+    if (!isValidOversamplingFactor(oversamplingFactor))
+    {
+        return 0;
+    }
+
+    // round up to whole samples (see paddingDelay_)
+    int stageLatency = calculateStageLatency(oversamplingFactor);
+
+    return (stageLatency + oversamplingFactor - 1) / oversamplingFactor;
+}
+
+
+template <typename Type>
+int Oversampler<Type>::getNumberOfStages(
+    const int oversamplingFactor)
+{
+    int numberOfStages = 0;
+
+    while ((1 << numberOfStages) < oversamplingFactor)
+    {
+        ++numberOfStages;
+    }
+
+    return numberOfStages;
+}
+
+
+// latency of all stages in samples of the highest sample rate
+template <typename Type>
+int Oversampler<Type>::calculateStageLatency(
+    const int oversamplingFactor)
+{
+    int numberOfStages = getNumberOfStages(oversamplingFactor);
+    int stageLatency = 0;
+
+    for (int stage = 0; stage < numberOfStages; ++stage)
+    {
+        // up-sampling and down-sampling both delay by the filter's
+        // centre tap (at twice the stage's input rate)
+        int centreTap = oversamplerStageCoefficients[stage] - 1;
+        int rateRatio = 1 << (numberOfStages - stage - 1);
+
+        stageLatency += 2 * centreTap * rateRatio;
+    }
+
+    return stageLatency;
+}
+
+
+/// Up-sample a block.
+///
+/// @param channel audio channel
+///
+/// @param input input samples
+///
+/// @param output receives "numberOfSamples * oversamplingFactor"
+///        output samples (must not overlap input)
+///
+/// @param numberOfSamples number of input samples
+///
+template <typename Type>
+void Oversampler<Type>::upsample(
+    const int channel,
+    const Type *input,
+    Type *output,
+    const int numberOfSamples)
+{
+    jassert(isPositiveAndBelow(channel, numberOfChannels_));
+    jassert(isPositiveAndNotGreaterThan(numberOfSamples, maximumBlockSize_));
+
+    const Type *stageInput = input;
+    int stageSamples = numberOfSamples;
+
+    for (int stage = 0; stage < numberOfStages_; ++stage)
+    {
+        Type *stageOutput = output;
+
+        if (stage < numberOfStages_ - 1)
+        {
+            stageOutput = intermediateSamples_.getWritePointer(stage);
+        }
+
+        stages_[stage]->upsample(channel, stageInput, stageOutput,
+                                 stageSamples);
+
+        stageInput = stageOutput;
+        stageSamples *= 2;
+    }
+}
+
+
+/// Down-sample a block.
+///
+/// @param channel audio channel
+///
+/// @param input "numberOfSamples * oversamplingFactor" input samples
+///
+/// @param output receives output samples (must not overlap input)
+///
+/// @param numberOfSamples number of output samples
+///
+template <typename Type>
+void Oversampler<Type>::downsample(
+    const int channel,
+    const Type *input,
+    Type *output,
+    const int numberOfSamples)
+{
+    jassert(isPositiveAndBelow(channel, numberOfChannels_));
+    jassert(isPositiveAndNotGreaterThan(numberOfSamples, maximumBlockSize_));
+
+    const Type *stageInput = input;
+    int stageSamples = numberOfSamples * oversamplingFactor_;
+
+    Type *padding = paddingDelay_.getWritePointer(channel);
+
+    if (paddingSamples_ > 0)
+    {
+        FloatVectorOperations::copy(padding + paddingSamples_,
+                                    input, stageSamples);
+
+        stageInput = padding;
+    }
+
+    for (int stage = numberOfStages_ - 1; stage >= 0; --stage)
+    {
+        stageSamples /= 2;
+        Type *stageOutput = output;
+
+        if (stage > 0)
+        {
+            stageOutput = intermediateSamples_.getWritePointer(stage - 1);
+        }
+
+        stages_[stage]->downsample(channel, stageInput, stageOutput,
+                                   stageSamples);
+
+        stageInput = stageOutput;
+    }
+
+    if (paddingSamples_ > 0)
+    {
+        memmove(padding, padding + numberOfSamples * oversamplingFactor_,
+                paddingSamples_ * sizeof(Type));
+    }
+}
+
+
+// explicit instantiation of all template instances
+template class Oversampler<float>;
+template class Oversampler<double>;
+
+}
+}
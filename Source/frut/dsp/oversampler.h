@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_DSP_OVERSAMPLER_H
+#define FRUT_DSP_OVERSAMPLER_H
+
+namespace frut
+{
+namespace dsp
+{
+
+/// Polyphase half-band oversampler.  Over-samples by a factor of 2,
+/// 4 or 8 by cascading 2x stages.  Each stage is a linear-phase
+/// half-band FIR filter; all but one of its odd coefficients are
+/// zero, so the filter is split into two polyphase branches and only
+/// the non-zero coefficients are evaluated.  Filters process whole
+/// blocks using SIMD instructions (SSE2 or AVX2, if available).
+///
+/// Up-sampling followed by down-sampling delays the signal by a
+/// whole number of samples (see getLatencySamples()), so the result
+/// can be mixed with a delayed copy of the input.
+///
+template <typename Type>
+class Oversampler
+{
+public:
+    Oversampler(const int numberOfChannels,
+                const int oversamplingFactor,
+                const int maximumBlockSize);
+
+    void reset();
+
+    int getNumberOfChannels() const;
+    int getOversamplingFactor() const;
+    int getLatencySamples() const;
+
+    static bool isValidOversamplingFactor(const int oversamplingFactor);
+    static int calculateLatencySamples(const int oversamplingFactor);
+
+    void upsample(const int channel,
+                  const Type *input,
+                  Type *output,
+                  const int numberOfSamples);
+
+    void downsample(const int channel,
+                    const Type *input,
+                    Type *output,
+                    const int numberOfSamples);
+
+private:
+    JUCE_LEAK_DETECTOR(Oversampler);
+
+    /// Single 2x stage of the oversampler.
+    ///
+    class HalfBandStage
+    {
+    public:
+        HalfBandStage(const int numberOfChannels,
+                      const int numberOfCoefficients,
+                      const int maximumBlockSize);
+
+        void reset();
+
+        void upsample(const int channel,
+                      const Type *input,
+                      Type *output,
+                      const int numberOfSamples);
+
+        void downsample(const int channel,
+                        const Type *input,
+                        Type *output,
+                        const int numberOfSamples);
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(HalfBandStage);
+
+        int numberOfCoefficients_;
+        int evenHistoryLength_;
+        int oddHistoryLength_;
+
+        // non-zero odd coefficients of half-band filter (the centre
+        // coefficient is always 0.5)
+        HeapBlock<Type> upsamplerCoefficients_;
+        HeapBlock<Type> downsamplerCoefficients_;
+
+        AudioBuffer<Type> upsamplerHistory_;
+        AudioBuffer<Type> upsamplerEvenSamples_;
+
+        AudioBuffer<Type> downsamplerEvenHistory_;
+        AudioBuffer<Type> downsamplerOddHistory_;
+    };
+
+    static int getNumberOfStages(const int oversamplingFactor);
+    static int calculateStageLatency(const int oversamplingFactor);
+
+    int numberOfChannels_;
+    int oversamplingFactor_;
+    int maximumBlockSize_;
+    int numberOfStages_;
+    int paddingSamples_;
+    int latencySamples_;
+
+    OwnedArray<HalfBandStage> stages_;
+
+    // output of all but the last stage (one channel per stage)
+    AudioBuffer<Type> intermediateSamples_;
+
+    // pads latency of all stages to whole samples of the original
+    // sample rate
+    AudioBuffer<Type> paddingDelay_;
+};
+
+}
+}
+
+#endif  // FRUT_DSP_OVERSAMPLER_H
@@ -35,20 +35,49 @@ RateConverter::RateConverter(
     const int originalFftBufferSize,
     const int upsamplingFactor) :
 
-    // FIXME: improve efficiency of rate conversion
     frut::dsp::FIRFilterBox(
         numberOfChannels, upsamplingFactor * originalFftBufferSize),
     upsamplingFactor_(upsamplingFactor),
     originalFftBufferSize_(originalFftBufferSize),
-    sampleBufferOriginal_(numberOfChannels_, originalFftBufferSize_)
+    sampleBufferOriginal_(numberOfChannels_, originalFftBufferSize_),
+    phaseFftSize_(originalFftBufferSize_ * 2),
+    phaseHalfFftSizePlusOne_(phaseFftSize_ / 2 + 1)
 
 {
+    jassert(upsamplingFactor_ > 0);
+
+    phaseKernels_FD_ = fftwf_alloc_complex(
+                           upsamplingFactor_ * phaseHalfFftSizePlusOne_);
+
+    phaseSamples_TD_ = fftwf_alloc_real(phaseFftSize_);
+    phaseSamples_FD_ = fftwf_alloc_complex(phaseHalfFftSizePlusOne_);
+
+    phaseSamplesPlan_DFT_ = fftwf_plan_dft_r2c_1d(
+                                phaseFftSize_, phaseSamples_TD_, phaseSamples_FD_,
+                                FFTW_MEASURE);
+
+    phaseOutput_TD_ = fftwf_alloc_real(phaseFftSize_);
+    phaseOutput_FD_ = fftwf_alloc_complex(phaseHalfFftSizePlusOne_);
+
+    phaseOutputPlan_IDFT_ = fftwf_plan_dft_c2r_1d(
+                                phaseFftSize_, phaseOutput_FD_, phaseOutput_TD_,
+                                FFTW_MEASURE);
+
     calculateFilterKernel();
 }
 
 
 RateConverter::~RateConverter()
 {
+    fftwf_destroy_plan(phaseSamplesPlan_DFT_);
+    fftwf_free(phaseSamples_TD_);
+    fftwf_free(phaseSamples_FD_);
+
+    fftwf_destroy_plan(phaseOutputPlan_IDFT_);
+    fftwf_free(phaseOutput_TD_);
+    fftwf_free(phaseOutput_FD_);
+
+    fftwf_free(phaseKernels_FD_);
 }
 
 
@@ -74,33 +103,106 @@ void RateConverter::calculateFilterKernel()
     double relativeCutoffFrequency = 0.5 / upsamplingFactor_;
 
     calculateKernelWindowedSincLPF(relativeCutoffFrequency);
-}
-
 
-void RateConverter::upsample()
-{
-    // upsample input sample buffer by clearing it and filling every
-    // "upsamplingFactor_" sample with the original sample values
-    fftSampleBuffer_.clear();
+    // split filter kernel into its polyphase components; the kernel
+    // has "upsamplingFactor_ * originalFftBufferSize_ + 1" samples,
+    // so every phase fits into the smaller FFT without wrapping
+    // around
+    int kernelSize = fftBufferSize_ + 1;
 
-    for (int channel = 0; channel < numberOfChannels_; ++channel)
+    for (int phase = 0; phase < upsamplingFactor_; ++phase)
     {
-        int sampleUpsampled = 0;
+        int sample = 0;
 
-        for (int sample = 0; sample < originalFftBufferSize_; ++sample)
+        for (int i = phase; i < kernelSize; i += upsamplingFactor_)
         {
-            fftSampleBuffer_.copyFrom(
-                channel, sampleUpsampled, sampleBufferOriginal_,
-                channel, sample, 1);
+            phaseSamples_TD_[sample] = filterKernel_TD_[i];
+            ++sample;
+        }
 
-            sampleUpsampled += upsamplingFactor_;
+        // pad phase with zeros
+        for (; sample < phaseFftSize_; ++sample)
+        {
+            phaseSamples_TD_[sample] = 0.0f;
         }
+
+        // calculate DFT of phase
+        fftwf_execute(phaseSamplesPlan_DFT_);
+
+        memcpy(phaseKernels_FD_ + phase * phaseHalfFftSizePlusOne_,
+               phaseSamples_FD_,
+               phaseHalfFftSizePlusOne_ * sizeof(fftwf_complex));
     }
+}
+
+
+void RateConverter::upsample()
+{
+    // polyphase interpolation: instead of filling every
+    // "upsamplingFactor_" sample of a large buffer and filtering
+    // mostly zeros, convolve the original samples with every phase
+    // of the filter kernel and interleave the results
+    //
+    // normalise synthesised audio data (upsampling reduces the gain
+    // by "upsamplingFactor_")
+    float normaliser = float(phaseFftSize_) / float(upsamplingFactor_);
 
-    // filter audio data (overwrites contents of sample buffer)
     for (int channel = 0; channel < numberOfChannels_; ++channel)
     {
-        convolveWithKernel(channel, static_cast<float>(upsamplingFactor_));
+        // copy audio data to temporary buffer as the sample buffer is
+        // not optimised for MME
+        memcpy(phaseSamples_TD_,
+               sampleBufferOriginal_.getReadPointer(channel),
+               originalFftBufferSize_ * sizeof(float));
+
+        // pad audio data with zeros
+        for (int sample = originalFftBufferSize_; sample < phaseFftSize_; ++sample)
+        {
+            phaseSamples_TD_[sample] = 0.0f;
+        }
+
+        // calculate DFT of audio data (once for all phases)
+        fftwf_execute(phaseSamplesPlan_DFT_);
+
+        float *outputSamples = fftSampleBuffer_.getWritePointer(channel);
+        float *overlapSamples = fftOverlapAddSamples_.getWritePointer(channel);
+
+        for (int phase = 0; phase < upsamplingFactor_; ++phase)
+        {
+            const fftwf_complex *phaseKernel =
+                phaseKernels_FD_ + phase * phaseHalfFftSizePlusOne_;
+
+            // convolve audio data with phase of filter kernel
+            for (int i = 0; i < phaseHalfFftSizePlusOne_; ++i)
+            {
+                // multiplication of complex numbers: index 0 contains
+                // the real part, index 1 the imaginary part
+                phaseOutput_FD_[i][0] = phaseSamples_FD_[i][0] * phaseKernel[i][0] -
+                                        phaseSamples_FD_[i][1] * phaseKernel[i][1];
+                phaseOutput_FD_[i][1] = phaseSamples_FD_[i][1] * phaseKernel[i][0] +
+                                        phaseSamples_FD_[i][0] * phaseKernel[i][1];
+            }
+
+            // synthesise audio data from frequency spectrum (this
+            // destroys the contents of "phaseOutput_FD_"!!!)
+            fftwf_execute(phaseOutputPlan_IDFT_);
+
+            // interleave phase with the other phases, add old
+            // overlapping samples and store new overlapping samples
+            int sampleUpsampled = phase;
+
+            for (int sample = 0; sample < originalFftBufferSize_; ++sample)
+            {
+                outputSamples[sampleUpsampled] =
+                    phaseOutput_TD_[sample] / normaliser +
+                    overlapSamples[sampleUpsampled];
+
+                overlapSamples[sampleUpsampled] =
+                    phaseOutput_TD_[originalFftBufferSize_ + sample] / normaliser;
+
+                sampleUpsampled += upsamplingFactor_;
+            }
+        }
     }
 }
 
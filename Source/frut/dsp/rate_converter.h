@@ -54,6 +54,22 @@ protected:
 
     AudioBuffer<float> sampleBufferOriginal_;
 
+    // polyphase decomposition of filter kernel; every phase is
+    // convolved with the original (not zero-stuffed) samples, so the
+    // FFT is "upsamplingFactor_" times smaller
+    int phaseFftSize_;
+    int phaseHalfFftSizePlusOne_;
+
+    fftwf_complex *phaseKernels_FD_;
+
+    float *phaseSamples_TD_;
+    fftwf_complex *phaseSamples_FD_;
+    fftwf_plan phaseSamplesPlan_DFT_;
+
+    float *phaseOutput_TD_;
+    fftwf_complex *phaseOutput_FD_;
+    fftwf_plan phaseOutputPlan_IDFT_;
+
 private:
     JUCE_LEAK_DETECTOR(RateConverter);
 };
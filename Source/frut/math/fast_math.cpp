@@ -0,0 +1,679 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define FRUT_MATH_FAST_MATH_SSE2 1
+#endif
+
+
+namespace frut
+{
+namespace math
+{
+
+// all approximations split their input into an exponent and a
+// mantissa; only the mantissa is approximated by a polynomial
+namespace
+{
+const double log10_of_2 = 0.30102999566398119521;
+const double log10_of_e = 0.43429448190325182765;
+const double log2_of_10 = 3.32192809488736234787;
+const double ln_of_2 = 0.69314718055994530942;
+const double sqrt_of_half = 0.70710678118654752440;
+
+// adding and subtracting this value rounds a double to the nearest
+// integer, which is then found in the lower bits of the mantissa
+// (vectorised code only; x87 extended precision breaks this trick)
+const double round_magic = 6755399441055744.0;  // 1.5 * 2^52
+
+// or-ing an 11-bit integer into the mantissa of this value and
+// subtracting it again converts the integer to double (vectorised
+// code only)
+const double exponent_magic = 4503599627370496.0;  // 2^52
+
+const uint64 mask_absolute = 0x7FFFFFFFFFFFFFFFULL;
+const uint64 mask_mantissa = 0x000FFFFFFFFFFFFFULL;
+const uint64 bits_half = 0x3FE0000000000000ULL;
+const uint64 bits_exponent_magic = 0x4330000000000000ULL;
+const uint64 exponent_bias = 1023;
+
+// series expansion of ln((1 + s) / (1 - s)) / 2s in powers of s^2;
+// |s| <= 0.1716, so the truncation error is below 5e-13
+const double log_c1 = 1.0 / 3.0;
+const double log_c2 = 1.0 / 5.0;
+const double log_c3 = 1.0 / 7.0;
+const double log_c4 = 1.0 / 9.0;
+const double log_c5 = 1.0 / 11.0;
+const double log_c6 = 1.0 / 13.0;
+
+// Taylor series of exp(t); |t| <= ln(2) / 2, so the truncation
+// error is below 1e-14
+const double exp_c2 = 1.0 / 2.0;
+const double exp_c3 = 1.0 / 6.0;
+const double exp_c4 = 1.0 / 24.0;
+const double exp_c5 = 1.0 / 120.0;
+const double exp_c6 = 1.0 / 720.0;
+const double exp_c7 = 1.0 / 5040.0;
+const double exp_c8 = 1.0 / 40320.0;
+const double exp_c9 = 1.0 / 362880.0;
+const double exp_c10 = 1.0 / 3628800.0;
+const double exp_c11 = 1.0 / 39916800.0;
+
+// exponents of 2 are limited so that results are normal numbers
+const double exp2_minimum = -1022.0;
+const double exp2_maximum = 1023.0;
+
+// single precision constants; the polynomials are shorter, but use
+// the same coefficients as above
+const uint32 mask_absolute_float = 0x7FFFFFFFU;
+const uint32 mask_mantissa_float = 0x007FFFFFU;
+const uint32 bits_half_float = 0x3F000000U;
+const int exponent_bias_float = 127;
+
+const float exp2_minimum_float = -126.0f;
+const float exp2_maximum_float = 127.0f;
+
+
+inline uint64 toBits(double x)
+{
+    uint64 bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+
+inline double fromBits(uint64 bits)
+{
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+
+inline uint32 toBits(float x)
+{
+    uint32 bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+
+inline float fromBits(uint32 bits)
+{
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+}
+
+
+double FastMath::log10(double x)
+{
+    uint64 bits = toBits(x) & mask_absolute;
+
+    // x = m * 2^e with 0.5 <= m < 1
+    double m = fromBits((bits & mask_mantissa) | bits_half);
+    double e = (double)((int64)(bits >> 52) - (int64) exponent_bias + 1);
+
+    // move mantissa to range [sqrt(0.5), sqrt(2)[
+    if (m < sqrt_of_half)
+    {
+        m += m;
+        e -= 1.0;
+    }
+
+    double s = (m - 1.0) / (m + 1.0);
+    double z = s * s;
+
+    double p = log_c5 + z * log_c6;
+    p = log_c4 + z * p;
+    p = log_c3 + z * p;
+    p = log_c2 + z * p;
+    p = log_c1 + z * p;
+    p = 1.0 + z * p;
+
+    double ln_m = (s + s) * p;
+
+    return e * log10_of_2 + ln_m * log10_of_e;
+}
+
+
+double FastMath::exp10(double x)
+{
+    // 10^x = 2^n * 2^f with integer n and |f| <= 0.5
+    double y = x * log2_of_10;
+    y = jlimit(exp2_minimum, exp2_maximum, y);
+
+    int64 n_integer = (int64) std::floor(y + 0.5);
+    double n = (double) n_integer;
+    double t = (y - n) * ln_of_2;
+
+    double p = exp_c10 + t * exp_c11;
+    p = exp_c9 + t * p;
+    p = exp_c8 + t * p;
+    p = exp_c7 + t * p;
+    p = exp_c6 + t * p;
+    p = exp_c5 + t * p;
+    p = exp_c4 + t * p;
+    p = exp_c3 + t * p;
+    p = exp_c2 + t * p;
+    p = 1.0 + t * p;
+    p = 1.0 + t * p;
+
+    double scale = fromBits((uint64)(n_integer + (int64) exponent_bias) << 52);
+
+    return p * scale;
+}
+
+
+float FastMath::log10(float x)
+{
+    uint32 bits = toBits(x) & mask_absolute_float;
+
+    // x = m * 2^e with 0.5 <= m < 1
+    float m = fromBits((bits & mask_mantissa_float) | bits_half_float);
+    float e = (float)((int)(bits >> 23) - exponent_bias_float + 1);
+
+    // move mantissa to range [sqrt(0.5), sqrt(2)[
+    if (m < (float) sqrt_of_half)
+    {
+        m += m;
+        e -= 1.0f;
+    }
+
+    float s = (m - 1.0f) / (m + 1.0f);
+    float z = s * s;
+
+    float p = (float) log_c3 + z * (float) log_c4;
+    p = (float) log_c2 + z * p;
+    p = (float) log_c1 + z * p;
+    p = 1.0f + z * p;
+
+    float ln_m = (s + s) * p;
+
+    return e * (float) log10_of_2 + ln_m * (float) log10_of_e;
+}
+
+
+float FastMath::exp10(float x)
+{
+    // 10^x = 2^n * 2^f with integer n and |f| <= 0.5
+    float y = x * (float) log2_of_10;
+    y = jlimit(exp2_minimum_float, exp2_maximum_float, y);
+
+    int n_integer = (int) std::floor(y + 0.5f);
+    float n = (float) n_integer;
+    float t = (y - n) * (float) ln_of_2;
+
+    float p = (float) exp_c6 + t * (float) exp_c7;
+    p = (float) exp_c5 + t * p;
+    p = (float) exp_c4 + t * p;
+    p = (float) exp_c3 + t * p;
+    p = (float) exp_c2 + t * p;
+    p = 1.0f + t * p;
+    p = 1.0f + t * p;
+
+    float scale = fromBits((uint32)(n_integer + exponent_bias_float) << 23);
+
+    return p * scale;
+}
+
+
+#if defined(__AVX2__)
+
+void FastMath::log10(const double *input,
+                     double *output,
+                     int number_of_values)
+{
+    const __m256d v_absolute = _mm256_castsi256_pd(_mm256_set1_epi64x((long long) mask_absolute));
+    const __m256d v_mantissa = _mm256_castsi256_pd(_mm256_set1_epi64x((long long) mask_mantissa));
+    const __m256d v_half = _mm256_castsi256_pd(_mm256_set1_epi64x((long long) bits_half));
+    const __m256i v_exponent_magic = _mm256_set1_epi64x((long long) bits_exponent_magic);
+    const __m256d v_exponent_offset = _mm256_set1_pd(exponent_magic + exponent_bias - 1.0);
+    const __m256d v_sqrt_of_half = _mm256_set1_pd(sqrt_of_half);
+    const __m256d v_one = _mm256_set1_pd(1.0);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 4; n += 4)
+    {
+        __m256d x = _mm256_and_pd(_mm256_loadu_pd(input + n), v_absolute);
+
+        __m256d m = _mm256_or_pd(_mm256_and_pd(x, v_mantissa), v_half);
+        __m256i e_bits = _mm256_or_si256(_mm256_srli_epi64(_mm256_castpd_si256(x), 52), v_exponent_magic);
+        __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(e_bits), v_exponent_offset);
+
+        __m256d below = _mm256_cmp_pd(m, v_sqrt_of_half, _CMP_LT_OQ);
+        m = _mm256_add_pd(m, _mm256_and_pd(m, below));
+        e = _mm256_sub_pd(e, _mm256_and_pd(v_one, below));
+
+        __m256d s = _mm256_div_pd(_mm256_sub_pd(m, v_one), _mm256_add_pd(m, v_one));
+        __m256d z = _mm256_mul_pd(s, s);
+
+        __m256d p = _mm256_add_pd(_mm256_set1_pd(log_c5), _mm256_mul_pd(z, _mm256_set1_pd(log_c6)));
+        p = _mm256_add_pd(_mm256_set1_pd(log_c4), _mm256_mul_pd(z, p));
+        p = _mm256_add_pd(_mm256_set1_pd(log_c3), _mm256_mul_pd(z, p));
+        p = _mm256_add_pd(_mm256_set1_pd(log_c2), _mm256_mul_pd(z, p));
+        p = _mm256_add_pd(_mm256_set1_pd(log_c1), _mm256_mul_pd(z, p));
+        p = _mm256_add_pd(v_one, _mm256_mul_pd(z, p));
+
+        __m256d ln_m = _mm256_mul_pd(_mm256_add_pd(s, s), p);
+
+        __m256d result = _mm256_add_pd(
+                             _mm256_mul_pd(e, _mm256_set1_pd(log10_of_2)),
+                             _mm256_mul_pd(ln_m, _mm256_set1_pd(log10_of_e)));
+
+        _mm256_storeu_pd(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = log10(input[n]);
+    }
+}
+
+
+void FastMath::exp10(const double *input,
+                     double *output,
+                     int number_of_values)
+{
+    const __m256d v_minimum = _mm256_set1_pd(exp2_minimum);
+    const __m256d v_maximum = _mm256_set1_pd(exp2_maximum);
+    const __m256d v_round_magic = _mm256_set1_pd(round_magic);
+    const __m256i v_exponent_bias = _mm256_set1_epi64x((long long) exponent_bias);
+    const __m256d v_one = _mm256_set1_pd(1.0);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 4; n += 4)
+    {
+        __m256d y = _mm256_mul_pd(_mm256_loadu_pd(input + n), _mm256_set1_pd(log2_of_10));
+        y = _mm256_min_pd(_mm256_max_pd(y, v_minimum), v_maximum);
+
+        __m256d n_magic = _mm256_add_pd(y, v_round_magic);
+        __m256d n_round = _mm256_sub_pd(n_magic, v_round_magic);
+        __m256d t = _mm256_mul_pd(_mm256_sub_pd(y, n_round), _mm256_set1_pd(ln_of_2));
+
+        __m256d p = _mm256_add_pd(_mm256_set1_pd(exp_c10), _mm256_mul_pd(t, _mm256_set1_pd(exp_c11)));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c9), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c8), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c7), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c6), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c5), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c4), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c3), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(_mm256_set1_pd(exp_c2), _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(v_one, _mm256_mul_pd(t, p));
+        p = _mm256_add_pd(v_one, _mm256_mul_pd(t, p));
+
+        __m256i scale_bits = _mm256_slli_epi64(
+                                 _mm256_add_epi64(_mm256_castpd_si256(n_magic), v_exponent_bias), 52);
+        __m256d result = _mm256_mul_pd(p, _mm256_castsi256_pd(scale_bits));
+
+        _mm256_storeu_pd(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = exp10(input[n]);
+    }
+}
+
+
+void FastMath::log10(const float *input,
+                     float *output,
+                     int number_of_values)
+{
+    const __m256 v_absolute = _mm256_castsi256_ps(_mm256_set1_epi32((int) mask_absolute_float));
+    const __m256 v_mantissa = _mm256_castsi256_ps(_mm256_set1_epi32((int) mask_mantissa_float));
+    const __m256 v_half = _mm256_castsi256_ps(_mm256_set1_epi32((int) bits_half_float));
+    const __m256i v_exponent_offset = _mm256_set1_epi32(exponent_bias_float - 1);
+    const __m256 v_sqrt_of_half = _mm256_set1_ps((float) sqrt_of_half);
+    const __m256 v_one = _mm256_set1_ps(1.0f);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 8; n += 8)
+    {
+        __m256 x = _mm256_and_ps(_mm256_loadu_ps(input + n), v_absolute);
+
+        __m256 m = _mm256_or_ps(_mm256_and_ps(x, v_mantissa), v_half);
+        __m256i e_integer = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23), v_exponent_offset);
+        __m256 e = _mm256_cvtepi32_ps(e_integer);
+
+        __m256 below = _mm256_cmp_ps(m, v_sqrt_of_half, _CMP_LT_OQ);
+        m = _mm256_add_ps(m, _mm256_and_ps(m, below));
+        e = _mm256_sub_ps(e, _mm256_and_ps(v_one, below));
+
+        __m256 s = _mm256_div_ps(_mm256_sub_ps(m, v_one), _mm256_add_ps(m, v_one));
+        __m256 z = _mm256_mul_ps(s, s);
+
+        __m256 p = _mm256_add_ps(_mm256_set1_ps((float) log_c3), _mm256_mul_ps(z, _mm256_set1_ps((float) log_c4)));
+        p = _mm256_add_ps(_mm256_set1_ps((float) log_c2), _mm256_mul_ps(z, p));
+        p = _mm256_add_ps(_mm256_set1_ps((float) log_c1), _mm256_mul_ps(z, p));
+        p = _mm256_add_ps(v_one, _mm256_mul_ps(z, p));
+
+        __m256 ln_m = _mm256_mul_ps(_mm256_add_ps(s, s), p);
+
+        __m256 result = _mm256_add_ps(
+                            _mm256_mul_ps(e, _mm256_set1_ps((float) log10_of_2)),
+                            _mm256_mul_ps(ln_m, _mm256_set1_ps((float) log10_of_e)));
+
+        _mm256_storeu_ps(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = log10(input[n]);
+    }
+}
+
+
+void FastMath::exp10(const float *input,
+                     float *output,
+                     int number_of_values)
+{
+    const __m256 v_minimum = _mm256_set1_ps(exp2_minimum_float);
+    const __m256 v_maximum = _mm256_set1_ps(exp2_maximum_float);
+    const __m256i v_exponent_bias = _mm256_set1_epi32(exponent_bias_float);
+    const __m256 v_one = _mm256_set1_ps(1.0f);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 8; n += 8)
+    {
+        __m256 y = _mm256_mul_ps(_mm256_loadu_ps(input + n), _mm256_set1_ps((float) log2_of_10));
+        y = _mm256_min_ps(_mm256_max_ps(y, v_minimum), v_maximum);
+
+        // rounds to nearest integer
+        __m256i n_integer = _mm256_cvtps_epi32(y);
+        __m256 n_round = _mm256_cvtepi32_ps(n_integer);
+        __m256 t = _mm256_mul_ps(_mm256_sub_ps(y, n_round), _mm256_set1_ps((float) ln_of_2));
+
+        __m256 p = _mm256_add_ps(_mm256_set1_ps((float) exp_c6), _mm256_mul_ps(t, _mm256_set1_ps((float) exp_c7)));
+        p = _mm256_add_ps(_mm256_set1_ps((float) exp_c5), _mm256_mul_ps(t, p));
+        p = _mm256_add_ps(_mm256_set1_ps((float) exp_c4), _mm256_mul_ps(t, p));
+        p = _mm256_add_ps(_mm256_set1_ps((float) exp_c3), _mm256_mul_ps(t, p));
+        p = _mm256_add_ps(_mm256_set1_ps((float) exp_c2), _mm256_mul_ps(t, p));
+        p = _mm256_add_ps(v_one, _mm256_mul_ps(t, p));
+        p = _mm256_add_ps(v_one, _mm256_mul_ps(t, p));
+
+        __m256i scale_bits = _mm256_slli_epi32(
+                                 _mm256_add_epi32(n_integer, v_exponent_bias), 23);
+        __m256 result = _mm256_mul_ps(p, _mm256_castsi256_ps(scale_bits));
+
+        _mm256_storeu_ps(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = exp10(input[n]);
+    }
+}
+
+#elif defined(FRUT_MATH_FAST_MATH_SSE2)
+
+void FastMath::log10(const double *input,
+                     double *output,
+                     int number_of_values)
+{
+    const __m128d v_absolute = _mm_castsi128_pd(_mm_set1_epi64x((long long) mask_absolute));
+    const __m128d v_mantissa = _mm_castsi128_pd(_mm_set1_epi64x((long long) mask_mantissa));
+    const __m128d v_half = _mm_castsi128_pd(_mm_set1_epi64x((long long) bits_half));
+    const __m128i v_exponent_magic = _mm_set1_epi64x((long long) bits_exponent_magic);
+    const __m128d v_exponent_offset = _mm_set1_pd(exponent_magic + exponent_bias - 1.0);
+    const __m128d v_sqrt_of_half = _mm_set1_pd(sqrt_of_half);
+    const __m128d v_one = _mm_set1_pd(1.0);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 2; n += 2)
+    {
+        __m128d x = _mm_and_pd(_mm_loadu_pd(input + n), v_absolute);
+
+        __m128d m = _mm_or_pd(_mm_and_pd(x, v_mantissa), v_half);
+        __m128i e_bits = _mm_or_si128(_mm_srli_epi64(_mm_castpd_si128(x), 52), v_exponent_magic);
+        __m128d e = _mm_sub_pd(_mm_castsi128_pd(e_bits), v_exponent_offset);
+
+        __m128d below = _mm_cmplt_pd(m, v_sqrt_of_half);
+        m = _mm_add_pd(m, _mm_and_pd(m, below));
+        e = _mm_sub_pd(e, _mm_and_pd(v_one, below));
+
+        __m128d s = _mm_div_pd(_mm_sub_pd(m, v_one), _mm_add_pd(m, v_one));
+        __m128d z = _mm_mul_pd(s, s);
+
+        __m128d p = _mm_add_pd(_mm_set1_pd(log_c5), _mm_mul_pd(z, _mm_set1_pd(log_c6)));
+        p = _mm_add_pd(_mm_set1_pd(log_c4), _mm_mul_pd(z, p));
+        p = _mm_add_pd(_mm_set1_pd(log_c3), _mm_mul_pd(z, p));
+        p = _mm_add_pd(_mm_set1_pd(log_c2), _mm_mul_pd(z, p));
+        p = _mm_add_pd(_mm_set1_pd(log_c1), _mm_mul_pd(z, p));
+        p = _mm_add_pd(v_one, _mm_mul_pd(z, p));
+
+        __m128d ln_m = _mm_mul_pd(_mm_add_pd(s, s), p);
+
+        __m128d result = _mm_add_pd(
+                             _mm_mul_pd(e, _mm_set1_pd(log10_of_2)),
+                             _mm_mul_pd(ln_m, _mm_set1_pd(log10_of_e)));
+
+        _mm_storeu_pd(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = log10(input[n]);
+    }
+}
+
+
+void FastMath::exp10(const double *input,
+                     double *output,
+                     int number_of_values)
+{
+    const __m128d v_minimum = _mm_set1_pd(exp2_minimum);
+    const __m128d v_maximum = _mm_set1_pd(exp2_maximum);
+    const __m128d v_round_magic = _mm_set1_pd(round_magic);
+    const __m128i v_exponent_bias = _mm_set1_epi64x((long long) exponent_bias);
+    const __m128d v_one = _mm_set1_pd(1.0);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 2; n += 2)
+    {
+        __m128d y = _mm_mul_pd(_mm_loadu_pd(input + n), _mm_set1_pd(log2_of_10));
+        y = _mm_min_pd(_mm_max_pd(y, v_minimum), v_maximum);
+
+        __m128d n_magic = _mm_add_pd(y, v_round_magic);
+        __m128d n_round = _mm_sub_pd(n_magic, v_round_magic);
+        __m128d t = _mm_mul_pd(_mm_sub_pd(y, n_round), _mm_set1_pd(ln_of_2));
+
+        __m128d p = _mm_add_pd(_mm_set1_pd(exp_c10), _mm_mul_pd(t, _mm_set1_pd(exp_c11)));
+        p = _mm_add_pd(_mm_set1_pd(exp_c9), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c8), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c7), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c6), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c5), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c4), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c3), _mm_mul_pd(t, p));
+        p = _mm_add_pd(_mm_set1_pd(exp_c2), _mm_mul_pd(t, p));
+        p = _mm_add_pd(v_one, _mm_mul_pd(t, p));
+        p = _mm_add_pd(v_one, _mm_mul_pd(t, p));
+
+        __m128i scale_bits = _mm_slli_epi64(
+                                 _mm_add_epi64(_mm_castpd_si128(n_magic), v_exponent_bias), 52);
+        __m128d result = _mm_mul_pd(p, _mm_castsi128_pd(scale_bits));
+
+        _mm_storeu_pd(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = exp10(input[n]);
+    }
+}
+
+
+void FastMath::log10(const float *input,
+                     float *output,
+                     int number_of_values)
+{
+    const __m128 v_absolute = _mm_castsi128_ps(_mm_set1_epi32((int) mask_absolute_float));
+    const __m128 v_mantissa = _mm_castsi128_ps(_mm_set1_epi32((int) mask_mantissa_float));
+    const __m128 v_half = _mm_castsi128_ps(_mm_set1_epi32((int) bits_half_float));
+    const __m128i v_exponent_offset = _mm_set1_epi32(exponent_bias_float - 1);
+    const __m128 v_sqrt_of_half = _mm_set1_ps((float) sqrt_of_half);
+    const __m128 v_one = _mm_set1_ps(1.0f);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 4; n += 4)
+    {
+        __m128 x = _mm_and_ps(_mm_loadu_ps(input + n), v_absolute);
+
+        __m128 m = _mm_or_ps(_mm_and_ps(x, v_mantissa), v_half);
+        __m128i e_integer = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), v_exponent_offset);
+        __m128 e = _mm_cvtepi32_ps(e_integer);
+
+        __m128 below = _mm_cmplt_ps(m, v_sqrt_of_half);
+        m = _mm_add_ps(m, _mm_and_ps(m, below));
+        e = _mm_sub_ps(e, _mm_and_ps(v_one, below));
+
+        __m128 s = _mm_div_ps(_mm_sub_ps(m, v_one), _mm_add_ps(m, v_one));
+        __m128 z = _mm_mul_ps(s, s);
+
+        __m128 p = _mm_add_ps(_mm_set1_ps((float) log_c3), _mm_mul_ps(z, _mm_set1_ps((float) log_c4)));
+        p = _mm_add_ps(_mm_set1_ps((float) log_c2), _mm_mul_ps(z, p));
+        p = _mm_add_ps(_mm_set1_ps((float) log_c1), _mm_mul_ps(z, p));
+        p = _mm_add_ps(v_one, _mm_mul_ps(z, p));
+
+        __m128 ln_m = _mm_mul_ps(_mm_add_ps(s, s), p);
+
+        __m128 result = _mm_add_ps(
+                            _mm_mul_ps(e, _mm_set1_ps((float) log10_of_2)),
+                            _mm_mul_ps(ln_m, _mm_set1_ps((float) log10_of_e)));
+
+        _mm_storeu_ps(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = log10(input[n]);
+    }
+}
+
+
+void FastMath::exp10(const float *input,
+                     float *output,
+                     int number_of_values)
+{
+    const __m128 v_minimum = _mm_set1_ps(exp2_minimum_float);
+    const __m128 v_maximum = _mm_set1_ps(exp2_maximum_float);
+    const __m128i v_exponent_bias = _mm_set1_epi32(exponent_bias_float);
+    const __m128 v_one = _mm_set1_ps(1.0f);
+
+    int n = 0;
+
+    for (; n <= number_of_values - 4; n += 4)
+    {
+        __m128 y = _mm_mul_ps(_mm_loadu_ps(input + n), _mm_set1_ps((float) log2_of_10));
+        y = _mm_min_ps(_mm_max_ps(y, v_minimum), v_maximum);
+
+        // rounds to nearest integer
+        __m128i n_integer = _mm_cvtps_epi32(y);
+        __m128 n_round = _mm_cvtepi32_ps(n_integer);
+        __m128 t = _mm_mul_ps(_mm_sub_ps(y, n_round), _mm_set1_ps((float) ln_of_2));
+
+        __m128 p = _mm_add_ps(_mm_set1_ps((float) exp_c6), _mm_mul_ps(t, _mm_set1_ps((float) exp_c7)));
+        p = _mm_add_ps(_mm_set1_ps((float) exp_c5), _mm_mul_ps(t, p));
+        p = _mm_add_ps(_mm_set1_ps((float) exp_c4), _mm_mul_ps(t, p));
+        p = _mm_add_ps(_mm_set1_ps((float) exp_c3), _mm_mul_ps(t, p));
+        p = _mm_add_ps(_mm_set1_ps((float) exp_c2), _mm_mul_ps(t, p));
+        p = _mm_add_ps(v_one, _mm_mul_ps(t, p));
+        p = _mm_add_ps(v_one, _mm_mul_ps(t, p));
+
+        __m128i scale_bits = _mm_slli_epi32(
+                                 _mm_add_epi32(n_integer, v_exponent_bias), 23);
+        __m128 result = _mm_mul_ps(p, _mm_castsi128_ps(scale_bits));
+
+        _mm_storeu_ps(output + n, result);
+    }
+
+    for (; n < number_of_values; ++n)
+    {
+        output[n] = exp10(input[n]);
+    }
+}
+
+#else
+
+void FastMath::log10(const double *input,
+                     double *output,
+                     int number_of_values)
+{
+    for (int n = 0; n < number_of_values; ++n)
+    {
+        output[n] = log10(input[n]);
+    }
+}
+
+
+void FastMath::exp10(const double *input,
+                     double *output,
+                     int number_of_values)
+{
+    for (int n = 0; n < number_of_values; ++n)
+    {
+        output[n] = exp10(input[n]);
+    }
+}
+
+
+void FastMath::log10(const float *input,
+                     float *output,
+                     int number_of_values)
+{
+    for (int n = 0; n < number_of_values; ++n)
+    {
+        output[n] = log10(input[n]);
+    }
+}
+
+
+void FastMath::exp10(const float *input,
+                     float *output,
+                     int number_of_values)
+{
+    for (int n = 0; n < number_of_values; ++n)
+    {
+        output[n] = exp10(input[n]);
+    }
+}
+
+#endif
+
+}
+}
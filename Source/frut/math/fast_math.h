@@ -0,0 +1,168 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_MATH_FAST_MATH_H
+#define FRUT_MATH_FAST_MATH_H
+
+namespace frut
+{
+namespace math
+{
+
+/// Fast approximations of transcendental functions that process
+/// whole blocks of values.  Uses AVX2 or SSE2 when these are enabled
+/// at compile time and falls back to portable scalar code otherwise;
+/// all code paths perform the same operations and thus yield
+/// (nearly) identical results.
+///
+/// Maximum errors over the documented input ranges:
+///
+/// - log10: absolute error below 1e-12, which amounts to less than
+///   1e-10 dB when converting levels to decibels
+///
+/// - exp10: relative error below 1e-13, which amounts to less than
+///   1e-12 dB when converting decibels to levels
+///
+/// Both errors are far below the 0.001 dB that can be resolved by
+/// any meter or gain stage of this library.
+///
+/// The single precision versions use shorter polynomials.  Their
+/// errors are dominated by rounding the result (log10) and the
+/// reduced argument (exp10) to float, so they grow with the
+/// magnitude of the logarithm.  Over the whole range of floats, the
+/// absolute error of log10 stays below 6e-6 and the relative error
+/// of exp10 below 5e-6; for levels between -160 and +160 dB, they
+/// stay below 1e-6 and 1.2e-6.  This amounts to less than 2e-4 dB.
+///
+class FastMath
+{
+public:
+    /// Calculate the decimal logarithm of a block of values.  Input
+    /// and output may point to the same memory.
+    ///
+    /// @param input input values; the sign of each value is ignored.
+    ///        Zero and denormal values yield very small numbers
+    ///        (around -308) instead of negative infinity.  Results
+    ///        for infinity and NaN are undefined.
+    ///
+    /// @param output output values
+    ///
+    /// @param number_of_values number of values to process
+    ///
+    static void log10(const double *input,
+                      double *output,
+                      int number_of_values);
+
+
+    /// Calculate the power of ten for a block of values.  Input and
+    /// output may point to the same memory.
+    ///
+    /// @param input input values; values are clamped to the range
+    ///        -307.6 to 307.9 so that the results are neither
+    ///        denormal nor infinite.  Results for NaN are undefined.
+    ///
+    /// @param output output values
+    ///
+    /// @param number_of_values number of values to process
+    ///
+    static void exp10(const double *input,
+                      double *output,
+                      int number_of_values);
+
+
+    /// Calculate the decimal logarithm of a single value.  Please
+    /// see log10() for details.
+    ///
+    /// @param x input value
+    ///
+    /// @return decimal logarithm
+    ///
+    static double log10(double x);
+
+
+    /// Calculate the power of ten for a single value.  Please see
+    /// exp10() for details.
+    ///
+    /// @param x input value
+    ///
+    /// @return power of ten
+    ///
+    static double exp10(double x);
+
+
+    /// Calculate the decimal logarithm of a block of values in
+    /// single precision.  Zero and denormal values yield values
+    /// around -38.  Please see log10() for details.
+    ///
+    /// @param input input values
+    ///
+    /// @param output output values
+    ///
+    /// @param number_of_values number of values to process
+    ///
+    static void log10(const float *input,
+                      float *output,
+                      int number_of_values);
+
+
+    /// Calculate the power of ten for a block of values in single
+    /// precision.  Values are clamped to the range -37.9 to 38.2.
+    /// Please see exp10() for details.
+    ///
+    /// @param input input values
+    ///
+    /// @param output output values
+    ///
+    /// @param number_of_values number of values to process
+    ///
+    static void exp10(const float *input,
+                      float *output,
+                      int number_of_values);
+
+
+    /// Calculate the decimal logarithm of a single value in single
+    /// precision.
+    ///
+    /// @param x input value
+    ///
+    /// @return decimal logarithm
+    ///
+    static float log10(float x);
+
+
+    /// Calculate the power of ten for a single value in single
+    /// precision.
+    ///
+    /// @param x input value
+    ///
+    /// @return power of ten
+    ///
+    static float exp10(float x);
+};
+
+}
+}
+
+#endif  // FRUT_MATH_FAST_MATH_H
@@ -51,6 +51,15 @@ Juggler::Juggler(
     // store number of parameters
     numberOfParameters_ = completeParameters;
     numberOfRevealedParameters_ = revealedParameters;
+
+    // allocate and clear change flags
+    numberOfChangeFlagWords_ = (numberOfParameters_ + 31) / 32;
+    changeFlags_.reset(new std::atomic<uint32>[numberOfChangeFlagWords_]);
+
+    for (int word = 0; word < numberOfChangeFlagWords_; ++word)
+    {
+        changeFlags_[word] = 0;
+    }
 }
 
 
@@ -82,6 +91,26 @@ void Juggler::assertParameter(
 #endif
 
 
+/// Store change flag of a virtual parameter in the juggler's change
+/// flags.
+///
+/// @param parameter plug-in parameter instance
+///
+/// @param index index of virtual parameter
+///
+void Juggler::attachChangeFlag(
+    Parameter *parameter,
+    int index)
+
+{
+    // number of parameters was specified in constructor
+    jassert(index < numberOfParameters_);
+
+    parameter->setChangeFlagStorage(&changeFlags_[index / 32],
+                                    1u << (index % 32));
+}
+
+
 /// Get pointer to plug-in parameter.  **Do not delete this pointer!**
 ///
 /// @param index parameter index
@@ -174,6 +203,9 @@ void Juggler::add(
 
     // check whether index of parameter is correct
     jassert(virtualParameters_.size() == index + 1);
+
+    // store change flag in juggler
+    attachChangeFlag(parameter, virtualParameters_.size() - 1);
 }
 
 
@@ -228,6 +260,10 @@ void Juggler::addCombined(
     // check whether index of parameter switch is correct
     jassert(virtualParameters_.size() == switchIndex + 1);
 
+    // store change flag of parameter switch in juggler
+    attachChangeFlag(parameter->getModeSwitch(),
+                     virtualParameters_.size() - 1);
+
     // mark parameter for deletion on class destruction
     garbageCollector_.add(parameter);
 
@@ -239,6 +275,9 @@ void Juggler::addCombined(
 
     // check whether index of continuous parameter is correct
     jassert(virtualParameters_.size() == parameterIndex + 1);
+
+    // store change flag of continuous parameter in juggler
+    attachChangeFlag(parameter, virtualParameters_.size() - 1);
 }
 
 
@@ -569,7 +608,8 @@ bool Juggler::hasChanged(
     assertParameter(index, false);
 #endif
 
-    return virtualParameters_[index]->hasChanged();
+    uint32 changeFlagMask = 1u << (index % 32);
+    return (changeFlags_[index / 32].load() & changeFlagMask) != 0;
 }
 
 
@@ -585,7 +625,63 @@ void Juggler::clearChangeFlag(
     assertParameter(index, false);
 #endif
 
-    return virtualParameters_[index]->clearChangeFlag();
+    uint32 changeFlagMask = 1u << (index % 32);
+    changeFlags_[index / 32].fetch_and(~changeFlagMask);
+}
+
+
+/// Find next parameter that has changed.  This scans the change flags
+/// a word at a time, so checking all parameters is cheap when only a
+/// few have changed.  Change flags are not cleared.
+///
+/// @param startIndex index of first parameter to check
+///
+/// @param includeHiddenParameters check hidden parameters that cannot
+///        be automated
+///
+/// @return index of changed parameter, or -1 if no parameter from
+///         **startIndex** onwards has changed
+///
+int Juggler::getNextChangedParameter(
+    int startIndex,
+    bool includeHiddenParameters)
+
+{
+    jassert(startIndex >= 0);
+
+    int numberOfParameters = getNumParameters(includeHiddenParameters);
+
+    if (startIndex >= numberOfParameters)
+    {
+        return -1;
+    }
+
+    int word = startIndex / 32;
+
+    // ignore change flags of parameters before start index
+    uint32 changeFlags = changeFlags_[word].load() &
+                         (0xFFFFFFFFu << (startIndex % 32));
+
+    for (;;)
+    {
+        if (changeFlags != 0)
+        {
+            // isolate lowest set bit and get its position
+            uint32 lowestBit = changeFlags & (~changeFlags + 1u);
+            int index = word * 32 + findHighestSetBit(lowestBit);
+
+            return (index < numberOfParameters) ? index : -1;
+        }
+
+        ++word;
+
+        if (word * 32 >= numberOfParameters)
+        {
+            return -1;
+        }
+
+        changeFlags = changeFlags_[word].load();
+    }
 }
 
 
@@ -89,6 +89,8 @@ public:
 
     bool hasChanged(int index);
     void clearChangeFlag(int index);
+    int getNextChangedParameter(int startIndex,
+                                bool includeHiddenParameters);
 
     void loadFromXml(XmlElement *xmlDocument);
     XmlElement storeAsXml();
@@ -99,6 +101,9 @@ protected:
                          bool wantModification);
 #endif
 
+    void attachChangeFlag(Parameter *parameter,
+                          int index);
+
     int numberOfParameters_;
     int numberOfRevealedParameters_;
 
@@ -120,6 +125,13 @@ protected:
     // will be handled as a constant.
     Array<bool> mayModify_;
 
+    // Change flags of all *virtual* parameters, packed into words of
+    // 32 bits.  Parameters set and clear their bit atomically, so
+    // changed parameters can be found by scanning a few words
+    // instead of polling every single parameter.
+    std::unique_ptr<std::atomic<uint32>[]> changeFlags_;
+    int numberOfChangeFlagWords_;
+
 private:
     JUCE_LEAK_DETECTOR(Juggler);
 };
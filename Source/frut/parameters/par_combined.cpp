@@ -525,6 +525,30 @@ void ParCombined::clearChangeFlag()
 }
 
 
+/// Store change flag in a bit of an external word.  Preset and
+/// continuous values share this bit; the mode switch is a parameter
+/// of its own.
+///
+/// @param changeFlags word that holds the change flag
+///
+/// @param changeFlagMask bit mask of change flag within word
+///
+void ParCombined::setChangeFlagStorage(std::atomic<uint32> *changeFlags,
+                                       uint32 changeFlagMask)
+{
+    bool isChanged = hasChanged();
+
+    presetValues.setChangeFlagStorage(changeFlags, changeFlagMask);
+    continuousValues.setChangeFlagStorage(changeFlags, changeFlagMask);
+
+    // both values share the same bit, so carry over combined state
+    if (isChanged)
+    {
+        changeFlags->fetch_or(changeFlagMask);
+    }
+}
+
+
 /// Mark parameter as changed.
 ///
 void ParCombined::setChangeFlag()
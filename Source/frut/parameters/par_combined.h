@@ -77,6 +77,8 @@ public:
 
     virtual bool hasChanged() override;
     virtual void clearChangeFlag() override;
+    virtual void setChangeFlagStorage(std::atomic<uint32> *changeFlags,
+                                      uint32 changeFlagMask) override;
 
     virtual void loadFromXml(XmlElement *xmlDocument) override;
     virtual void storeAsXml(XmlElement *xmlDocument) override;
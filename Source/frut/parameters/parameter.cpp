@@ -38,7 +38,11 @@ Parameter::Parameter()
     // initialise current value
     value_ = 0.0f;
     realValue_ = 0.0f;
+
+    // initialise change flag
     valueHasChanged_ = false;
+    changeFlags_ = nullptr;
+    changeFlagMask_ = 0;
 
     // initialise default value
     defaultValue_ = 0.0f;
@@ -235,7 +239,14 @@ void Parameter::setText(const String &newValue)
 ///
 bool Parameter::hasChanged()
 {
-    return valueHasChanged_;
+    if (changeFlags_)
+    {
+        return (changeFlags_->load() & changeFlagMask_) != 0;
+    }
+    else
+    {
+        return valueHasChanged_;
+    }
 }
 
 
@@ -243,7 +254,14 @@ bool Parameter::hasChanged()
 ///
 void Parameter::clearChangeFlag()
 {
-    valueHasChanged_ = false;
+    if (changeFlags_)
+    {
+        changeFlags_->fetch_and(~changeFlagMask_);
+    }
+    else
+    {
+        valueHasChanged_ = false;
+    }
 }
 
 
@@ -251,7 +269,42 @@ void Parameter::clearChangeFlag()
 ///
 void Parameter::setChangeFlag()
 {
-    valueHasChanged_ = true;
+    if (changeFlags_)
+    {
+        changeFlags_->fetch_or(changeFlagMask_);
+    }
+    else
+    {
+        valueHasChanged_ = true;
+    }
+}
+
+
+/// Store change flag in a bit of an external word (usually the
+/// change flags of a Juggler), so that the change flags of many
+/// parameters can be queried at once.  The current state of the
+/// change flag is carried over.
+///
+/// @param changeFlags word that holds the change flag
+///
+/// @param changeFlagMask bit mask of change flag within word
+///
+void Parameter::setChangeFlagStorage(std::atomic<uint32> *changeFlags,
+                                     uint32 changeFlagMask)
+{
+    bool isChanged = hasChanged();
+
+    changeFlags_ = changeFlags;
+    changeFlagMask_ = changeFlagMask;
+
+    if (isChanged)
+    {
+        setChangeFlag();
+    }
+    else
+    {
+        clearChangeFlag();
+    }
 }
 
 
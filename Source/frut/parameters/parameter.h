@@ -112,6 +112,8 @@ public:
 
     virtual bool hasChanged();
     virtual void clearChangeFlag();
+    virtual void setChangeFlagStorage(std::atomic<uint32> *changeFlags,
+                                      uint32 changeFlagMask);
 
     virtual void loadFromXml(XmlElement *xmlDocument);
     virtual void storeAsXml(XmlElement *xmlDocument);
@@ -119,13 +121,19 @@ public:
 protected:
     virtual void setChangeFlag();
 
-    float value_;
-    float realValue_;
+    // values are written by host and GUI threads while being read by
+    // the audio thread
+    std::atomic<float> value_;
+    std::atomic<float> realValue_;
 
     float defaultValue_;
     float defaultRealValue_;
 
-    bool valueHasChanged_;
+    // change flag is either stored here or (when the parameter has
+    // been added to a Juggler) in a bit of the juggler's change flags
+    std::atomic<bool> valueHasChanged_;
+    std::atomic<uint32> *changeFlags_;
+    uint32 changeFlagMask_;
 
     String parameterName_;
     String tagName_;
@@ -0,0 +1,325 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "gain_reduction_history.h"
+
+
+GainReductionHistory::GainReductionHistory() :
+    QueuedBins(QueueSize),
+    QueuedMinima(QueueSize),
+    QueuedMaxima(QueueSize),
+    QueuedPeakLevels(QueueSize),
+    Minima(NumberOfLevels * BinsPerLevel),
+    Maxima(NumberOfLevels * BinsPerLevel),
+    LevelMinima(NumberOfLevels * BinsPerLevel),
+    LevelMaxima(NumberOfLevels * BinsPerLevel)
+{
+    setSampleRate(44100);
+    clear();
+}
+
+
+void GainReductionHistory::setSampleRate(int SampleRate)
+/*  Set sample rate of pushed samples and discard the current bin.
+    Must not be called while samples are pushed.
+
+    SampleRate (integer): new sample rate
+
+    return value: none
+ */
+{
+    SamplesPerBin = jmax(SampleRate / BinsPerSecond, 1);
+    BinPosition = 0;
+}
+
+
+void GainReductionHistory::push(float Minimum,
+                                float Maximum,
+                                float PeakLevel,
+                                int NumberOfSamples)
+/*  Add gain reduction and output level of processed samples; finished
+    bins are queued for the reader.  Lock-free; must only be called by
+    a single writer (usually the audio thread).
+
+    Minimum (float): lowest gain reduction of processed samples in
+    decibel
+
+    Maximum (float): highest gain reduction of processed samples in
+    decibel
+
+    PeakLevel (float): peak output level of processed samples in
+    decibel
+
+    NumberOfSamples (integer): number of processed samples
+
+    return value: none
+ */
+{
+    while (NumberOfSamples > 0)
+    {
+        // blocks that straddle bins are added to all of them
+        if (BinPosition == 0)
+        {
+            BinMinimum = Minimum;
+            BinMaximum = Maximum;
+            BinPeakLevel = PeakLevel;
+        }
+        else
+        {
+            BinMinimum = jmin(BinMinimum, Minimum);
+            BinMaximum = jmax(BinMaximum, Maximum);
+            BinPeakLevel = jmax(BinPeakLevel, PeakLevel);
+        }
+
+        int SamplesToAdd = jmin(NumberOfSamples, SamplesPerBin - BinPosition);
+
+        BinPosition += SamplesToAdd;
+        NumberOfSamples -= SamplesToAdd;
+
+        if (BinPosition == SamplesPerBin)
+        {
+            BinPosition = 0;
+
+            int StartIndex1, BlockSize1, StartIndex2, BlockSize2;
+            QueuedBins.prepareToWrite(1, StartIndex1, BlockSize1,
+                                      StartIndex2, BlockSize2);
+
+            // drop bin when the reader has fallen behind
+            if (BlockSize1 > 0)
+            {
+                QueuedMinima[StartIndex1] = BinMinimum;
+                QueuedMaxima[StartIndex1] = BinMaximum;
+                QueuedPeakLevels[StartIndex1] = BinPeakLevel;
+
+                QueuedBins.finishedWrite(1);
+            }
+        }
+    }
+}
+
+
+void GainReductionHistory::update()
+/*  Merge queued bins into history.  Lock-free; must only be called by
+    a single reader (the processor calls it on the message thread, so
+    that no bins are dropped while the editor is closed).
+
+    return value: none
+ */
+{
+    int StartIndex1, BlockSize1, StartIndex2, BlockSize2;
+    QueuedBins.prepareToRead(QueuedBins.getNumReady(),
+                             StartIndex1, BlockSize1,
+                             StartIndex2, BlockSize2);
+
+    for (int Index = StartIndex1; Index < StartIndex1 + BlockSize1; ++Index)
+    {
+        addBin(QueuedMinima[Index], QueuedMaxima[Index],
+               QueuedPeakLevels[Index]);
+    }
+
+    for (int Index = StartIndex2; Index < StartIndex2 + BlockSize2; ++Index)
+    {
+        addBin(QueuedMinima[Index], QueuedMaxima[Index],
+               QueuedPeakLevels[Index]);
+    }
+
+    QueuedBins.finishedRead(BlockSize1 + BlockSize2);
+}
+
+
+void GainReductionHistory::clear()
+/*  Clear history.  Must only be called by the reader.
+
+    return value: none
+ */
+{
+    for (int Level = 0; Level < NumberOfLevels; ++Level)
+    {
+        WriteIndices[Level] = 0;
+        ValidBins[Level] = 0;
+
+        PendingMinima[Level] = 0.0f;
+        PendingMaxima[Level] = 0.0f;
+        PendingLevelMinima[Level] = 0.0f;
+        PendingLevelMaxima[Level] = 0.0f;
+        PendingBins[Level] = 0;
+    }
+}
+
+
+int GainReductionHistory::getNumberOfBins(int Level)
+/*  Get number of bins in history.  Must only be called by the reader.
+
+    Level (integer): level of history (0 is finest)
+
+    return value (integer): returns number of bins that can be read
+    from given level
+ */
+{
+    jassert(Level >= 0);
+    jassert(Level < NumberOfLevels);
+
+    return ValidBins[Level];
+}
+
+
+int GainReductionHistory::getLevel(double TimeSpan,
+                                   int MaximumNumberOfBins)
+/*  Get finest level that covers a time span with a limited number of
+    bins.  Drawing from this level costs the same for any time span.
+
+    TimeSpan (double): time span in seconds
+
+    MaximumNumberOfBins (integer): maximum number of bins (such as the
+    width of the display in pixels)
+
+    return value (integer): returns level of history
+ */
+{
+    jassert(MaximumNumberOfBins > 0);
+
+    double NumberOfBins = TimeSpan * BinsPerSecond;
+
+    for (int Level = 0; Level < NumberOfLevels - 1; ++Level)
+    {
+        if ((NumberOfBins <= MaximumNumberOfBins) &&
+                (NumberOfBins <= BinsPerLevel))
+        {
+            return Level;
+        }
+
+        NumberOfBins *= 0.5;
+    }
+
+    return NumberOfLevels - 1;
+}
+
+
+double GainReductionHistory::getBinLength(int Level)
+/*  Get time covered by a single bin.
+
+    Level (integer): level of history (0 is finest)
+
+    return value (double): returns length of bin in seconds
+ */
+{
+    jassert(Level >= 0);
+    jassert(Level < NumberOfLevels);
+
+    return double(1 << Level) / BinsPerSecond;
+}
+
+
+void GainReductionHistory::getBins(int Level,
+                                   int NumberOfBins,
+                                   float *BinMinima,
+                                   float *BinMaxima,
+                                   float *BinLevelMinima,
+                                   float *BinLevelMaxima)
+/*  Get latest bins of history (oldest bin first).  Must only be
+    called by the reader.
+
+    Level (integer): level of history (0 is finest)
+
+    NumberOfBins (integer): number of bins to read (must not exceed
+    getNumberOfBins())
+
+    BinMinima (float pointer): receives lowest gain reduction of each
+    bin in decibel
+
+    BinMaxima (float pointer): receives highest gain reduction of each
+    bin in decibel
+
+    BinLevelMinima (float pointer): receives lowest peak output level
+    of each bin in decibel
+
+    BinLevelMaxima (float pointer): receives highest peak output level
+    of each bin in decibel
+
+    return value: none
+ */
+{
+    jassert(Level >= 0);
+    jassert(Level < NumberOfLevels);
+    jassert(NumberOfBins <= ValidBins[Level]);
+
+    int Offset = Level * BinsPerLevel;
+    int Index = WriteIndices[Level] - NumberOfBins;
+
+    if (Index < 0)
+    {
+        Index += BinsPerLevel;
+    }
+
+    for (int Bin = 0; Bin < NumberOfBins; ++Bin)
+    {
+        BinMinima[Bin] = Minima[Offset + Index];
+        BinMaxima[Bin] = Maxima[Offset + Index];
+        BinLevelMinima[Bin] = LevelMinima[Offset + Index];
+        BinLevelMaxima[Bin] = LevelMaxima[Offset + Index];
+
+        Index = (Index + 1) % BinsPerLevel;
+    }
+}
+
+
+void GainReductionHistory::addBin(float Minimum,
+                                  float Maximum,
+                                  float PeakLevel)
+{
+    float LevelMinimum = PeakLevel;
+    float LevelMaximum = PeakLevel;
+
+    for (int Level = 0; Level < NumberOfLevels; ++Level)
+    {
+        int Index = Level * BinsPerLevel + WriteIndices[Level];
+
+        Minima[Index] = Minimum;
+        Maxima[Index] = Maximum;
+        LevelMinima[Index] = LevelMinimum;
+        LevelMaxima[Index] = LevelMaximum;
+
+        WriteIndices[Level] = (WriteIndices[Level] + 1) % BinsPerLevel;
+        ValidBins[Level] = jmin(ValidBins[Level] + 1, int(BinsPerLevel));
+
+        // combine two bins into a single bin of the next level
+        if (PendingBins[Level] == 0)
+        {
+            PendingMinima[Level] = Minimum;
+            PendingMaxima[Level] = Maximum;
+            PendingLevelMinima[Level] = LevelMinimum;
+            PendingLevelMaxima[Level] = LevelMaximum;
+            PendingBins[Level] = 1;
+
+            break;
+        }
+
+        Minimum = jmin(PendingMinima[Level], Minimum);
+        Maximum = jmax(PendingMaxima[Level], Maximum);
+        LevelMinimum = jmin(PendingLevelMinima[Level], LevelMinimum);
+        LevelMaximum = jmax(PendingLevelMaxima[Level], LevelMaximum);
+        PendingBins[Level] = 0;
+    }
+}
@@ -0,0 +1,112 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_GAIN_REDUCTION_HISTORY_H
+#define SQUEEZER_GAIN_REDUCTION_HISTORY_H
+
+#include "FrutHeader.h"
+
+
+// history of gain reduction and output level (minimum and maximum of
+// every 10 ms); the audio thread (single writer) hands finished bins
+// to the message thread (single reader) through a lock-free FIFO,
+// where they are merged into a pyramid of decreasing resolution, so
+// that any time span can be drawn from a level with about one bin per
+// pixel
+class GainReductionHistory
+{
+public:
+    enum Parameters  // public namespace!
+    {
+        BinsPerSecond = 100,
+
+        // each level halves the resolution of the level below; the
+        // coarsest level covers about 43 minutes
+        NumberOfLevels = 8,
+        BinsPerLevel = 2048,
+
+        // bins that may be queued (dropped when exceeded)
+        QueueSize = 1024,
+    };
+
+    GainReductionHistory();
+
+    void setSampleRate(int SampleRate);
+    void push(float Minimum,
+              float Maximum,
+              float PeakLevel,
+              int NumberOfSamples);
+
+    void update();
+    void clear();
+
+    int getNumberOfBins(int Level);
+    static int getLevel(double TimeSpan, int MaximumNumberOfBins);
+    static double getBinLength(int Level);
+
+    void getBins(int Level,
+                 int NumberOfBins,
+                 float *BinMinima,
+                 float *BinMaxima,
+                 float *BinLevelMinima,
+                 float *BinLevelMaxima);
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(GainReductionHistory);
+
+    void addBin(float Minimum, float Maximum, float PeakLevel);
+
+    // writer: samples per bin and state of the current bin
+    int SamplesPerBin;
+    int BinPosition;
+    float BinMinimum;
+    float BinMaximum;
+    float BinPeakLevel;
+
+    AbstractFifo QueuedBins;
+    HeapBlock<float> QueuedMinima;
+    HeapBlock<float> QueuedMaxima;
+    HeapBlock<float> QueuedPeakLevels;
+
+    // reader: ring buffers of all levels (level after level), index
+    // of the next bin and number of valid bins of each level; the
+    // output level of a bin spans the peak levels of its 10 ms bins
+    HeapBlock<float> Minima;
+    HeapBlock<float> Maxima;
+    HeapBlock<float> LevelMinima;
+    HeapBlock<float> LevelMaxima;
+
+    int WriteIndices[NumberOfLevels];
+    int ValidBins[NumberOfLevels];
+
+    // bins that have not yet been merged into the next level
+    float PendingMinima[NumberOfLevels];
+    float PendingMaxima[NumberOfLevels];
+    float PendingLevelMinima[NumberOfLevels];
+    float PendingLevelMaxima[NumberOfLevels];
+    int PendingBins[NumberOfLevels];
+};
+
+#endif  // SQUEEZER_GAIN_REDUCTION_HISTORY_H
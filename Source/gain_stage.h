@@ -29,7 +29,7 @@
 #include "FrutHeader.h"
 
 
-class GainStage
+class GainStageBase
 {
 public:
     enum Parameters  // public namespace!
@@ -38,12 +38,25 @@ public:
         Optical,
         NumberOfGainStages,
     };
+};
+
 
+template <typename SampleType>
+class GainStage :
+    public GainStageBase
+{
+public:
     // Destructor.
     virtual ~GainStage() {};
 
-    virtual void reset(double dCurrentGainReduction) = 0;
-    virtual double processGainReduction(double dGainReductionNew, double dGainReductionIdeal) = 0;
+    virtual void reset(SampleType dCurrentGainReduction) = 0;
+    virtual SampleType processGainReduction(SampleType dGainReductionNew, SampleType dGainReductionIdeal) = 0;
+
+    virtual void processGainReduction(const SampleType *dGainReductionsNew,
+                                      const SampleType *dGainReductionsIdeal,
+                                      SampleType *dGainReductions,
+                                      SampleType *dGainReductionsRepeated,
+                                      int nNumSamples) = 0;
 
 protected:
     explicit GainStage(int nSampleRate)
@@ -26,7 +26,9 @@
 #include "gain_stage_fet.h"
 
 
-GainStageFET::GainStageFET(int nSampleRate) : GainStage(nSampleRate)
+template <typename SampleType>
+GainStageFET<SampleType>::GainStageFET(int nSampleRate) :
+    GainStage<SampleType>(nSampleRate)
     /*  Constructor.
 
         nSampleRate (integer): internal sample rate
@@ -35,14 +37,15 @@ GainStageFET::GainStageFET(int nSampleRate) : GainStage(nSampleRate)
     */
 {
     // reset (i.e. initialise) all relevant variables
-    reset(0.0);
+    reset(SampleType(0.0));
 }
 
 
-void GainStageFET::reset(double dCurrentGainReduction)
+template <typename SampleType>
+void GainStageFET<SampleType>::reset(SampleType dCurrentGainReduction)
 /*  Reset all relevant variables.
 
-    dCurrentGainReduction (double): current gain reduction in decibels
+    dCurrentGainReduction (SampleType): current gain reduction in decibels
 
     return value: none
 */
@@ -51,16 +54,17 @@ void GainStageFET::reset(double dCurrentGainReduction)
 }
 
 
-double GainStageFET::processGainReduction(double dGainReductionNew, double dGainReductionIdeal)
+template <typename SampleType>
+SampleType GainStageFET<SampleType>::processGainReduction(SampleType dGainReductionNew, SampleType dGainReductionIdeal)
 /*  Process current gain reduction.
 
-    dGainReductionNew (double): calculated new gain reduction in
+    dGainReductionNew (SampleType): calculated new gain reduction in
     decibels
 
-    dGainReductionIdeal (double): calculated "ideal" gain reduction
-    (without any envelopes) decibels
+    dGainReductionIdeal (SampleType): calculated "ideal" gain
+    reduction (without any envelopes) decibels
 
-    return value (double): returns the processed gain reduction in
+    return value (SampleType): returns the processed gain reduction in
     decibel
  */
 {
@@ -69,3 +73,58 @@ double GainStageFET::processGainReduction(double dGainReductionNew, double dGain
     dGainReduction = dGainReductionNew;
     return dGainReduction;
 }
+
+
+template <typename SampleType>
+void GainStageFET<SampleType>::processGainReduction(
+    const SampleType *dGainReductionsNew,
+    const SampleType *dGainReductionsIdeal,
+    SampleType *dGainReductions,
+    SampleType *dGainReductionsRepeated,
+    int nNumSamples)
+/*  Process a block of gain reductions.  Input and output arrays may
+    be the same.
+
+    dGainReductionsNew (pointer to SampleType): calculated new gain
+    reductions in decibels
+
+    dGainReductionsIdeal (pointer to SampleType): calculated "ideal"
+    gain reductions (without any envelopes) in decibels
+
+    dGainReductions (pointer to SampleType): receives the processed
+    gain reductions in decibels
+
+    dGainReductionsRepeated (pointer to SampleType): if not nullptr,
+    every sample is processed a second time and this array receives
+    the result
+
+    nNumSamples (integer): number of samples to process
+
+    return value: none
+ */
+{
+    ignoreUnused(dGainReductionsIdeal);
+
+    if (nNumSamples <= 0)
+    {
+        return;
+    }
+
+    // the FET gain stage passes gain reduction through
+    if (dGainReductions != dGainReductionsNew)
+    {
+        FloatVectorOperations::copy(dGainReductions, dGainReductionsNew, nNumSamples);
+    }
+
+    if ((dGainReductionsRepeated != nullptr) && (dGainReductionsRepeated != dGainReductionsNew))
+    {
+        FloatVectorOperations::copy(dGainReductionsRepeated, dGainReductionsNew, nNumSamples);
+    }
+
+    dGainReduction = dGainReductionsNew[nNumSamples - 1];
+}
+
+
+// explicit instantiation of all template instances
+template class GainStageFET<float>;
+template class GainStageFET<double>;
@@ -30,17 +30,24 @@
 #include "gain_stage.h"
 
 
-class GainStageFET : virtual public GainStage
+template <typename SampleType>
+class GainStageFET : virtual public GainStage<SampleType>
 {
 public:
     explicit GainStageFET(int nSampleRate);
 
-    void reset(double dCurrentGainReduction);
-    double processGainReduction(double dGainReductionNew, double dGainReductionIdeal);
+    void reset(SampleType dCurrentGainReduction);
+    SampleType processGainReduction(SampleType dGainReductionNew, SampleType dGainReductionIdeal);
+
+    void processGainReduction(const SampleType *dGainReductionsNew,
+                              const SampleType *dGainReductionsIdeal,
+                              SampleType *dGainReductions,
+                              SampleType *dGainReductionsRepeated,
+                              int nNumSamples);
 private:
     JUCE_LEAK_DETECTOR(GainStageFET);
 
-    double dGainReduction;
+    SampleType dGainReduction;
 };
 
 #endif  // SQUEEZER_GAIN_STAGE_FET_H
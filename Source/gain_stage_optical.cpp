@@ -26,21 +26,25 @@
 #include "gain_stage_optical.h"
 
 
-GainStageOptical::GainStageOptical(int nSampleRate) :
-    GainStage(nSampleRate),
-    nNumberOfDecibels(37),
-    nCoefficientsPerDecibel(2),
-    nNumberOfCoefficients(nNumberOfDecibels * nCoefficientsPerDecibel)
-    /*  Constructor.
+// the optical element's time constants do not depend on the sample
+// rate, so they are calculated at compile time; the tables hold
+// exponents (natural logarithm of the envelope coefficient per second)
+struct OpticalExponents
+{
+    double Attack[GainStageOptical<double>::nNumberOfCoefficients];
+    double Release[GainStageOptical<double>::nNumberOfCoefficients];
+};
 
-        nSampleRate (integer): internal sample rate
 
-        return value: none
-    */
+static constexpr OpticalExponents calculateOpticalExponents()
 {
-    dSampleRate = (double) nSampleRate;
+    OpticalExponents exponents {};
 
-    for (int nCoefficient = 0; nCoefficient < nNumberOfCoefficients; ++nCoefficient)
+    // logarithmic envelopes that reach 73% of the final reading in
+    // the given attack time (natural logarithm of 0.27)
+    const double dLogarithm = -1.3093333199837622;
+
+    for (int nCoefficient = 0; nCoefficient < GainStageOptical<double>::nNumberOfCoefficients; ++nCoefficient)
     {
         //  0 dB:  Attack: 16 ms, Release: 160 ms
         //  6 dB:  Attack:  5 ms, Release:  53 ms
@@ -48,34 +52,131 @@ GainStageOptical::GainStageOptical(int nSampleRate) :
         // 18 dB:  Attack:  2 ms, Release:  23 ms
         // 24 dB:  Attack:  2 ms, Release:  18 ms
 
-        double dDecibels = double(nCoefficient) / double(nCoefficientsPerDecibel);
+        double dDecibels = double(nCoefficient) / double(GainStageOptical<double>::nCoefficientsPerDecibel);
         double dResistance = 480.0 / (3.0 + dDecibels);
-        double dAttackRate = dResistance / 10.0;
-        double dReleaseRate = dResistance;
+        double dAttackRateSeconds = dResistance / 10.0 / 1000.0;
+        double dReleaseRateSeconds = dResistance / 1000.0;
+
+        exponents.Attack[nCoefficient] = dLogarithm / dAttackRateSeconds;
+        exponents.Release[nCoefficient] = dLogarithm / dReleaseRateSeconds;
+    }
+
+    return exponents;
+}
+
+
+static constexpr OpticalExponents opticalExponents = calculateOpticalExponents();
+
+
+template <typename SampleType>
+constexpr int GainStageOptical<SampleType>::nNumberOfDecibels;
+
+template <typename SampleType>
+constexpr int GainStageOptical<SampleType>::nCoefficientsPerDecibel;
 
-        // if (nCoefficient % (6 * nCoefficientsPerDecibel) == 0)
-        // {
-        //     DBG(String(dDecibels) + " dB:  Attack: " + String(dAttackRate, 1) + " ms, Release: " + String(dReleaseRate, 1) + " ms");
-        // }
+template <typename SampleType>
+constexpr int GainStageOptical<SampleType>::nNumberOfCoefficients;
 
-        double dAttackRateSeconds = dAttackRate / 1000.0;
-        double dReleaseRateSeconds = dReleaseRate / 1000.0;
 
-        // logarithmic envelopes that reach 73% of the final reading
-        // in the given attack time
-        arrAttackCoefficients.add(exp(log(0.27) / (dAttackRateSeconds * dSampleRate)));
-        arrReleaseCoefficients.add(exp(log(0.27) / (dReleaseRateSeconds * dSampleRate)));
+template <typename SampleType>
+GainStageOptical<SampleType>::CoefficientTable::CoefficientTable(double dSampleRateNew) :
+    dSampleRate(dSampleRateNew)
+    /*  Constructor.  Tables are immutable once constructed.
+
+        dSampleRateNew (double): sample rate the coefficients are
+        calculated for
+
+        return value: none
+    */
+{
+    // align table to cache lines (64 bytes)
+    const int nAlignment = 64;
+    const int nNumberOfValues = 2 * nNumberOfCoefficients;
+
+    arrCoefficientStorage.malloc(nNumberOfValues + nAlignment / sizeof(SampleType));
+    arrCoefficients = snapPointerToAlignment(arrCoefficientStorage.getData(), nAlignment);
+
+    for (int nCoefficient = 0; nCoefficient < nNumberOfCoefficients; ++nCoefficient)
+    {
+        arrCoefficients[2 * nCoefficient] = SampleType(
+                                                exp(opticalExponents.Attack[nCoefficient] / dSampleRate));
+        arrCoefficients[2 * nCoefficient + 1] = SampleType(
+                exp(opticalExponents.Release[nCoefficient] / dSampleRate));
     }
+}
+
+
+template <typename SampleType>
+typename GainStageOptical<SampleType>::CoefficientTable::Ptr
+GainStageOptical<SampleType>::getCoefficientTable(double dSampleRate)
+/*  Get coefficient table for a sample rate.  Tables are shared by all
+    gain stages of this process; they are only calculated if no gain
+    stage uses the requested sample rate yet.
+
+    dSampleRate (double): sample rate
+
+    return value (CoefficientTable::Ptr): coefficient table
+*/
+{
+    static CriticalSection cacheLock;
+    static ReferenceCountedArray<CoefficientTable> cachedTables;
+
+    const ScopedLock lock(cacheLock);
+
+    typename CoefficientTable::Ptr coefficientTableFound;
+
+    // walk backwards so that tables can be removed on the fly
+    for (int nTable = cachedTables.size() - 1; nTable >= 0; --nTable)
+    {
+        CoefficientTable *table = cachedTables.getObjectPointerUnchecked(nTable);
+
+        if (table->dSampleRate == dSampleRate)
+        {
+            coefficientTableFound = table;
+        }
+        // drop tables that are only referenced by the cache; nobody
+        // else can get hold of them without taking the lock
+        else if (table->getReferenceCount() == 1)
+        {
+            cachedTables.remove(nTable);
+        }
+    }
+
+    if (coefficientTableFound == nullptr)
+    {
+        coefficientTableFound = new CoefficientTable(dSampleRate);
+        cachedTables.add(coefficientTableFound);
+    }
+
+    return coefficientTableFound;
+}
+
+
+template <typename SampleType>
+GainStageOptical<SampleType>::GainStageOptical(int nSampleRate) :
+    GainStage<SampleType>(nSampleRate)
+    /*  Constructor.
+
+        nSampleRate (integer): internal sample rate
+
+        return value: none
+    */
+{
+    dSampleRate = (double) nSampleRate;
+
+    coefficientTable = getCoefficientTable(dSampleRate);
+    arrCoefficients = coefficientTable->getCoefficients();
 
     // reset (i.e. initialise) all relevant variables
-    reset(0.0);
+    reset(SampleType(0.0));
 }
 
 
-void GainStageOptical::reset(double dCurrentGainReduction)
+template <typename SampleType>
+void GainStageOptical<SampleType>::reset(SampleType dCurrentGainReduction)
 /*  Reset all relevant variables.
 
-    dCurrentGainReduction (double): current gain reduction in decibels
+    dCurrentGainReduction (SampleType): current gain reduction in decibels
 
     return value: none
 */
@@ -84,58 +185,132 @@ void GainStageOptical::reset(double dCurrentGainReduction)
 }
 
 
-double GainStageOptical::processGainReduction(double dGainReductionNew, double dGainReductionIdeal)
+template <typename SampleType>
+SampleType GainStageOptical<SampleType>::processGainReduction(SampleType dGainReductionNew, SampleType dGainReductionIdeal)
 /*  Process current gain reduction.
 
-    dGainReductionNew (double): calculated new gain reduction in
+    dGainReductionNew (SampleType): calculated new gain reduction in
     decibels
 
-    dGainReductionIdeal (double): calculated "ideal" gain reduction
-    (without any envelopes) decibels
+    dGainReductionIdeal (SampleType): calculated "ideal" gain
+    reduction (without any envelopes) decibels
 
-    return value (double): returns the processed gain reduction in
+    return value (SampleType): returns the processed gain reduction in
     decibel
  */
 {
-    double dGainReductionOld = dGainReduction;
-    double dCoefficient = dGainReductionNew;
-    int nCoefficient = int(dCoefficient * double(nCoefficientsPerDecibel));
+    SampleType dAttackCoefficient;
+    SampleType dReleaseCoefficient;
 
-    if (nCoefficient < 0)
-    {
-        nCoefficient = 0;
-    }
-    else if (nCoefficient > (nNumberOfCoefficients - 1))
+    lookUpCoefficients(dGainReductionNew, dAttackCoefficient, dReleaseCoefficient);
+
+    return applyEnvelope(dGainReductionNew, dGainReductionIdeal,
+                         dAttackCoefficient, dReleaseCoefficient);
+}
+
+
+template <typename SampleType>
+void GainStageOptical<SampleType>::processGainReduction(
+    const SampleType *dGainReductionsNew,
+    const SampleType *dGainReductionsIdeal,
+    SampleType *dGainReductions,
+    SampleType *dGainReductionsRepeated,
+    int nNumSamples)
+/*  Process a block of gain reductions.  Input and output arrays may
+    be the same.
+
+    dGainReductionsNew (pointer to SampleType): calculated new gain
+    reductions in decibels
+
+    dGainReductionsIdeal (pointer to SampleType): calculated "ideal"
+    gain reductions (without any envelopes) in decibels
+
+    dGainReductions (pointer to SampleType): receives the processed
+    gain reductions in decibels
+
+    dGainReductionsRepeated (pointer to SampleType): if not nullptr,
+    every sample is processed a second time (like the side chain does
+    when reading gain reduction with and without make-up gain) and
+    this array receives the result
+
+    nNumSamples (integer): number of samples to process
+
+    return value: none
+ */
+{
+    for (int nSample = 0; nSample < nNumSamples; ++nSample)
     {
-        nCoefficient = (nNumberOfCoefficients - 1);
+        SampleType dGainReductionNew = dGainReductionsNew[nSample];
+        SampleType dGainReductionIdeal = dGainReductionsIdeal[nSample];
+
+        // coefficients only depend on the input, so they are looked
+        // up once and outside of the envelope's feedback loop
+        SampleType dAttackCoefficient;
+        SampleType dReleaseCoefficient;
+
+        lookUpCoefficients(dGainReductionNew, dAttackCoefficient, dReleaseCoefficient);
+
+        dGainReductions[nSample] = applyEnvelope(
+                                       dGainReductionNew, dGainReductionIdeal,
+                                       dAttackCoefficient, dReleaseCoefficient);
+
+        if (dGainReductionsRepeated != nullptr)
+        {
+            dGainReductionsRepeated[nSample] = applyEnvelope(
+                                                   dGainReductionNew, dGainReductionIdeal,
+                                                   dAttackCoefficient, dReleaseCoefficient);
+        }
     }
+}
 
-    if (dGainReductionNew > dGainReduction)
-    {
-        // algorithm adapted from Giannoulis et al., "Digital Dynamic
-        // Range Compressor Design - A Tutorial and Analysis", JAES,
-        // 60(6):399-408, 2012
 
-        dGainReduction = (arrAttackCoefficients[nCoefficient] * dGainReductionOld) + (1.0 - arrAttackCoefficients[nCoefficient]) * dGainReductionNew;
-    }
-    // otherwise, apply release rate if proposed gain reduction is
-    // below old gain reduction
-    else
-    {
-        // algorithm adapted from Giannoulis et al., "Digital Dynamic
-        // Range Compressor Design - A Tutorial and Analysis", JAES,
-        // 60(6):399-408, 2012
+template <typename SampleType>
+inline void GainStageOptical<SampleType>::lookUpCoefficients(
+    SampleType dGainReductionNew,
+    SampleType &dAttackCoefficient,
+    SampleType &dReleaseCoefficient)
+{
+    // position in coefficient table (gain reductions outside of
+    // table are clamped)
+    SampleType dPosition = dGainReductionNew * SampleType(nCoefficientsPerDecibel);
+    dPosition = jlimit(SampleType(0.0), SampleType(nNumberOfCoefficients - 1), dPosition);
 
-        dGainReduction = (arrReleaseCoefficients[nCoefficient] * dGainReductionOld) + (1.0 - arrReleaseCoefficients[nCoefficient]) * dGainReductionNew;
-    }
+    int nCoefficient = jmin(int(dPosition), nNumberOfCoefficients - 2);
+    SampleType dFraction = dPosition - SampleType(nCoefficient);
+
+    // interpolate linearly between neighbouring coefficients
+    const SampleType *arrNodes = arrCoefficients + 2 * nCoefficient;
+
+    dAttackCoefficient = arrNodes[0] + dFraction * (arrNodes[2] - arrNodes[0]);
+    dReleaseCoefficient = arrNodes[1] + dFraction * (arrNodes[3] - arrNodes[1]);
+}
+
+
+template <typename SampleType>
+inline SampleType GainStageOptical<SampleType>::applyEnvelope(
+    SampleType dGainReductionNew,
+    SampleType dGainReductionIdeal,
+    SampleType dAttackCoefficient,
+    SampleType dReleaseCoefficient)
+{
+    SampleType dGainReductionOld = dGainReduction;
+
+    // apply attack rate if proposed gain reduction is above old gain
+    // reduction; otherwise, apply release rate
+    SampleType dCoefficient = (dGainReductionNew > dGainReductionOld) ? dAttackCoefficient : dReleaseCoefficient;
+
+    // algorithm adapted from Giannoulis et al., "Digital Dynamic
+    // Range Compressor Design - A Tutorial and Analysis", JAES,
+    // 60(6):399-408, 2012
+    dGainReduction = (dCoefficient * dGainReductionOld) + (SampleType(1.0) - dCoefficient) * dGainReductionNew;
 
     // saturation of optical element
     if (dGainReduction < dGainReductionIdeal)
     {
-        double dDiff = dGainReductionIdeal - dGainReduction;
-        double dLimit = 24.0;
+        SampleType dDiff = dGainReductionIdeal - dGainReduction;
+        SampleType dLimit = SampleType(24.0);
 
-        dDiff = dLimit - dLimit / (1.0 + dDiff / dLimit);
+        dDiff = dLimit - dLimit / (SampleType(1.0) + dDiff / dLimit);
         return dGainReductionIdeal - dDiff;
     }
     else
@@ -143,3 +318,8 @@ double GainStageOptical::processGainReduction(double dGainReductionNew, double d
         return dGainReduction;
     }
 }
+
+
+// explicit instantiation of all template instances
+template class GainStageOptical<float>;
+template class GainStageOptical<double>;
@@ -30,26 +30,79 @@
 #include "gain_stage.h"
 
 
-class GainStageOptical : virtual public GainStage
+// number of envelope coefficients per decibel of gain reduction;
+// coefficients are interpolated, so this only changes how closely
+// the tables follow the model of the optical element
+#ifndef SQUEEZER_OPTICAL_COEFFICIENTS_PER_DECIBEL
+#define SQUEEZER_OPTICAL_COEFFICIENTS_PER_DECIBEL 4
+#endif
+
+
+template <typename SampleType>
+class GainStageOptical : virtual public GainStage<SampleType>
 {
 public:
     explicit GainStageOptical(int nSampleRate);
 
-    void reset(double dCurrentGainReduction);
-    double processGainReduction(double dGainReductionNew, double dGainReductionIdeal);
+    void reset(SampleType dCurrentGainReduction);
+    SampleType processGainReduction(SampleType dGainReductionNew, SampleType dGainReductionIdeal);
+
+    void processGainReduction(const SampleType *dGainReductionsNew,
+                              const SampleType *dGainReductionsIdeal,
+                              SampleType *dGainReductions,
+                              SampleType *dGainReductionsRepeated,
+                              int nNumSamples);
+
+    // coefficients cover gain reductions from 0 to 37 dB
+    static constexpr int nNumberOfDecibels = 37;
+    static constexpr int nCoefficientsPerDecibel = SQUEEZER_OPTICAL_COEFFICIENTS_PER_DECIBEL;
+    static constexpr int nNumberOfCoefficients = nNumberOfDecibels * nCoefficientsPerDecibel + 1;
 
 private:
     JUCE_LEAK_DETECTOR(GainStageOptical);
 
-    double dSampleRate;
-    double dGainReduction;
+    inline void lookUpCoefficients(SampleType dGainReductionNew,
+                                   SampleType &dAttackCoefficient,
+                                   SampleType &dReleaseCoefficient);
+
+    inline SampleType applyEnvelope(SampleType dGainReductionNew,
+                                    SampleType dGainReductionIdeal,
+                                    SampleType dAttackCoefficient,
+                                    SampleType dReleaseCoefficient);
+
+    // immutable table of envelope coefficients for a single sample
+    // rate; attack and release coefficients are interleaved, so that
+    // an interpolated look-up reads a single cache line
+    class CoefficientTable :
+        public ReferenceCountedObject
+    {
+    public:
+        typedef ReferenceCountedObjectPtr<CoefficientTable> Ptr;
 
-    const int nNumberOfDecibels;
-    const int nCoefficientsPerDecibel;
-    const int nNumberOfCoefficients;
+        explicit CoefficientTable(double dSampleRateNew);
+
+        const SampleType *getCoefficients() const
+        {
+            return arrCoefficients;
+        }
+
+        const double dSampleRate;
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(CoefficientTable);
+
+        HeapBlock<SampleType> arrCoefficientStorage;
+        SampleType *arrCoefficients;
+    };
+
+    static typename CoefficientTable::Ptr getCoefficientTable(double dSampleRate);
+
+    double dSampleRate;
+    SampleType dGainReduction;
 
-    Array<double> arrAttackCoefficients;
-    Array<double> arrReleaseCoefficients;
+    // shared with all other gain stages running at this sample rate
+    typename CoefficientTable::Ptr coefficientTable;
+    const SampleType *arrCoefficients;
 };
 
 #endif  // SQUEEZER_GAIN_STAGE_OPTICAL_H
@@ -0,0 +1,545 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "loudness_analyser.h"
+
+
+template <typename SampleType>
+LoudnessAnalyser<SampleType>::LoudnessAnalyser(int channels,
+                                               int sample_rate) :
+    Thread("Squeezer loudness meter"),
+    NumberOfChannels(channels),
+    BlockSize(roundToInt(sample_rate / double(BlocksPerSecond))),
+    NumberOfBins((MaximumLoudness - MinimumLoudness) * BinsPerLoudnessUnit),
+    QueuedSlots(NumberOfSlots),
+    WriteSlot(-1),
+    WritePosition(0),
+    SlotSamples(2 * NumberOfChannels, NumberOfSlots * BlockSize),
+    PreFilter(2 * NumberOfChannels),
+    RlbFilter(2 * NumberOfChannels),
+    BlockPowers(2 * ShortTermBlocks),
+    GatingBlockCounts(2 * NumberOfBins),
+    GatingBlockPowers(2 * NumberOfBins),
+    ShortTermCounts(2 * NumberOfBins),
+    ShortTermPowers(2 * NumberOfBins),
+    Results(new Atomic<float>[2 * NumberOfMeasurements])
+{
+    jassert(NumberOfChannels > 0);
+    jassert(BlockSize > 0);
+
+    // K-weighting filters of BS.1770 are specified for 48 kHz; these
+    // analog prototypes reproduce them at any sample rate
+    double SampleRate = double(sample_rate);
+
+    double CutoffFrequency = 1681.974450955533;
+    double Gain = 3.999843853973347;
+    double Quality = 0.7071752369554196;
+
+    double K = std::tan(MathConstants<double>::pi * CutoffFrequency / SampleRate);
+    double Vh = std::pow(10.0, Gain / 20.0);
+    double Vb = std::pow(Vh, 0.4996667741545416);
+    double A0 = 1.0 + K / Quality + K * K;
+
+    PreFilter.setCoefficients(
+        (Vh + Vb * K / Quality + K * K) / A0,
+        2.0 * (K * K - Vh) / A0,
+        (Vh - Vb * K / Quality + K * K) / A0,
+        2.0 * (K * K - 1.0) / A0,
+        (1.0 - K / Quality + K * K) / A0);
+
+    CutoffFrequency = 38.13547087602444;
+    Quality = 0.5003270373238773;
+
+    K = std::tan(MathConstants<double>::pi * CutoffFrequency / SampleRate);
+    A0 = 1.0 + K / Quality + K * K;
+
+    RlbFilter.setCoefficients(
+        1.0,
+        -2.0,
+        1.0,
+        2.0 * (K * K - 1.0) / A0,
+        (1.0 - K / Quality + K * K) / A0);
+
+    clearMeasurements();
+}
+
+
+template <typename SampleType>
+LoudnessAnalyser<SampleType>::~LoudnessAnalyser()
+{
+    stopThread(1000);
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::start()
+/*  Discard queued blocks and all measurements, and start background
+    thread.  Must not be called while samples are pushed.
+
+    return value: none
+ */
+{
+    QueuedSlots.reset();
+    WriteSlot = -1;
+    WritePosition = 0;
+
+    ResetRequested = 0;
+    clearMeasurements();
+
+    // meters are not important enough to compete with anything else
+    startThread(1);
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::stop()
+/*  Stop background thread.  Blocks until the thread has exited, so
+    do not call this function on the audio thread!
+
+    return value: none
+ */
+{
+    stopThread(1000);
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::reset()
+/*  Clear all measurements (including integrated loudness and
+    loudness range).  Lock-free; measurements are cleared by the
+    background thread before it analyses the next block.
+
+    return value: none
+ */
+{
+    ResetRequested = 1;
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::push(
+    const AudioBuffer<SampleType> &InputBuffer,
+    const AudioBuffer<SampleType> &OutputBuffer,
+    int NumberOfSamples)
+/*  Add samples to current block; full blocks are queued for
+    analysis.  Lock-free; must only be called by a single writer
+    (usually the audio thread).
+
+    InputBuffer (AudioBuffer): input samples
+
+    OutputBuffer (AudioBuffer): output samples
+
+    NumberOfSamples (integer): number of samples to add
+
+    return value: none
+ */
+{
+    jassert(InputBuffer.getNumSamples() >= NumberOfSamples);
+    jassert(OutputBuffer.getNumSamples() >= NumberOfSamples);
+
+    int StartSample = 0;
+
+    while (StartSample < NumberOfSamples)
+    {
+        // start new block
+        if (WritePosition == 0)
+        {
+            int StartIndex1, BlockSize1, StartIndex2, BlockSize2;
+            QueuedSlots.prepareToWrite(1, StartIndex1, BlockSize1,
+                                       StartIndex2, BlockSize2);
+
+            // drop block when the worker has fallen behind
+            WriteSlot = (BlockSize1 > 0) ? StartIndex1 : -1;
+        }
+
+        // copy samples up to the end of the block
+        int SamplesToCopy = jmin(NumberOfSamples - StartSample,
+                                 BlockSize - WritePosition);
+
+        if (WriteSlot >= 0)
+        {
+            int SlotSample = WriteSlot * BlockSize + WritePosition;
+
+            for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+            {
+                SlotSamples.copyFrom(CurrentChannel, SlotSample,
+                                     InputBuffer, CurrentChannel,
+                                     StartSample, SamplesToCopy);
+
+                SlotSamples.copyFrom(NumberOfChannels + CurrentChannel, SlotSample,
+                                     OutputBuffer, CurrentChannel,
+                                     StartSample, SamplesToCopy);
+            }
+        }
+
+        WritePosition += SamplesToCopy;
+        StartSample += SamplesToCopy;
+
+        // queue full block
+        if (WritePosition == BlockSize)
+        {
+            WritePosition = 0;
+
+            if (WriteSlot >= 0)
+            {
+                QueuedSlots.finishedWrite(1);
+            }
+        }
+    }
+}
+
+
+template <typename SampleType>
+float LoudnessAnalyser<SampleType>::getInputLoudness(int Measurement)
+/*  Get latest loudness measurement of input.  Lock-free.
+
+    Measurement (integer): selected measurement (see Measurements)
+
+    return value (float): returns loudness in LUFS (never lower than
+    the absolute gate) or loudness range in LU
+*/
+{
+    jassert(Measurement >= 0);
+    jassert(Measurement < NumberOfMeasurements);
+
+    return Results[Measurement].get();
+}
+
+
+template <typename SampleType>
+float LoudnessAnalyser<SampleType>::getOutputLoudness(int Measurement)
+/*  Get latest loudness measurement of output.  Lock-free.
+
+    Measurement (integer): selected measurement (see Measurements)
+
+    return value (float): returns loudness in LUFS (never lower than
+    the absolute gate) or loudness range in LU
+*/
+{
+    jassert(Measurement >= 0);
+    jassert(Measurement < NumberOfMeasurements);
+
+    return Results[NumberOfMeasurements + Measurement].get();
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::run()
+{
+    while (!threadShouldExit())
+    {
+        if (ResetRequested.compareAndSetBool(0, 1))
+        {
+            clearMeasurements();
+        }
+
+        int StartIndex1, BlockSize1, StartIndex2, BlockSize2;
+        QueuedSlots.prepareToRead(1, StartIndex1, BlockSize1,
+                                  StartIndex2, BlockSize2);
+
+        // polling keeps the audio thread from having to wake up this
+        // thread (which might block)
+        if (BlockSize1 == 0)
+        {
+            wait(PollingIntervalMilliSeconds);
+            continue;
+        }
+
+        analyseSlot(StartIndex1);
+        QueuedSlots.finishedRead(1);
+    }
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::clearMeasurements()
+{
+    PreFilter.resetDelays();
+    RlbFilter.resetDelays();
+
+    BlockPowers.clear(2 * ShortTermBlocks);
+    BlockIndex = 0;
+    NumberOfBlocks = 0;
+
+    GatingBlockCounts.clear(2 * NumberOfBins);
+    GatingBlockPowers.clear(2 * NumberOfBins);
+
+    ShortTermCounts.clear(2 * NumberOfBins);
+    ShortTermPowers.clear(2 * NumberOfBins);
+
+    for (int Signal = 0; Signal < 2; ++Signal)
+    {
+        int Offset = Signal * NumberOfMeasurements;
+
+        Results[Offset + MomentaryLoudness] = float(MinimumLoudness);
+        Results[Offset + ShortTermLoudness] = float(MinimumLoudness);
+        Results[Offset + IntegratedLoudness] = float(MinimumLoudness);
+        Results[Offset + LoudnessRange] = 0.0f;
+    }
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::analyseSlot(int Slot)
+{
+    int StartSample = Slot * BlockSize;
+
+    for (int Signal = 0; Signal < 2; ++Signal)
+    {
+        double BlockPower = 0.0;
+
+        for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+        {
+            int FilterChannel = Signal * NumberOfChannels + CurrentChannel;
+            const SampleType *Samples = SlotSamples.getReadPointer(
+                                            FilterChannel, StartSample);
+
+            double SumOfSquares = 0.0;
+
+            for (int Sample = 0; Sample < BlockSize; ++Sample)
+            {
+                double WeightedSample = double(Samples[Sample]);
+
+                PreFilter.processSample(WeightedSample, FilterChannel);
+                RlbFilter.processSample(WeightedSample, FilterChannel);
+
+                SumOfSquares += WeightedSample * WeightedSample;
+            }
+
+            // left, right and mono channels are weighted equally
+            BlockPower += SumOfSquares / BlockSize;
+        }
+
+        BlockPowers[Signal * ShortTermBlocks + BlockIndex] = BlockPower;
+    }
+
+    BlockIndex = (BlockIndex + 1) % ShortTermBlocks;
+    NumberOfBlocks = jmin(NumberOfBlocks + 1, int(ShortTermBlocks));
+
+    for (int Signal = 0; Signal < 2; ++Signal)
+    {
+        updateMeasurements(Signal);
+    }
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::updateMeasurements(int Signal)
+{
+    int Offset = Signal * NumberOfMeasurements;
+
+    // gating blocks are only complete after 400 ms
+    if (NumberOfBlocks >= MomentaryBlocks)
+    {
+        double Power = getAveragePower(Signal, MomentaryBlocks);
+        double Loudness = jmax(power2loudness(Power), double(MinimumLoudness));
+
+        Results[Offset + MomentaryLoudness] = float(Loudness);
+
+        addToHistogram(GatingBlockCounts, GatingBlockPowers, Signal, Power);
+        Results[Offset + IntegratedLoudness] = float(calculateIntegratedLoudness(Signal));
+    }
+
+    if (NumberOfBlocks >= ShortTermBlocks)
+    {
+        double Power = getAveragePower(Signal, ShortTermBlocks);
+        double Loudness = jmax(power2loudness(Power), double(MinimumLoudness));
+
+        Results[Offset + ShortTermLoudness] = float(Loudness);
+
+        addToHistogram(ShortTermCounts, ShortTermPowers, Signal, Power);
+        Results[Offset + LoudnessRange] = float(calculateLoudnessRange(Signal));
+    }
+}
+
+
+template <typename SampleType>
+double LoudnessAnalyser<SampleType>::getAveragePower(
+    int Signal,
+    int NumberOfBlocksToAverage)
+{
+    double SumOfPowers = 0.0;
+
+    // latest block was stored just before the current block index
+    for (int Block = 1; Block <= NumberOfBlocksToAverage; ++Block)
+    {
+        int Index = (BlockIndex - Block + ShortTermBlocks) % ShortTermBlocks;
+        SumOfPowers += BlockPowers[Signal * ShortTermBlocks + Index];
+    }
+
+    return SumOfPowers / NumberOfBlocksToAverage;
+}
+
+
+template <typename SampleType>
+void LoudnessAnalyser<SampleType>::addToHistogram(
+    HeapBlock<int> &Counts,
+    HeapBlock<double> &Powers,
+    int Signal,
+    double Power)
+{
+    // absolute gate
+    if (power2loudness(Power) <= MinimumLoudness)
+    {
+        return;
+    }
+
+    // histograms keep the sum of powers of each bin, so gated
+    // averages do not suffer from the limited resolution
+    int Index = Signal * NumberOfBins + loudness2bin(power2loudness(Power));
+
+    Counts[Index] += 1;
+    Powers[Index] += Power;
+}
+
+
+template <typename SampleType>
+double LoudnessAnalyser<SampleType>::calculateIntegratedLoudness(int Signal)
+{
+    int *Counts = GatingBlockCounts + Signal * NumberOfBins;
+    double *Powers = GatingBlockPowers + Signal * NumberOfBins;
+
+    int NumberOfGatingBlocks = 0;
+    double SumOfPowers = 0.0;
+
+    for (int Bin = 0; Bin < NumberOfBins; ++Bin)
+    {
+        NumberOfGatingBlocks += Counts[Bin];
+        SumOfPowers += Powers[Bin];
+    }
+
+    if (NumberOfGatingBlocks == 0)
+    {
+        return double(MinimumLoudness);
+    }
+
+    // relative gate (10 LU below the loudness of all gating blocks
+    // above the absolute gate); resolution is limited to a single
+    // histogram bin
+    double RelativeGate = power2loudness(SumOfPowers / NumberOfGatingBlocks) - 10.0;
+
+    NumberOfGatingBlocks = 0;
+    SumOfPowers = 0.0;
+
+    for (int Bin = loudness2bin(RelativeGate); Bin < NumberOfBins; ++Bin)
+    {
+        NumberOfGatingBlocks += Counts[Bin];
+        SumOfPowers += Powers[Bin];
+    }
+
+    return jmax(power2loudness(SumOfPowers / NumberOfGatingBlocks),
+                double(MinimumLoudness));
+}
+
+
+template <typename SampleType>
+double LoudnessAnalyser<SampleType>::calculateLoudnessRange(int Signal)
+{
+    int *Counts = ShortTermCounts + Signal * NumberOfBins;
+    double *Powers = ShortTermPowers + Signal * NumberOfBins;
+
+    int NumberOfValues = 0;
+    double SumOfPowers = 0.0;
+
+    for (int Bin = 0; Bin < NumberOfBins; ++Bin)
+    {
+        NumberOfValues += Counts[Bin];
+        SumOfPowers += Powers[Bin];
+    }
+
+    if (NumberOfValues == 0)
+    {
+        return 0.0;
+    }
+
+    // EBU Tech 3342: relative gate lies 20 LU below the loudness of
+    // all short-term values above the absolute gate
+    int FirstBin = loudness2bin(
+                       power2loudness(SumOfPowers / NumberOfValues) - 20.0);
+
+    NumberOfValues = 0;
+
+    for (int Bin = FirstBin; Bin < NumberOfBins; ++Bin)
+    {
+        NumberOfValues += Counts[Bin];
+    }
+
+    // loudness range spans the 10th to the 95th percentile
+    int LowerRank = roundToInt((NumberOfValues - 1) * 0.10);
+    int UpperRank = roundToInt((NumberOfValues - 1) * 0.95);
+
+    int LowerBin = -1;
+    int UpperBin = -1;
+    int Rank = 0;
+
+    for (int Bin = FirstBin; Bin < NumberOfBins; ++Bin)
+    {
+        Rank += Counts[Bin];
+
+        if ((LowerBin < 0) && (Rank > LowerRank))
+        {
+            LowerBin = Bin;
+        }
+
+        if (Rank > UpperRank)
+        {
+            UpperBin = Bin;
+            break;
+        }
+    }
+
+    return bin2loudness(UpperBin) - bin2loudness(LowerBin);
+}
+
+
+template <typename SampleType>
+double LoudnessAnalyser<SampleType>::power2loudness(double Power)
+{
+    // prevent log of zero
+    return -0.691 + 10.0 * std::log10(jmax(Power, 1e-20));
+}
+
+
+template <typename SampleType>
+int LoudnessAnalyser<SampleType>::loudness2bin(double Loudness)
+{
+    int Bin = int(std::floor((Loudness - MinimumLoudness) * BinsPerLoudnessUnit));
+
+    // loudness values above histogram range end up in the last bin
+    return jlimit(0, (MaximumLoudness - MinimumLoudness) * BinsPerLoudnessUnit - 1, Bin);
+}
+
+
+template <typename SampleType>
+double LoudnessAnalyser<SampleType>::bin2loudness(int Bin)
+{
+    // centre of bin
+    return MinimumLoudness + (Bin + 0.5) / BinsPerLoudnessUnit;
+}
+
+
+// explicit instantiation of all template instances
+template class LoudnessAnalyser<float>;
+template class LoudnessAnalyser<double>;
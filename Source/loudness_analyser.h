@@ -0,0 +1,154 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_LOUDNESS_ANALYSER_H
+#define SQUEEZER_LOUDNESS_ANALYSER_H
+
+#include "FrutHeader.h"
+
+
+// measures loudness (ITU-R BS.1770, EBU R 128) on a low-priority
+// background thread; the audio thread collects samples in blocks of
+// 100 ms and hands them over through a lock-free FIFO, so it neither
+// waits for K-weighting and gating nor allocates memory; the thread
+// only runs between "start" and "stop"
+template <typename SampleType>
+class LoudnessAnalyser :
+    private Thread
+{
+public:
+    enum Parameters  // public namespace!
+    {
+        // gating blocks overlap by 75 %, so all measurements are
+        // updated every 100 ms
+        BlocksPerSecond = 10,
+
+        // momentary loudness: 400 ms; short-term loudness: 3 s
+        MomentaryBlocks = 4,
+        ShortTermBlocks = 30,
+
+        // absolute gate and range of histograms (in LUFS)
+        MinimumLoudness = -70,
+        MaximumLoudness = 10,
+
+        // resolution of histograms (bins per LU)
+        BinsPerLoudnessUnit = 10,
+
+        // blocks that may be queued (dropped when exceeded)
+        NumberOfSlots = 8,
+
+        // time between checks for queued blocks
+        PollingIntervalMilliSeconds = 20,
+    };
+
+    enum Measurements  // public namespace!
+    {
+        MomentaryLoudness = 0,
+        ShortTermLoudness,
+        IntegratedLoudness,
+        LoudnessRange,
+        NumberOfMeasurements,
+    };
+
+    LoudnessAnalyser(int channels,
+                     int sample_rate);
+    ~LoudnessAnalyser();
+
+    void start();
+    void stop();
+    void reset();
+
+    void push(const AudioBuffer<SampleType> &InputBuffer,
+              const AudioBuffer<SampleType> &OutputBuffer,
+              int NumberOfSamples);
+
+    float getInputLoudness(int Measurement);
+    float getOutputLoudness(int Measurement);
+
+private:
+    JUCE_LEAK_DETECTOR(LoudnessAnalyser);
+
+    void run() override;
+    void clearMeasurements();
+    void analyseSlot(int Slot);
+    void updateMeasurements(int Signal);
+
+    double getAveragePower(int Signal, int NumberOfBlocksToAverage);
+
+    void addToHistogram(HeapBlock<int> &Counts,
+                        HeapBlock<double> &Powers,
+                        int Signal,
+                        double Power);
+
+    double calculateIntegratedLoudness(int Signal);
+    double calculateLoudnessRange(int Signal);
+
+    static double power2loudness(double Power);
+    static int loudness2bin(double Loudness);
+    static double bin2loudness(int Bin);
+
+    const int NumberOfChannels;
+    const int BlockSize;
+    const int NumberOfBins;
+
+    AbstractFifo QueuedSlots;
+
+    // slot that is currently filled by the writer (negative while
+    // samples are dropped) and number of samples written to it
+    int WriteSlot;
+    int WritePosition;
+
+    // input channels followed by output channels; holds one block
+    // per slot
+    AudioBuffer<SampleType> SlotSamples;
+
+    // K-weighting: pre-filter (acoustic effects of the head) followed
+    // by RLB weighting curve (high-pass)
+    frut::dsp::BiquadFilter PreFilter;
+    frut::dsp::BiquadFilter RlbFilter;
+
+    // mean squares of the latest blocks (ring buffers of input and
+    // output; both signals are always analysed together)
+    HeapBlock<double> BlockPowers;
+    int BlockIndex;
+    int NumberOfBlocks;
+
+    // histograms of loudness values above the absolute gate (input
+    // followed by output); gating blocks are integrated, short-term
+    // values determine the loudness range
+    HeapBlock<int> GatingBlockCounts;
+    HeapBlock<double> GatingBlockPowers;
+
+    HeapBlock<int> ShortTermCounts;
+    HeapBlock<double> ShortTermPowers;
+
+    // measurements are cleared by the background thread
+    Atomic<int> ResetRequested;
+
+    // input measurements followed by output measurements
+    std::unique_ptr<Atomic<float>[]> Results;
+};
+
+#endif  // SQUEEZER_LOUDNESS_ANALYSER_H
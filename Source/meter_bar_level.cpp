@@ -48,12 +48,14 @@ void MeterBarLevel::create(int crestFactor,
         int segmentHeight;
         int spacingBefore = 0;
 
-        if (trueLowerThreshold >= -80)
+        // colours depend on level relative to the reference level
+        // (overload: above +12 dB, warning: between 0 and +12 dB)
+        if (lowerThreshold >= 120)
         {
             colourId = colourSelector::overload;
             segmentHeight = mainSegmentHeight;
         }
-        else if (trueLowerThreshold >= -200)
+        else if (lowerThreshold >= 0)
         {
             colourId = colourSelector::warning;
             segmentHeight = mainSegmentHeight;
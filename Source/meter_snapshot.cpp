@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "meter_snapshot.h"
+
+
+MeterSnapshotBuffer::MeterSnapshotBuffer() :
+    SharedIndex(1),
+    WriteIndex(0),
+    ReadIndex(2)
+{
+    for (int Index = 0; Index < 3; ++Index)
+    {
+        for (int Channel = 0; Channel < MeterSnapshot::MaximumNumberOfChannels; ++Channel)
+        {
+            Snapshots[Index].PeakInputLevels[Channel] = -100.0f;
+            Snapshots[Index].PeakOutputLevels[Channel] = -100.0f;
+
+            Snapshots[Index].AverageInputLevels[Channel] = -100.0f;
+            Snapshots[Index].AverageOutputLevels[Channel] = -100.0f;
+
+            Snapshots[Index].TruePeakInputLevels[Channel] = -100.0f;
+            Snapshots[Index].TruePeakOutputLevels[Channel] = -100.0f;
+
+            Snapshots[Index].GainReduction[Channel] = 0.0f;
+        }
+    }
+}
+
+
+MeterSnapshot &MeterSnapshotBuffer::getWriteSnapshot()
+/*  Get snapshot that may be filled by the writer.  Must only be
+    called by the writer.
+
+    return value (MeterSnapshot): snapshot that is not accessed by the
+    reader
+ */
+{
+    return Snapshots[WriteIndex];
+}
+
+
+void MeterSnapshotBuffer::publish()
+/*  Hand the snapshot returned by getWriteSnapshot() to the reader.
+    Must only be called by the writer.
+
+    return value: none
+ */
+{
+    // swap written snapshot with shared snapshot (any unread data in
+    // the shared snapshot is outdated and will be overwritten)
+    int OldSharedIndex = SharedIndex.exchange(WriteIndex | IsNewFlag);
+    WriteIndex = OldSharedIndex & IndexMask;
+}
+
+
+bool MeterSnapshotBuffer::read(MeterSnapshot &Snapshot)
+/*  Copy latest published snapshot.  Must only be called by the
+    reader.
+
+    Snapshot (MeterSnapshot): receives latest snapshot (only changed
+    when a new snapshot has been published)
+
+    return value (boolean): returns true if a new snapshot has been
+    published since the last call
+ */
+{
+    if ((SharedIndex.get() & IsNewFlag) == 0)
+    {
+        return false;
+    }
+
+    // swap read snapshot with shared snapshot
+    int OldSharedIndex = SharedIndex.exchange(ReadIndex);
+    ReadIndex = OldSharedIndex & IndexMask;
+
+    Snapshot = Snapshots[ReadIndex];
+    return true;
+}
@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_METER_SNAPSHOT_H
+#define SQUEEZER_METER_SNAPSHOT_H
+
+#include "FrutHeader.h"
+
+
+// meter readings of all channels at a given time
+struct MeterSnapshot
+{
+    enum Parameters  // public namespace!
+    {
+        MaximumNumberOfChannels = 2,
+    };
+
+    float PeakInputLevels[MaximumNumberOfChannels];
+    float PeakOutputLevels[MaximumNumberOfChannels];
+
+    float AverageInputLevels[MaximumNumberOfChannels];
+    float AverageOutputLevels[MaximumNumberOfChannels];
+
+    // meter minimum while true-peak meters are disabled
+    float TruePeakInputLevels[MaximumNumberOfChannels];
+    float TruePeakOutputLevels[MaximumNumberOfChannels];
+
+    float GainReduction[MaximumNumberOfChannels];
+};
+
+
+// lock-free triple buffer that hands meter snapshots from the audio
+// thread (single writer) to the editor (single reader); neither side
+// ever waits for or allocates memory
+class MeterSnapshotBuffer
+{
+public:
+    MeterSnapshotBuffer();
+
+    MeterSnapshot &getWriteSnapshot();
+    void publish();
+
+    bool read(MeterSnapshot &Snapshot);
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(MeterSnapshotBuffer);
+
+    enum Flags  // private namespace!
+    {
+        IndexMask = 0x03,
+        IsNewFlag = 0x04,
+    };
+
+    MeterSnapshot Snapshots[3];
+
+    // index of snapshot that is not currently accessed by writer or
+    // reader (and flag that tells whether it contains unread data)
+    Atomic<int> SharedIndex;
+
+    int WriteIndex;
+    int ReadIndex;
+};
+
+#endif  // SQUEEZER_METER_SNAPSHOT_H
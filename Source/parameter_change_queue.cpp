@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "parameter_change_queue.h"
+
+
+ParameterChangeQueue::ParameterChangeQueue(int number_of_parameters) :
+    NumberOfParameters(number_of_parameters),
+    // capacity is a power of two, so positions stay valid when the
+    // position counter wraps around
+    PositionMask((uint32) nextPowerOfTwo(NumberOfParameters) - 1),
+    DirtyFlags(new Atomic<int>[NumberOfParameters]),
+    Slots(new Atomic<int>[PositionMask + 1]),
+    WritePosition(0),
+    ReadPosition(0)
+{
+    jassert(NumberOfParameters > 0);
+}
+
+
+void ParameterChangeQueue::push(int Index)
+/*  Queue changed parameter.  Lock-free; may be called from any
+    thread, including the audio thread.
+
+    Index (integer): index of changed parameter
+
+    return value: none
+ */
+{
+    jassert(Index >= 0);
+    jassert(Index < NumberOfParameters);
+
+    // parameter has already been queued and not yet been read
+    if (DirtyFlags[Index].exchange(1) != 0)
+    {
+        return;
+    }
+
+    // reserve slot (the number of queued parameters never exceeds
+    // the capacity, so the slot is guaranteed to be empty)
+    uint32 Position = (++WritePosition - 1) & PositionMask;
+    Slots[Position] = Index + 1;
+}
+
+
+bool ParameterChangeQueue::pop(int &Index)
+/*  Get next changed parameter.  Must only be called by the reader.
+
+    Index (integer): receives index of changed parameter
+
+    return value (boolean): returns false if no changed parameter is
+    queued
+ */
+{
+    if (ReadPosition == WritePosition.get())
+    {
+        return false;
+    }
+
+    Atomic<int> &Slot = Slots[ReadPosition & PositionMask];
+    int SlotValue = Slot.get();
+
+    // slot has been reserved, but not yet been written
+    if (SlotValue == 0)
+    {
+        return false;
+    }
+
+    Slot = 0;
+    ++ReadPosition;
+
+    Index = SlotValue - 1;
+
+    // clear flag before the parameter value is read, so that later
+    // changes will be queued again
+    DirtyFlags[Index] = 0;
+
+    return true;
+}
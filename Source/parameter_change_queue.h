@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_PARAMETER_CHANGE_QUEUE_H
+#define SQUEEZER_PARAMETER_CHANGE_QUEUE_H
+
+#include "FrutHeader.h"
+
+
+// lock-free queue of changed parameter indices that is drained by a
+// single reader (the editor); a parameter that has changed several
+// times before the reader gets to see it is only queued once, so the
+// queue can never overflow and never needs to allocate memory
+class ParameterChangeQueue
+{
+public:
+    explicit ParameterChangeQueue(int number_of_parameters);
+
+    void push(int Index);
+    bool pop(int &Index);
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(ParameterChangeQueue);
+
+    const int NumberOfParameters;
+    const uint32 PositionMask;
+
+    // one flag per parameter; set while the parameter is queued
+    std::unique_ptr<Atomic<int>[]> DirtyFlags;
+
+    // parameter index plus one (zero marks an empty slot)
+    std::unique_ptr<Atomic<int>[]> Slots;
+
+    Atomic<uint32> WritePosition;
+    uint32 ReadPosition;
+};
+
+#endif  // SQUEEZER_PARAMETER_CHANGE_QUEUE_H
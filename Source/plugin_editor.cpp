@@ -79,10 +79,12 @@ SqueezerAudioProcessorEditor::SqueezerAudioProcessorEditor(
     // and labels will be set later on in this constructor.
 
     PluginProcessor_ = OwnerFilter;
-    PluginProcessor_->addActionListener(this);
 
     NumberOfChannels_ = NumberOfChannels;
 
+    // scale of level meters depends on the metering standard
+    MeterCrestFactor_ = PluginProcessor_->getMeterCrestFactor();
+
     SliderThreshold_ = std::make_unique<frut::widgets::SliderCombined>(
                            PluginParameters,
                            SqueezerPluginParameters::selThreshold,
@@ -295,12 +297,19 @@ SqueezerAudioProcessorEditor::SqueezerAudioProcessorEditor(
     // apply skin to plug-in editor
     CurrentSkinName_ = PluginProcessor_->getParameterSkinName();
     loadSkin_();
+
+    // meters are only updated while the editor is open
+    PluginProcessor_->addMeterConsumer();
+
+    // poll meter readings at (roughly) the screen's refresh rate
+    startTimerHz(60);
 }
 
 
 SqueezerAudioProcessorEditor::~SqueezerAudioProcessorEditor()
 {
-    PluginProcessor_->removeActionListener(this);
+    stopTimer();
+    PluginProcessor_->removeMeterConsumer();
 
     // release look and feel
     setLookAndFeel(nullptr);
@@ -442,7 +451,6 @@ void SqueezerAudioProcessorEditor::applySkin_()
                         5);
 
     bool IsDiscreteMeter = true;
-    int CrestFactor = 20;
     frut::widgets::Orientation MeterOrientation =
         frut::widgets::Orientation::vertical;
 
@@ -451,7 +459,7 @@ void SqueezerAudioProcessorEditor::applySkin_()
         MeterBarLevel *InputLevelMeter = InputLevelMeters_.add(
                                              new MeterBarLevel());
 
-        InputLevelMeter->create(CrestFactor,
+        InputLevelMeter->create(MeterCrestFactor_,
                                 MeterOrientation,
                                 IsDiscreteMeter,
                                 SegmentHeight,
@@ -462,7 +470,7 @@ void SqueezerAudioProcessorEditor::applySkin_()
         MeterBarLevel *OutputLevelMeter = OutputLevelMeters_.add(
                                               new MeterBarLevel());
 
-        OutputLevelMeter->create(CrestFactor,
+        OutputLevelMeter->create(MeterCrestFactor_,
                                  MeterOrientation,
                                  IsDiscreteMeter,
                                  SegmentHeight,
@@ -480,6 +488,9 @@ void SqueezerAudioProcessorEditor::applySkin_()
             SegmentHeight,
             ColourReduction);
 
+        // clicking a gain reduction meter opens its history
+        GainReductionMeter->addMouseListener(this, false);
+
         addAndMakeVisible(GainReductionMeter);
     }
 
@@ -555,15 +566,14 @@ void SqueezerAudioProcessorEditor::windowSkinCallback(
 }
 
 
-void SqueezerAudioProcessorEditor::actionListenerCallback(
-    const String &Message)
+void SqueezerAudioProcessorEditor::timerCallback()
 {
-    // "PC" ==> parameter changed, followed by a hash and the
-    // parameter's ID
-    if (Message.startsWith("PC#"))
+    int Index;
+
+    // update changed parameters (each parameter is reported only
+    // once, regardless of how often it has changed in the meantime)
+    while (PluginProcessor_->getChangedParameter(Index))
     {
-        String StringIndex = Message.substring(3);
-        int Index = StringIndex.getIntValue();
         jassert(Index >= 0);
         jassert(Index < PluginProcessor_->getNumParameters());
 
@@ -572,49 +582,43 @@ void SqueezerAudioProcessorEditor::actionListenerCallback(
             updateParameter(Index);
         }
     }
-    // "UM" ==> update meters
-    else if (!Message.compare("UM"))
+
+    // prevent meter updates during initialisation
+    if (IsInitialising_)
     {
-        // prevent meter updates during initialisation
-        if (!IsInitialising_)
-        {
-            for (int Channel = 0; Channel < NumberOfChannels_; ++Channel)
-            {
-                float NoPeakDisplay = -100.0;
+        return;
+    }
 
-                float AverageInputLevel =
-                    PluginProcessor_->getAverageMeterInputLevel(Channel);
-                float PeakInputLevel =
-                    PluginProcessor_->getPeakMeterInputLevel(Channel);
+    MeterSnapshot Snapshot;
 
-                InputLevelMeters_[Channel]->setLevels(
-                    AverageInputLevel, NoPeakDisplay,
-                    PeakInputLevel, NoPeakDisplay);
+    // meters only need to be updated when the audio thread has
+    // published new readings
+    if (!PluginProcessor_->getMeterSnapshot(Snapshot))
+    {
+        return;
+    }
 
-                float AverageOutputLevel =
-                    PluginProcessor_->getAverageMeterOutputLevel(Channel);
-                float PeakOutputLevel =
-                    PluginProcessor_->getPeakMeterOutputLevel(Channel);
+    for (int Channel = 0; Channel < NumberOfChannels_; ++Channel)
+    {
+        float NoPeakDisplay = -100.0;
 
-                OutputLevelMeters_[Channel]->setLevels(
-                    AverageOutputLevel, NoPeakDisplay,
-                    PeakOutputLevel, NoPeakDisplay);
+        // peak markers display true-peak levels (if enabled)
+        InputLevelMeters_[Channel]->setLevels(
+            Snapshot.AverageInputLevels[Channel], NoPeakDisplay,
+            Snapshot.PeakInputLevels[Channel],
+            Snapshot.TruePeakInputLevels[Channel]);
 
-                float GainReduction =
-                    PluginProcessor_->getGainReduction(Channel);
+        OutputLevelMeters_[Channel]->setLevels(
+            Snapshot.AverageOutputLevels[Channel], NoPeakDisplay,
+            Snapshot.PeakOutputLevels[Channel],
+            Snapshot.TruePeakOutputLevels[Channel]);
 
-                // make sure gain reduction meter doesn't show anything
-                // while there is no gain reduction
-                GainReduction -= 0.01f;
+        // make sure gain reduction meter doesn't show anything while
+        // there is no gain reduction
+        float GainReduction = Snapshot.GainReduction[Channel] - 0.01f;
 
-                GainReductionMeters_[Channel]->setNormalLevels(
-                    GainReduction, NoPeakDisplay);
-            }
-        }
-    }
-    else
-    {
-        DBG("[Squeezer] Received unknown action message \"" + Message + "\".");
+        GainReductionMeters_[Channel]->setNormalLevels(
+            GainReduction, NoPeakDisplay);
     }
 }
 
@@ -652,14 +656,14 @@ void SqueezerAudioProcessorEditor::updateParameter(
 
     case SqueezerPluginParameters::selCurveType:
 
-        if (FloatValue == (SideChain::CurveLogLin /
-                           float(SideChain::NumberOfCurves - 1)))
+        if (FloatValue == (SideChainBase::CurveLogLin /
+                           float(SideChainBase::NumberOfCurves - 1)))
         {
             ButtonCurveLinear_.setToggleState(true,
                                               dontSendNotification);
         }
-        else if (FloatValue == (SideChain::CurveLogSmoothDecoupled /
-                                float(SideChain::NumberOfCurves - 1)))
+        else if (FloatValue == (SideChainBase::CurveLogSmoothDecoupled /
+                                float(SideChainBase::NumberOfCurves - 1)))
         {
             ButtonCurveSmoothDecoupled_.setToggleState(true,
                     dontSendNotification);
@@ -674,14 +678,14 @@ void SqueezerAudioProcessorEditor::updateParameter(
 
     case SqueezerPluginParameters::selKneeWidth:
 
-        if (FloatValue == (Compressor::KneeHard /
-                           float(Compressor::NumberOfKneeSettings - 1)))
+        if (FloatValue == (CompressorBase::KneeHard /
+                           float(CompressorBase::NumberOfKneeSettings - 1)))
         {
             ButtonKneeHard_.setToggleState(true,
                                            dontSendNotification);
         }
-        else if (FloatValue == (Compressor::KneeMedium /
-                                float(Compressor::NumberOfKneeSettings - 1)))
+        else if (FloatValue == (CompressorBase::KneeMedium /
+                                float(CompressorBase::NumberOfKneeSettings - 1)))
         {
             ButtonKneeMedium_.setToggleState(true,
                                              dontSendNotification);
@@ -815,6 +819,37 @@ void SqueezerAudioProcessorEditor::updateParameter(
                                               dontSendNotification);
         break;
 
+    case SqueezerPluginParameters::selLookAhead:
+        // skin has no control for look-ahead (can be changed in the
+        // host)
+        break;
+
+    case SqueezerPluginParameters::selOversampling:
+        // skin has no control for oversampling (can be changed in the
+        // host)
+        break;
+
+    case SqueezerPluginParameters::selTruePeakMeters:
+        // skin has no control for true-peak meters (can be changed in
+        // the host); peak markers show true-peak levels when enabled
+        break;
+
+    case SqueezerPluginParameters::selLoudnessMeters:
+        // skin has no room for loudness meters (can be enabled in the
+        // host); readings are shown in the settings window
+        break;
+
+    case SqueezerPluginParameters::selMeterBallistics:
+        // skin has no control for meter ballistics (can be changed in
+        // the host); re-create level meters when their scale changes
+        if (PluginProcessor_->getMeterCrestFactor() != MeterCrestFactor_)
+        {
+            MeterCrestFactor_ = PluginProcessor_->getMeterCrestFactor();
+            applySkin_();
+        }
+
+        break;
+
     default:
         DBG("[Squeezer] editor::updateParameter ==> invalid index");
         break;
@@ -852,43 +887,43 @@ void SqueezerAudioProcessorEditor::buttonClicked(
     {
         PluginProcessor_->changeParameter(
             SqueezerPluginParameters::selCurveType,
-            SideChain::CurveLogLin /
-            float(SideChain::NumberOfCurves - 1));
+            SideChainBase::CurveLogLin /
+            float(SideChainBase::NumberOfCurves - 1));
     }
     else if (Button == &ButtonCurveSmoothDecoupled_)
     {
         PluginProcessor_->changeParameter(
             SqueezerPluginParameters::selCurveType,
-            SideChain::CurveLogSmoothDecoupled /
-            float(SideChain::NumberOfCurves - 1));
+            SideChainBase::CurveLogSmoothDecoupled /
+            float(SideChainBase::NumberOfCurves - 1));
     }
     else if (Button == &ButtonCurveSmoothBranching_)
     {
         PluginProcessor_->changeParameter(
             SqueezerPluginParameters::selCurveType,
-            SideChain::CurveLogSmoothBranching /
-            float(SideChain::NumberOfCurves - 1));
+            SideChainBase::CurveLogSmoothBranching /
+            float(SideChainBase::NumberOfCurves - 1));
     }
     else if (Button == &ButtonKneeHard_)
     {
         PluginProcessor_->changeParameter(
             SqueezerPluginParameters::selKneeWidth,
-            Compressor::KneeHard /
-            float(Compressor::NumberOfKneeSettings - 1));
+            CompressorBase::KneeHard /
+            float(CompressorBase::NumberOfKneeSettings - 1));
     }
     else if (Button == &ButtonKneeMedium_)
     {
         PluginProcessor_->changeParameter(
             SqueezerPluginParameters::selKneeWidth,
-            Compressor::KneeMedium /
-            float(Compressor::NumberOfKneeSettings - 1));
+            CompressorBase::KneeMedium /
+            float(CompressorBase::NumberOfKneeSettings - 1));
     }
     else if (Button == &ButtonKneeSoft_)
     {
         PluginProcessor_->changeParameter(
             SqueezerPluginParameters::selKneeWidth,
-            Compressor::KneeSoft /
-            float(Compressor::NumberOfKneeSettings - 1));
+            CompressorBase::KneeSoft /
+            float(CompressorBase::NumberOfKneeSettings - 1));
     }
     else if (Button == &ButtonAutoMakeupGain_)
     {
@@ -911,6 +946,7 @@ void SqueezerAudioProcessorEditor::buttonClicked(
     else if (Button == &ButtonReset_)
     {
         PluginProcessor_->resetMeters();
+        PluginProcessor_->getGainReductionHistory().clear();
 
         // apply skin to plug-in editor
         loadSkin_();
@@ -925,6 +961,16 @@ void SqueezerAudioProcessorEditor::buttonClicked(
         int Height = 155;
         String PluginSettings = PluginProcessor_->getParameters().trim();
 
+        // loudness readings are copied to the clipboard along with
+        // the settings (empty while loudness meters are disabled)
+        String Loudness = PluginProcessor_->getLoudness();
+
+        if (Loudness.isNotEmpty())
+        {
+            PluginSettings += "\n\n" + Loudness;
+            Height += 55;
+        }
+
         // prepare and launch dialog window
         DialogWindow *windowSettings =
             frut::widgets::WindowSettingsContent::createDialogWindow(
@@ -1210,6 +1256,22 @@ void SqueezerAudioProcessorEditor::sliderValueChanged(
 }
 
 
+void SqueezerAudioProcessorEditor::mouseUp(
+    const MouseEvent &Event)
+{
+    MeterBarGainReduction *GainReductionMeter =
+        dynamic_cast<MeterBarGainReduction *>(Event.eventComponent);
+
+    // show gain reduction history
+    if ((GainReductionMeter != nullptr) &&
+            GainReductionMeters_.contains(GainReductionMeter))
+    {
+        WindowHistoryContent::createDialogWindow(
+            this, &PluginProcessor_->getGainReductionHistory());
+    }
+}
+
+
 void SqueezerAudioProcessorEditor::resized()
 {
 }
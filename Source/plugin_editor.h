@@ -32,13 +32,14 @@
 #include "meter_bar_level.h"
 #include "plugin_processor.h"
 #include "skin.h"
+#include "window_history_content.h"
 
 
 class SqueezerAudioProcessorEditor :
     public AudioProcessorEditor,
     public Button::Listener,
     public Slider::Listener,
-    public ActionListener
+    public Timer
 {
 public:
     SqueezerAudioProcessorEditor(
@@ -50,10 +51,12 @@ public:
 
     void buttonClicked(Button *Button);
     void sliderValueChanged(Slider *Slider);
+    void mouseUp(const MouseEvent &Event);
 
-    void actionListenerCallback(const String &Message);
     void updateParameter(int Index);
 
+    void timerCallback();
+
     void windowAboutCallback(int ModalResult);
     void windowSettingsCallback(int ModalResult);
     void windowSkinCallback(int ModalResult);
@@ -68,6 +71,7 @@ private:
 
     bool IsInitialising_;
     int NumberOfChannels_;
+    int MeterCrestFactor_;
 
     SqueezerAudioProcessor *PluginProcessor_;
 
@@ -58,10 +58,10 @@ SqueezerPluginParameters::SqueezerPluginParameters() :
         new frut::parameters::ParSwitch();
     ParameterDesign->setName("Design");
 
-    ParameterDesign->addPreset(Compressor::DesignFeedForward, "Feed-Forward");
-    ParameterDesign->addPreset(Compressor::DesignFeedBack,    "Feed-Back");
+    ParameterDesign->addPreset(CompressorBase::DesignFeedForward, "Feed-Forward");
+    ParameterDesign->addPreset(CompressorBase::DesignFeedBack,    "Feed-Back");
 
-    ParameterDesign->setDefaultRealFloat(Compressor::DesignFeedBack, true);
+    ParameterDesign->setDefaultRealFloat(CompressorBase::DesignFeedBack, true);
     add(ParameterDesign, selDesign);
 
 
@@ -69,11 +69,11 @@ SqueezerPluginParameters::SqueezerPluginParameters() :
         new frut::parameters::ParSwitch();
     ParameterCurveType->setName("Detector");  // keep old name for backward compatibility!
 
-    ParameterCurveType->addPreset(SideChain::CurveLogLin,             "Linear");
-    ParameterCurveType->addPreset(SideChain::CurveLogSmoothDecoupled, "Smooth");
-    ParameterCurveType->addPreset(SideChain::CurveLogSmoothBranching, "Logarithmic");
+    ParameterCurveType->addPreset(SideChainBase::CurveLogLin,             "Linear");
+    ParameterCurveType->addPreset(SideChainBase::CurveLogSmoothDecoupled, "Smooth");
+    ParameterCurveType->addPreset(SideChainBase::CurveLogSmoothBranching, "Logarithmic");
 
-    ParameterCurveType->setDefaultRealFloat(SideChain::CurveLogSmoothBranching, true);
+    ParameterCurveType->setDefaultRealFloat(SideChainBase::CurveLogSmoothBranching, true);
     add(ParameterCurveType, selCurveType);
 
 
@@ -81,10 +81,10 @@ SqueezerPluginParameters::SqueezerPluginParameters() :
         new frut::parameters::ParSwitch();
     ParameterGainStage->setName("Gain Stage");
 
-    ParameterGainStage->addPreset(GainStage::FET,     "FET");
-    ParameterGainStage->addPreset(GainStage::Optical, "Optical");
+    ParameterGainStage->addPreset(GainStageBase::FET,     "FET");
+    ParameterGainStage->addPreset(GainStageBase::Optical, "Optical");
 
-    ParameterGainStage->setDefaultRealFloat(GainStage::FET, true);
+    ParameterGainStage->setDefaultRealFloat(GainStageBase::FET, true);
     add(ParameterGainStage, selGainStage);
 
 
@@ -486,6 +486,72 @@ SqueezerPluginParameters::SqueezerPluginParameters() :
     addCombined(ParameterStereoLink, selStereoLinkSwitch, selStereoLink);
 
 
+    frut::parameters::ParSwitch *ParameterLookAhead =
+        new frut::parameters::ParSwitch();
+    ParameterLookAhead->setName("Look-Ahead");
+
+    ParameterLookAhead->addPreset(0.0f,   "Off");
+    ParameterLookAhead->addPreset(1.0f,   "1 ms");
+    ParameterLookAhead->addPreset(2.0f,   "2 ms");
+    ParameterLookAhead->addPreset(5.0f,   "5 ms");
+    ParameterLookAhead->addPreset(10.0f, "10 ms");
+    ParameterLookAhead->addPreset(20.0f, "20 ms");
+
+    ParameterLookAhead->setDefaultRealFloat(0.0f, true);
+    add(ParameterLookAhead, selLookAhead);
+
+
+    frut::parameters::ParSwitch *ParameterOversampling =
+        new frut::parameters::ParSwitch();
+    ParameterOversampling->setName("Oversampling");
+
+    ParameterOversampling->addPreset(1.0f, "Off");
+    ParameterOversampling->addPreset(2.0f, "2x");
+    ParameterOversampling->addPreset(4.0f, "4x");
+    ParameterOversampling->addPreset(8.0f, "8x");
+
+    ParameterOversampling->setDefaultRealFloat(1.0f, true);
+    add(ParameterOversampling, selOversampling);
+
+
+    frut::parameters::ParBoolean *ParameterTruePeakMeters =
+        new frut::parameters::ParBoolean("On", "Off");
+    ParameterTruePeakMeters->setName("True-Peak Meters");
+    ParameterTruePeakMeters->setDefaultBoolean(false, true);
+    add(ParameterTruePeakMeters, selTruePeakMeters);
+
+
+    frut::parameters::ParSwitch *ParameterMeterBallistics =
+        new frut::parameters::ParSwitch();
+    ParameterMeterBallistics->setName("Meter Ballistics");
+
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardDefault, "Default");
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardPpmType1, "PPM Type I");
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardPpmType2, "PPM Type II");
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardVu, "VU");
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardK20, "K-20");
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardK14, "K-14");
+    ParameterMeterBallistics->addPreset(
+        frut::dsp::MeterBallistics::standardK12, "K-12");
+
+    ParameterMeterBallistics->setDefaultRealFloat(
+        frut::dsp::MeterBallistics::standardDefault, true);
+    add(ParameterMeterBallistics, selMeterBallistics);
+
+
+    frut::parameters::ParBoolean *ParameterLoudnessMeters =
+        new frut::parameters::ParBoolean("On", "Off");
+    ParameterLoudnessMeters->setName("Loudness Meters");
+    ParameterLoudnessMeters->setDefaultBoolean(false, true);
+    add(ParameterLoudnessMeters, selLoudnessMeters);
+
+
     // locate directory containing the skins
     File skinDirectory = getSkinDirectory();
 
@@ -540,6 +606,21 @@ String SqueezerPluginParameters::toString()
     parameterValues += ", Link: ";
     parameterValues += getText(selStereoLink);
 
+    parameterValues += ", Look-Ahead: ";
+    parameterValues += getText(selLookAhead);
+
+    parameterValues += ", Oversampling: ";
+    parameterValues += getText(selOversampling);
+
+    parameterValues += ", True-Peak: ";
+    parameterValues += getText(selTruePeakMeters);
+
+    parameterValues += ", Meters: ";
+    parameterValues += getText(selMeterBallistics);
+
+    parameterValues += ", Loudness: ";
+    parameterValues += getText(selLoudnessMeters);
+
     parameterValues += "\nThresh: ";
     parameterValues += getText(selThreshold);
 
@@ -641,3 +722,50 @@ void SqueezerPluginParameters::setSkinName(const String &strSkinName)
 {
     setText(selSkinName, strSkinName);
 }
+
+
+template <typename SampleType>
+void SqueezerPluginParameters::applyToCompressor(
+    Compressor<SampleType> &compressor)
+{
+    compressor.setBypass(getBoolean(selBypass));
+    compressor.setRmsWindowSize(getRealFloat(selRmsWindowSize));
+    compressor.setDesign(getRealInteger(selDesign));
+    compressor.setCurve(getRealInteger(selCurveType));
+    compressor.setGainStage(getRealInteger(selGainStage));
+
+    compressor.setThreshold(getRealFloat(selThreshold));
+    compressor.setRatio(getRealFloat(selRatio));
+    compressor.setKneeWidth(getRealFloat(selKneeWidth));
+
+    compressor.setAttackRate(getRealFloat(selAttackRate));
+    compressor.setReleaseRate(getRealInteger(selReleaseRate));
+
+    compressor.setInputTrim(getRealFloat(selInputTrim));
+    compressor.setAutoMakeupGain(getBoolean(selAutoMakeupGain));
+    compressor.setMakeupGain(getRealFloat(selMakeupGain));
+    compressor.setStereoLink(getRealInteger(selStereoLink));
+    compressor.setWetMix(getRealInteger(selWetMix));
+
+    compressor.setSidechainInput(getBoolean(selSidechainInput));
+    compressor.setSidechainHPFCutoff(getRealInteger(selSidechainHPFCutoff));
+    compressor.setSidechainLPFCutoff(getRealInteger(selSidechainLPFCutoff));
+    compressor.setSidechainListen(getBoolean(selSidechainListen));
+
+    compressor.setLookAhead(getRealFloat(selLookAhead));
+
+    compressor.setOversampling(getRealInteger(selOversampling));
+
+    // true-peak and loudness meters run background threads, so the
+    // caller decides whether to start them
+    compressor.setMeterBallistics(getRealInteger(selMeterBallistics));
+
+    // start with current parameter values instead of ramping towards
+    // them
+    compressor.skipSmoothing();
+}
+
+
+// explicit instantiation of all template instances
+template void SqueezerPluginParameters::applyToCompressor(Compressor<float> &);
+template void SqueezerPluginParameters::applyToCompressor(Compressor<double> &);
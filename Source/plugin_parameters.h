@@ -42,6 +42,9 @@ public:
     String getSkinName();
     void setSkinName(const String &strSkinName);
 
+    template <typename SampleType>
+    void applyToCompressor(Compressor<SampleType> &compressor);
+
     enum Parameters  // public namespace!
     {
         selBypass = 0,
@@ -79,6 +82,12 @@ public:
         selStereoLinkSwitch,
         selStereoLink,
 
+        selLookAhead,
+        selOversampling,
+        selTruePeakMeters,
+        selMeterBallistics,
+        selLoudnessMeters,
+
         numberOfParametersRevealed,
 
         selSkinName = numberOfParametersRevealed,
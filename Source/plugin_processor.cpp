@@ -35,28 +35,38 @@ Flow of parameter processing:
   Processor:   changeParameter(nIndex, fValue)
   Processor:   setParameter(nIndex, fValue)
   Parameters:  setFloat(nIndex, fValue)
-  Editor:      actionListenerCallback(strMessage)
+  Processor:   parameterChanges_.push(nIndex)
+  Editor:      timerCallback()
   Editor:      updateParameter(nIndex)
 
 ==============================================================================*/
 
-SqueezerAudioProcessor::SqueezerAudioProcessor()
+SqueezerAudioProcessor::SqueezerAudioProcessor() :
 #ifndef JucePlugin_PreferredChannelConfigurations
-    : AudioProcessor(getBusesProperties())
+    AudioProcessor(getBusesProperties()),
 #endif
+    parameterChanges_(SqueezerPluginParameters::numberOfParametersRevealed)
 {
     frut::Frut::printVersionNumbers();
 
     sampleRateIsValid_ = false;
     hasSideChain_ = false;
 
+    maximumBlockSize_ = 0;
+    requestedBlockSize_ = 0;
+    meterConsumers_ = 0;
+
     setLatencySamples(0);
+
+    // report latency changes made by the audio thread and apply
+    // parameters that must not be changed on the audio thread
+    startTimerHz(20);
 }
 
 
 SqueezerAudioProcessor::~SqueezerAudioProcessor()
 {
-    removeAllActionListeners();
+    stopTimer();
 }
 
 
@@ -278,6 +288,65 @@ String SqueezerAudioProcessor::getParameters()
 }
 
 
+template <typename SampleType>
+static String formatLoudness(Compressor<SampleType> &compressor)
+{
+    typedef LoudnessAnalyser<SampleType> Analyser;
+
+    String strLoudness = "Loudness (input -> output)\n";
+
+    strLoudness += "Momentary: ";
+    strLoudness += String(compressor.getInputLoudness(Analyser::MomentaryLoudness), 1);
+    strLoudness += " -> ";
+    strLoudness += String(compressor.getOutputLoudness(Analyser::MomentaryLoudness), 1);
+
+    strLoudness += " LUFS, Short-term: ";
+    strLoudness += String(compressor.getInputLoudness(Analyser::ShortTermLoudness), 1);
+    strLoudness += " -> ";
+    strLoudness += String(compressor.getOutputLoudness(Analyser::ShortTermLoudness), 1);
+
+    strLoudness += " LUFS\nIntegrated: ";
+    strLoudness += String(compressor.getInputLoudness(Analyser::IntegratedLoudness), 1);
+    strLoudness += " -> ";
+    strLoudness += String(compressor.getOutputLoudness(Analyser::IntegratedLoudness), 1);
+
+    strLoudness += " LUFS, Range: ";
+    strLoudness += String(compressor.getInputLoudness(Analyser::LoudnessRange), 1);
+    strLoudness += " -> ";
+    strLoudness += String(compressor.getOutputLoudness(Analyser::LoudnessRange), 1);
+    strLoudness += " LU";
+
+    return strLoudness;
+}
+
+
+String SqueezerAudioProcessor::getLoudness()
+{
+    if (!compressorFloat_)
+    {
+        return String();
+    }
+
+    // loudness meters only run in the active engine
+    if (usesDoublePrecision_.get())
+    {
+        if (compressorDouble_->getLoudnessMetering())
+        {
+            return formatLoudness(*compressorDouble_);
+        }
+    }
+    else
+    {
+        if (compressorFloat_->getLoudnessMetering())
+        {
+            return formatLoudness(*compressorFloat_);
+        }
+    }
+
+    return String();
+}
+
+
 float SqueezerAudioProcessor::getParameter(
     int nIndex)
 {
@@ -326,10 +395,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             bool bBypassCompressor = pluginParameters_.getBoolean(nIndex);
-            compressor_->setBypass(bBypassCompressor);
+            compressorFloat_->setBypass(bBypassCompressor);
+            compressorDouble_->setBypass(bBypassCompressor);
         }
 
         break;
@@ -338,10 +408,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fRmsWindowSizeMilliSeconds = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setRmsWindowSize(fRmsWindowSizeMilliSeconds);
+            compressorFloat_->setRmsWindowSize(fRmsWindowSizeMilliSeconds);
+            compressorDouble_->setRmsWindowSize(fRmsWindowSizeMilliSeconds);
         }
 
         break;
@@ -350,10 +421,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nDesign = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setDesign(nDesign);
+            compressorFloat_->setDesign(nDesign);
+            compressorDouble_->setDesign(nDesign);
         }
 
         break;
@@ -362,10 +434,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nCurveType = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setCurve(nCurveType);
+            compressorFloat_->setCurve(nCurveType);
+            compressorDouble_->setCurve(nCurveType);
         }
 
         break;
@@ -374,10 +447,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nGainStage = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setGainStage(nGainStage);
+            compressorFloat_->setGainStage(nGainStage);
+            compressorDouble_->setGainStage(nGainStage);
         }
 
         break;
@@ -386,10 +460,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fThreshold = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setThreshold(fThreshold);
+            compressorFloat_->setThreshold(fThreshold);
+            compressorDouble_->setThreshold(fThreshold);
         }
 
         break;
@@ -398,10 +473,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fRatio = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setRatio(fRatio);
+            compressorFloat_->setRatio(fRatio);
+            compressorDouble_->setRatio(fRatio);
         }
 
         break;
@@ -410,10 +486,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fKneeWidth = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setKneeWidth(fKneeWidth);
+            compressorFloat_->setKneeWidth(fKneeWidth);
+            compressorDouble_->setKneeWidth(fKneeWidth);
         }
 
         break;
@@ -422,10 +499,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fAttackRate = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setAttackRate(fAttackRate);
+            compressorFloat_->setAttackRate(fAttackRate);
+            compressorDouble_->setAttackRate(fAttackRate);
         }
 
         break;
@@ -434,10 +512,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nReleaseRate = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setReleaseRate(nReleaseRate);
+            compressorFloat_->setReleaseRate(nReleaseRate);
+            compressorDouble_->setReleaseRate(nReleaseRate);
         }
 
         break;
@@ -446,10 +525,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fInputTrim = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setInputTrim(fInputTrim);
+            compressorFloat_->setInputTrim(fInputTrim);
+            compressorDouble_->setInputTrim(fInputTrim);
         }
 
         break;
@@ -458,10 +538,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             bool bAutoMakeupGain = pluginParameters_.getBoolean(nIndex);
-            compressor_->setAutoMakeupGain(bAutoMakeupGain);
+            compressorFloat_->setAutoMakeupGain(bAutoMakeupGain);
+            compressorDouble_->setAutoMakeupGain(bAutoMakeupGain);
         }
 
         break;
@@ -470,10 +551,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             float fMakeupGain = pluginParameters_.getRealFloat(nIndex);
-            compressor_->setMakeupGain(fMakeupGain);
+            compressorFloat_->setMakeupGain(fMakeupGain);
+            compressorDouble_->setMakeupGain(fMakeupGain);
         }
 
         break;
@@ -482,10 +564,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nStereoLink = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setStereoLink(nStereoLink);
+            compressorFloat_->setStereoLink(nStereoLink);
+            compressorDouble_->setStereoLink(nStereoLink);
         }
 
         break;
@@ -494,10 +577,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nWetMix = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setWetMix(nWetMix);
+            compressorFloat_->setWetMix(nWetMix);
+            compressorDouble_->setWetMix(nWetMix);
         }
 
         break;
@@ -506,10 +590,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             bool bSidechainInput = pluginParameters_.getBoolean(nIndex);
-            compressor_->setSidechainInput(bSidechainInput);
+            compressorFloat_->setSidechainInput(bSidechainInput);
+            compressorDouble_->setSidechainInput(bSidechainInput);
         }
 
         break;
@@ -518,10 +603,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nSidechainHPFCutoff = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setSidechainHPFCutoff(nSidechainHPFCutoff);
+            compressorFloat_->setSidechainHPFCutoff(nSidechainHPFCutoff);
+            compressorDouble_->setSidechainHPFCutoff(nSidechainHPFCutoff);
         }
 
         break;
@@ -530,10 +616,11 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             int nSidechainLPFCutoff = pluginParameters_.getRealInteger(nIndex);
-            compressor_->setSidechainLPFCutoff(nSidechainLPFCutoff);
+            compressorFloat_->setSidechainLPFCutoff(nSidechainLPFCutoff);
+            compressorDouble_->setSidechainLPFCutoff(nSidechainLPFCutoff);
         }
 
         break;
@@ -542,10 +629,71 @@ void SqueezerAudioProcessor::setParameter(
 
         pluginParameters_.setFloat(nIndex, fValue);
 
-        if (compressor_)
+        if (compressorFloat_)
         {
             bool bSidechainListen = pluginParameters_.getBoolean(nIndex);
-            compressor_->setSidechainListen(bSidechainListen);
+            compressorFloat_->setSidechainListen(bSidechainListen);
+            compressorDouble_->setSidechainListen(bSidechainListen);
+        }
+
+        break;
+
+    case SqueezerPluginParameters::selTruePeakMeters:
+
+        // starting and stopping the meter's background thread blocks,
+        // so "timerCallback" applies this parameter
+        pluginParameters_.setFloat(nIndex, fValue);
+
+        break;
+
+    case SqueezerPluginParameters::selLoudnessMeters:
+
+        // starting and stopping the meter's background thread blocks,
+        // so "timerCallback" applies this parameter
+        pluginParameters_.setFloat(nIndex, fValue);
+
+        break;
+
+    case SqueezerPluginParameters::selMeterBallistics:
+
+        pluginParameters_.setFloat(nIndex, fValue);
+
+        if (compressorFloat_)
+        {
+            int nMeterBallistics = pluginParameters_.getRealInteger(nIndex);
+            compressorFloat_->setMeterBallistics(nMeterBallistics);
+            compressorDouble_->setMeterBallistics(nMeterBallistics);
+        }
+
+        break;
+
+    case SqueezerPluginParameters::selLookAhead:
+
+        pluginParameters_.setFloat(nIndex, fValue);
+
+        if (compressorFloat_)
+        {
+            // the audio thread switches to the new look-ahead, and
+            // "timerCallback" reports the resulting latency
+            float fLookAhead = pluginParameters_.getRealFloat(nIndex);
+            compressorFloat_->setLookAhead(fLookAhead);
+            compressorDouble_->setLookAhead(fLookAhead);
+        }
+
+        break;
+
+    case SqueezerPluginParameters::selOversampling:
+
+        pluginParameters_.setFloat(nIndex, fValue);
+
+        if (compressorFloat_)
+        {
+            // the audio thread switches to the new oversampling
+            // factor, and "timerCallback" reports the resulting
+            // latency
+            int nOversampling = pluginParameters_.getRealInteger(nIndex);
+            compressorFloat_->setOversampling(nOversampling);
+            compressorDouble_->setOversampling(nOversampling);
         }
 
         break;
@@ -595,9 +743,9 @@ void SqueezerAudioProcessor::setParameter(
         // will also clear the change flag)
         if (nIndex < pluginParameters_.getNumParameters(false))
         {
-            // "PC" ==> parameter changed, followed by a hash and the
-            // parameter's ID
-            sendActionMessage("PC#" + String(nIndex));
+            // lock-free and does not allocate memory, as this may
+            // well be the audio thread
+            parameterChanges_.push(nIndex);
         }
         // for hidden parameters, we only have to clear the change
         // flag
@@ -623,18 +771,26 @@ bool SqueezerAudioProcessor::hasChanged(
 }
 
 
+bool SqueezerAudioProcessor::getChangedParameter(
+    int &nIndex)
+{
+    // must only be called by the editor
+    return parameterChanges_.pop(nIndex);
+}
+
+
 void SqueezerAudioProcessor::updateParameters(
     bool bIncludeHiddenParameters)
 {
-    int nNumParameters = pluginParameters_.getNumParameters(false);
+    // scan change flags instead of polling every single parameter
+    int nIndex = pluginParameters_.getNextChangedParameter(0, false);
 
-    for (int nIndex = 0; nIndex < nNumParameters; ++nIndex)
+    while (nIndex >= 0)
     {
-        if (pluginParameters_.hasChanged(nIndex))
-        {
-            float fValue = pluginParameters_.getFloat(nIndex);
-            changeParameter(nIndex, fValue);
-        }
+        float fValue = pluginParameters_.getFloat(nIndex);
+        changeParameter(nIndex, fValue);
+
+        nIndex = pluginParameters_.getNextChangedParameter(nIndex + 1, false);
     }
 
     if (bIncludeHiddenParameters)
@@ -659,6 +815,15 @@ String SqueezerAudioProcessor::getParameterSkinName()
 }
 
 
+int SqueezerAudioProcessor::getMeterCrestFactor()
+{
+    int nMeterBallistics = pluginParameters_.getRealInteger(
+                               SqueezerPluginParameters::selMeterBallistics);
+
+    return frut::dsp::MeterBallistics::getCrestFactor(nMeterBallistics);
+}
+
+
 void SqueezerAudioProcessor::setParameterSkinName(
     const String &strSkinName)
 {
@@ -673,22 +838,53 @@ void SqueezerAudioProcessor::setParameterSkinName(
 
 void SqueezerAudioProcessor::resetMeters()
 {
-    if (compressor_)
+    if (compressorFloat_)
     {
-        compressor_->resetMeters();
+        compressorFloat_->resetMeters();
+        compressorFloat_->resetLoudnessMeters();
+
+        compressorDouble_->resetMeters();
+        compressorDouble_->resetLoudnessMeters();
     }
+}
+
+
+void SqueezerAudioProcessor::addMeterConsumer()
+{
+    // lock-free, so consumers may come and go while audio is
+    // processed
+    ++meterConsumers_;
+}
+
 
-    // "UM" ==> update meters
-    sendActionMessage("UM");
+void SqueezerAudioProcessor::removeMeterConsumer()
+{
+    jassert(meterConsumers_.get() > 0);
+    --meterConsumers_;
+}
+
+
+GainReductionHistory &SqueezerAudioProcessor::getGainReductionHistory()
+{
+    // history is fed by the audio thread and must only be read by a
+    // single thread (usually the editor)
+    return gainReductionHistory_;
 }
 
 
 float SqueezerAudioProcessor::getGainReduction(
     int nChannel)
 {
-    if (compressor_)
+    if (compressorFloat_)
     {
-        return (float) compressor_->getGainReduction(nChannel);
+        if (usesDoublePrecision_.get())
+        {
+            return (float) compressorDouble_->getGainReduction(nChannel);
+        }
+        else
+        {
+            return (float) compressorFloat_->getGainReduction(nChannel);
+        }
     }
     else
     {
@@ -700,9 +896,16 @@ float SqueezerAudioProcessor::getGainReduction(
 float SqueezerAudioProcessor::getPeakMeterInputLevel(
     int nChannel)
 {
-    if (compressor_)
+    if (compressorFloat_)
     {
-        return (float) compressor_->getPeakMeterInputLevel(nChannel);
+        if (usesDoublePrecision_.get())
+        {
+            return (float) compressorDouble_->getPeakMeterInputLevel(nChannel);
+        }
+        else
+        {
+            return (float) compressorFloat_->getPeakMeterInputLevel(nChannel);
+        }
     }
     else
     {
@@ -714,9 +917,16 @@ float SqueezerAudioProcessor::getPeakMeterInputLevel(
 float SqueezerAudioProcessor::getPeakMeterOutputLevel(
     int nChannel)
 {
-    if (compressor_)
+    if (compressorFloat_)
     {
-        return (float) compressor_->getPeakMeterOutputLevel(nChannel);
+        if (usesDoublePrecision_.get())
+        {
+            return (float) compressorDouble_->getPeakMeterOutputLevel(nChannel);
+        }
+        else
+        {
+            return (float) compressorFloat_->getPeakMeterOutputLevel(nChannel);
+        }
     }
     else
     {
@@ -728,9 +938,16 @@ float SqueezerAudioProcessor::getPeakMeterOutputLevel(
 float SqueezerAudioProcessor::getAverageMeterInputLevel(
     int nChannel)
 {
-    if (compressor_)
+    if (compressorFloat_)
     {
-        return (float) compressor_->getAverageMeterInputLevel(nChannel);
+        if (usesDoublePrecision_.get())
+        {
+            return (float) compressorDouble_->getAverageMeterInputLevel(nChannel);
+        }
+        else
+        {
+            return (float) compressorFloat_->getAverageMeterInputLevel(nChannel);
+        }
     }
     else
     {
@@ -742,9 +959,16 @@ float SqueezerAudioProcessor::getAverageMeterInputLevel(
 float SqueezerAudioProcessor::getAverageMeterOutputLevel(
     int nChannel)
 {
-    if (compressor_)
+    if (compressorFloat_)
     {
-        return (float) compressor_->getAverageMeterOutputLevel(nChannel);
+        if (usesDoublePrecision_.get())
+        {
+            return (float) compressorDouble_->getAverageMeterOutputLevel(nChannel);
+        }
+        else
+        {
+            return (float) compressorFloat_->getAverageMeterOutputLevel(nChannel);
+        }
     }
     else
     {
@@ -753,6 +977,27 @@ float SqueezerAudioProcessor::getAverageMeterOutputLevel(
 }
 
 
+bool SqueezerAudioProcessor::getMeterSnapshot(
+    MeterSnapshot &snapshot)
+{
+    if (compressorFloat_)
+    {
+        if (usesDoublePrecision_.get())
+        {
+            return compressorDouble_->getMeterSnapshot(snapshot);
+        }
+        else
+        {
+            return compressorFloat_->getMeterSnapshot(snapshot);
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
 bool SqueezerAudioProcessor::acceptsMidi() const
 {
 #if JucePlugin_WantsMidiInput
@@ -819,13 +1064,25 @@ void SqueezerAudioProcessor::prepareToPlay(
     double sampleRate,
     int samplesPerBlock)
 {
-    ignoreUnused(samplesPerBlock);
-
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
 
     Logger::outputDebugString("[Squeezer] preparing to play");
 
+    // some hosts exceed the announced block size; the audio thread
+    // then processes in chunks and stores the requested block size,
+    // so that buffers can grow here (and not on the audio thread)
+    maximumBlockSize_ = jmax(samplesPerBlock,
+                             requestedBlockSize_.get(),
+                             1);
+
+    // allocate all buffers used by the audio thread
+    int numberOfBufferChannels = jmax(getTotalNumInputChannels(),
+                                      getTotalNumOutputChannels());
+
+    floatBuffer_.setSize(numberOfBufferChannels, maximumBlockSize_);
+    doubleBuffer_.setSize(numberOfBufferChannels, maximumBlockSize_);
+
     if ((sampleRate < 44100) || (sampleRate > 192000))
     {
         Logger::outputDebugString("[Squeezer] WARNING: sample rate of " +
@@ -841,49 +1098,6 @@ void SqueezerAudioProcessor::prepareToPlay(
     Logger::outputDebugString("[Squeezer] number of main/aux input channels:  " + String(getMainBusNumInputChannels()) + "/" + String(getTotalNumInputChannels() - getMainBusNumInputChannels()));
     Logger::outputDebugString("[Squeezer] number of main/aux output channels: " + String(getMainBusNumOutputChannels()) + "/" + String(getTotalNumOutputChannels() - getMainBusNumOutputChannels()));
 
-    bool bBypassCompressor = pluginParameters_.getBoolean(
-                                 SqueezerPluginParameters::selBypass);
-    float fRmsWindowSizeMilliSeconds = pluginParameters_.getRealFloat(
-                                           SqueezerPluginParameters::selRmsWindowSize);
-    int nDesign = pluginParameters_.getRealInteger(
-                      SqueezerPluginParameters::selDesign);
-    int nCurveType = pluginParameters_.getRealInteger(
-                         SqueezerPluginParameters::selCurveType);
-    int nGainStage = pluginParameters_.getRealInteger(
-                         SqueezerPluginParameters::selGainStage);
-
-    float fThreshold = pluginParameters_.getRealFloat(
-                           SqueezerPluginParameters::selThreshold);
-    float fRatio = pluginParameters_.getRealFloat(
-                       SqueezerPluginParameters::selRatio);
-    float fKneeWidth = pluginParameters_.getRealFloat(
-                           SqueezerPluginParameters::selKneeWidth);
-
-    float fAttackRate = pluginParameters_.getRealFloat(
-                            SqueezerPluginParameters::selAttackRate);
-    int nReleaseRate = pluginParameters_.getRealInteger(
-                           SqueezerPluginParameters::selReleaseRate);
-
-    float fInputTrim = pluginParameters_.getRealFloat(
-                           SqueezerPluginParameters::selInputTrim);
-    bool bAutoMakeupGain = pluginParameters_.getBoolean(
-                               SqueezerPluginParameters::selAutoMakeupGain);
-    float fMakeupGain = pluginParameters_.getRealFloat(
-                            SqueezerPluginParameters::selMakeupGain);
-    int nStereoLink = pluginParameters_.getRealInteger(
-                          SqueezerPluginParameters::selStereoLink);
-    int nWetMix = pluginParameters_.getRealInteger(
-                      SqueezerPluginParameters::selWetMix);
-
-    bool bSidechainInput = pluginParameters_.getBoolean(
-                               SqueezerPluginParameters::selSidechainInput);
-    int nSidechainHPFCutoff = pluginParameters_.getRealInteger(
-                                  SqueezerPluginParameters::selSidechainHPFCutoff);
-    int nSidechainLPFCutoff = pluginParameters_.getRealInteger(
-                                  SqueezerPluginParameters::selSidechainLPFCutoff);
-    bool bSidechainListen = pluginParameters_.getBoolean(
-                                SqueezerPluginParameters::selSidechainListen);
-
 #ifdef SQUEEZER_MONO
     int numberOfChannels = 1;
 #else
@@ -894,31 +1108,28 @@ void SqueezerAudioProcessor::prepareToPlay(
                             getMainBusNumOutputChannels()),
                        24);
 
-    compressor_ = std::make_unique<Compressor>(numberOfChannels, (int) sampleRate);
+    compressorFloat_ = std::make_unique<Compressor<float>>(
+                           numberOfChannels,
+                           (int) sampleRate,
+                           maximumBlockSize_);
 
-    compressor_->setBypass(bBypassCompressor);
-    compressor_->setRmsWindowSize(fRmsWindowSizeMilliSeconds);
-    compressor_->setDesign(nDesign);
-    compressor_->setCurve(nCurveType);
-    compressor_->setGainStage(nGainStage);
+    compressorDouble_ = std::make_unique<Compressor<double>>(
+                            numberOfChannels,
+                            (int) sampleRate,
+                            maximumBlockSize_);
 
-    compressor_->setThreshold(fThreshold);
-    compressor_->setRatio(fRatio);
-    compressor_->setKneeWidth(fKneeWidth);
+    pluginParameters_.applyToCompressor(*compressorFloat_);
+    pluginParameters_.applyToCompressor(*compressorDouble_);
 
-    compressor_->setAttackRate(fAttackRate);
-    compressor_->setReleaseRate(nReleaseRate);
+    gainReductionHistory_.setSampleRate((int) sampleRate);
+    compressorFloat_->setGainReductionHistory(&gainReductionHistory_);
+    compressorDouble_->setGainReductionHistory(&gainReductionHistory_);
 
-    compressor_->setInputTrim(fInputTrim);
-    compressor_->setAutoMakeupGain(bAutoMakeupGain);
-    compressor_->setMakeupGain(fMakeupGain);
-    compressor_->setStereoLink(nStereoLink);
-    compressor_->setWetMix(nWetMix);
+    usesDoublePrecision_ = needsDoublePrecision();
 
-    compressor_->setSidechainInput(bSidechainInput);
-    compressor_->setSidechainHPFCutoff(nSidechainHPFCutoff);
-    compressor_->setSidechainLPFCutoff(nSidechainLPFCutoff);
-    compressor_->setSidechainListen(bSidechainListen);
+    // start meter threads of active engine and report latency caused
+    // by look-ahead and oversampling
+    timerCallback();
 }
 
 
@@ -932,6 +1143,56 @@ void SqueezerAudioProcessor::releaseResources()
 }
 
 
+void SqueezerAudioProcessor::timerCallback()
+{
+    // merge bins queued by the audio thread into gain reduction
+    // history, so that none are dropped while the editor is closed
+    gainReductionHistory_.update();
+
+    if (compressorFloat_)
+    {
+        bool useDoublePrecision = usesDoublePrecision_.get();
+
+        bool useTruePeakMeters = pluginParameters_.getBoolean(
+                                     SqueezerPluginParameters::selTruePeakMeters);
+        bool useLoudnessMeters = pluginParameters_.getBoolean(
+                                     SqueezerPluginParameters::selLoudnessMeters);
+
+        // start or stop background threads (does nothing unless the
+        // parameters or the active engine have changed); only the
+        // active engine runs them
+        compressorFloat_->setTruePeakMetering(
+            useTruePeakMeters && !useDoublePrecision);
+        compressorDouble_->setTruePeakMetering(
+            useTruePeakMeters && useDoublePrecision);
+
+        compressorFloat_->setLoudnessMetering(
+            useLoudnessMeters && !useDoublePrecision);
+        compressorDouble_->setLoudnessMetering(
+            useLoudnessMeters && useDoublePrecision);
+
+        // the compressor switches look-ahead and oversampling on the
+        // audio thread, so report the latency it actually uses (this
+        // may allocate memory and is thus done on the message thread)
+        int latencySamples;
+
+        if (useDoublePrecision)
+        {
+            latencySamples = compressorDouble_->getLatencySamples();
+        }
+        else
+        {
+            latencySamples = compressorFloat_->getLatencySamples();
+        }
+
+        if (latencySamples != getLatencySamples())
+        {
+            setLatencySamples(latencySamples);
+        }
+    }
+}
+
+
 void SqueezerAudioProcessor::reset()
 {
     // Use this method as the place to clear any delay lines, buffers,
@@ -940,6 +1201,54 @@ void SqueezerAudioProcessor::reset()
 }
 
 
+bool SqueezerAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    // feed-back designs are processed in double precision, so hosts
+    // with double buffers save a conversion there
+    return true;
+}
+
+
+bool SqueezerAudioProcessor::needsDoublePrecision()
+{
+#if SQUEEZER_DOUBLE_PRECISION
+    return true;
+#else
+    // rounding errors are fed back into the side chain of feed-back
+    // designs (see top of header file)
+    return pluginParameters_.getRealInteger(SqueezerPluginParameters::selDesign) ==
+           CompressorBase::DesignFeedBack;
+#endif
+}
+
+
+bool SqueezerAudioProcessor::selectEngine()
+{
+    bool useDoublePrecision = needsDoublePrecision();
+
+    if (useDoublePrecision != usesDoublePrecision_.get())
+    {
+        // the other engine has been idle, so do not let its stale
+        // state (such as delayed samples) leak into the output;
+        // changing the design is not seamless anyway
+        if (useDoublePrecision)
+        {
+            compressorDouble_->reset();
+        }
+        else
+        {
+            compressorFloat_->reset();
+        }
+
+        // also hands meter threads over to the new engine (see
+        // "timerCallback")
+        usesDoublePrecision_ = useDoublePrecision;
+    }
+
+    return useDoublePrecision;
+}
+
+
 void SqueezerAudioProcessor::processBlock(
     AudioBuffer<float> &buffer,
     MidiBuffer &midiMessages)
@@ -950,21 +1259,59 @@ void SqueezerAudioProcessor::processBlock(
     // temporarily disable denormals
     ScopedNoDenormals noDenormals;
 
+    if (!sampleRateIsValid_)
+    {
+        buffer.clear();
+        return;
+    }
+
     int numberOfChannels = buffer.getNumChannels();
     int numberOfSamples = buffer.getNumSamples();
 
-    // create temporary buffer
-    AudioBuffer<double> processBuffer(numberOfChannels, numberOfSamples);
+    // assert on memory allocation (debug builds only)
+    frut::audio::AllocationGuard allocationGuard;
 
-    // copy input to temporary buffer and convert to double;
-    // de-normalize samples
-    dither_.convertToDouble(buffer, processBuffer);
+    // have buffers grow during next call of "prepareToPlay"
+    if (numberOfSamples > requestedBlockSize_.get())
+    {
+        requestedBlockSize_ = numberOfSamples;
+    }
 
-    // process input samples
-    process(processBuffer);
+    bool useDoublePrecision = selectEngine();
 
-    // copy temporary buffer to output and dither to float
-    dither_.ditherToFloat(processBuffer, buffer);
+    for (int startSample = 0; startSample < numberOfSamples; startSample += maximumBlockSize_)
+    {
+        int chunkSize = jmin(maximumBlockSize_,
+                             numberOfSamples - startSample);
+
+        // refers to existing data (does not allocate memory)
+        AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(),
+                                 numberOfChannels,
+                                 startSample,
+                                 chunkSize);
+
+        if (useDoublePrecision)
+        {
+            // re-uses pre-allocated memory
+            doubleBuffer_.setSize(numberOfChannels, chunkSize,
+                                  false, false, true);
+
+            // copy input to temporary buffer and convert to double;
+            // de-normalize samples
+            dither_.convertToDouble(chunk, doubleBuffer_);
+
+            // process input samples
+            process(doubleBuffer_, *compressorDouble_);
+
+            // copy temporary buffer to output and dither to float
+            dither_.ditherToFloat(doubleBuffer_, chunk);
+        }
+        else
+        {
+            // process input samples in place
+            process(chunk, *compressorFloat_);
+        }
+    }
 }
 
 
@@ -975,22 +1322,65 @@ void SqueezerAudioProcessor::processBlock(
     jassert(isUsingDoublePrecision());
     ignoreUnused(midiMessages);
 
-    // process input samples
-    process(buffer);
+    if (!sampleRateIsValid_)
+    {
+        buffer.clear();
+        return;
+    }
+
+    int numberOfChannels = buffer.getNumChannels();
+    int numberOfSamples = buffer.getNumSamples();
+
+    // assert on memory allocation (debug builds only)
+    frut::audio::AllocationGuard allocationGuard;
+
+    // have buffers grow during next call of "prepareToPlay"
+    if (numberOfSamples > requestedBlockSize_.get())
+    {
+        requestedBlockSize_ = numberOfSamples;
+    }
+
+    bool useDoublePrecision = selectEngine();
+
+    for (int startSample = 0; startSample < numberOfSamples; startSample += maximumBlockSize_)
+    {
+        int chunkSize = jmin(maximumBlockSize_,
+                             numberOfSamples - startSample);
+
+        // refers to existing data (does not allocate memory)
+        AudioBuffer<double> chunk(buffer.getArrayOfWritePointers(),
+                                  numberOfChannels,
+                                  startSample,
+                                  chunkSize);
+
+        if (useDoublePrecision)
+        {
+            // process input samples in place
+            process(chunk, *compressorDouble_);
+        }
+        else
+        {
+            // copy input to temporary buffer and convert to float
+            // (re-uses pre-allocated memory)
+            floatBuffer_.makeCopyOf(chunk, true);
+
+            // process input samples
+            process(floatBuffer_, *compressorFloat_);
+
+            // copy temporary buffer to output and convert to double
+            chunk.makeCopyOf(floatBuffer_, true);
+        }
+    }
 }
 
 
+template <typename SampleType>
 void SqueezerAudioProcessor::process(
-    AudioBuffer<double> &buffer)
+    AudioBuffer<SampleType> &buffer,
+    Compressor<SampleType> &compressor)
 {
     int nNumSamples = buffer.getNumSamples();
 
-    if (!sampleRateIsValid_)
-    {
-        buffer.clear();
-        return;
-    }
-
     // In case we have more main outputs than inputs, we'll clear any
     // output channels that didn't contain input data, because these
     // aren't guaranteed to be empty -- they may contain garbage.
@@ -1009,105 +1399,119 @@ void SqueezerAudioProcessor::process(
     }
 
 #ifdef SQUEEZER_MONO
+    const int numberOfChannels = 1;
+#else
+    const int numberOfChannels = 2;
+#endif
+
+    // channel pointers of main and side-chain inputs; the compressor
+    // processes the main input in place, so no samples are copied
+    SampleType *mainChannels[numberOfChannels];
+    SampleType *sideChainChannels[numberOfChannels];
 
-    mainInput_ = AudioBuffer<double>(1, nNumSamples);
-    sideChainInput_ = AudioBuffer<double>(1, nNumSamples);
+#ifdef SQUEEZER_MONO
 
     if (getChannelLayoutOfBus(true, 0) == AudioChannelSet::mono())
     {
-        mainInput_ = getBusBuffer(buffer, true, 0);
+        mainChannels[0] = buffer.getWritePointer(0);
 
         if (getChannelLayoutOfBus(true, 1) == AudioChannelSet::mono())
         {
+            // refers to existing data (does not allocate memory)
+            AudioBuffer<SampleType> sideChainBus = getBusBuffer(buffer, true, 1);
+
             hasSideChain_ = true;
-            sideChainInput_ = getBusBuffer(buffer, true, 1);
+            sideChainChannels[0] = sideChainBus.getWritePointer(0);
         }
         else
         {
             hasSideChain_ = false;
-            sideChainInput_ = getBusBuffer(buffer, true, 0);
+            sideChainChannels[0] = mainChannels[0];
         }
     }
     else if (getChannelLayoutOfBus(true, 0).size() == 2)
     {
         hasSideChain_ = true;
-        mainInput_.copyFrom(0, 0, buffer,
-                            0, 0, nNumSamples);
-
-        sideChainInput_.copyFrom(0, 0, buffer,
-                                 1, 0, nNumSamples);
+        mainChannels[0] = buffer.getWritePointer(0);
+        sideChainChannels[0] = buffer.getWritePointer(1);
     }
     else
     {
         DBG("clearing main input and side chain");
 
         hasSideChain_ = false;
-        mainInput_.clear();
-        sideChainInput_.clear();
+        buffer.clear(0, 0, nNumSamples);
+
+        mainChannels[0] = buffer.getWritePointer(0);
+        sideChainChannels[0] = mainChannels[0];
     }
 
 #else
 
-    mainInput_ = AudioBuffer<double>(2, nNumSamples);
-    sideChainInput_ = AudioBuffer<double>(2, nNumSamples);
-
     if (getChannelLayoutOfBus(true, 0) == AudioChannelSet::stereo())
     {
-        mainInput_ = getBusBuffer(buffer, true, 0);
+        mainChannels[0] = buffer.getWritePointer(0);
+        mainChannels[1] = buffer.getWritePointer(1);
 
         if (getChannelLayoutOfBus(true, 1) == AudioChannelSet::stereo())
         {
+            // refers to existing data (does not allocate memory)
+            AudioBuffer<SampleType> sideChainBus = getBusBuffer(buffer, true, 1);
+
             hasSideChain_ = true;
-            sideChainInput_ = getBusBuffer(buffer, true, 1);
+            sideChainChannels[0] = sideChainBus.getWritePointer(0);
+            sideChainChannels[1] = sideChainBus.getWritePointer(1);
         }
         else
         {
             hasSideChain_ = false;
-            sideChainInput_ = getBusBuffer(buffer, true, 0);
+            sideChainChannels[0] = mainChannels[0];
+            sideChainChannels[1] = mainChannels[1];
         }
     }
     else if (getChannelLayoutOfBus(true, 0).size() == 4)
     {
         hasSideChain_ = true;
-        mainInput_.copyFrom(0, 0, buffer,
-                            0, 0, nNumSamples);
-        mainInput_.copyFrom(1, 0, buffer,
-                            1, 0, nNumSamples);
-
-        sideChainInput_.copyFrom(0, 0, buffer,
-                                 2, 0, nNumSamples);
-        sideChainInput_.copyFrom(1, 0, buffer,
-                                 3, 0, nNumSamples);
+        mainChannels[0] = buffer.getWritePointer(0);
+        mainChannels[1] = buffer.getWritePointer(1);
+
+        sideChainChannels[0] = buffer.getWritePointer(2);
+        sideChainChannels[1] = buffer.getWritePointer(3);
     }
     else
     {
         DBG("clearing main input and side chain");
 
         hasSideChain_ = false;
-        mainInput_.clear();
-        sideChainInput_.clear();
-    }
+        buffer.clear(0, 0, nNumSamples);
+        buffer.clear(1, 0, nNumSamples);
 
-#endif
-
-    compressor_->process(mainInput_, sideChainInput_);
+        mainChannels[0] = buffer.getWritePointer(0);
+        mainChannels[1] = buffer.getWritePointer(1);
 
-#ifdef SQUEEZER_MONO
+        sideChainChannels[0] = mainChannels[0];
+        sideChainChannels[1] = mainChannels[1];
+    }
 
-    buffer.copyFrom(0, 0, mainInput_,
-                    0, 0, nNumSamples);
+#endif
 
-#else
+    // non-owning views on the channels (creating these buffers
+    // neither allocates memory nor copies samples)
+    AudioBuffer<SampleType> mainInput(mainChannels,
+                                      numberOfChannels,
+                                      nNumSamples);
 
-    buffer.copyFrom(0, 0, mainInput_,
-                    0, 0, nNumSamples);
-    buffer.copyFrom(1, 0, mainInput_,
-                    1, 0, nNumSamples);
+    AudioBuffer<SampleType> sideChainInput(sideChainChannels,
+                                           numberOfChannels,
+                                           nNumSamples);
 
-#endif
+    // skip metering while nobody reads the meters (such as the
+    // editor)
+    compressor.setMetering(meterConsumers_.get() > 0);
 
-    // "UM" ==> update meters
-    sendActionMessage("UM");
+    // side chain may refer to the main input, which is fine as the
+    // compressor reads the side chain before overwriting the input
+    compressor.process(mainInput, sideChainInput);
 }
 
 
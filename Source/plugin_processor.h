@@ -28,12 +28,26 @@
 
 #include "FrutHeader.h"
 #include "compressor.h"
+#include "gain_reduction_history.h"
+#include "parameter_change_queue.h"
 #include "plugin_parameters.h"
 
+// feed-forward designs are processed in single precision (float
+// buffers in place), feed-back designs in double precision (double
+// buffers in place).  In feed-forward designs, single precision
+// stays within the tolerances of "squeezer_validate" (-75 dBFS peak
+// difference, -45 dBFS for upward expansion, which boosts the output
+// above full scale).  The loops of feed-back designs make the output
+// depend so strongly on tiny differences that no such bound can be
+// given.  Set to 1 to process all designs in double precision.
+#ifndef SQUEEZER_DOUBLE_PRECISION
+#define SQUEEZER_DOUBLE_PRECISION 0
+#endif
+
 
 class SqueezerAudioProcessor :
     public AudioProcessor,
-    public ActionBroadcaster
+    private Timer
 {
 public:
     SqueezerAudioProcessor();
@@ -47,11 +61,12 @@ public:
     void releaseResources() override;
     void reset() override;
 
+    bool supportsDoublePrecisionProcessing() const override;
+
     void processBlock(AudioBuffer<float> &buffer,
                       MidiBuffer &midiMessages) override;
     void processBlock(AudioBuffer<double> &buffer,
                       MidiBuffer &midiMessages) override;
-    void process(AudioBuffer<double> &buffer);
 
     AudioProcessorEditor *createEditor() override;
     bool hasEditor() const override;
@@ -61,19 +76,28 @@ public:
     const String getParameterText(int nIndex) override;
 
     String getParameters();
+    String getLoudness();
     float getParameter(int nIndex) override;
     void changeParameter(int nIndex, float fValue);
     void setParameter(int nIndex, float fValue) override;
 
     void clearChangeFlag(int nIndex);
     bool hasChanged(int nIndex);
+    bool getChangedParameter(int &nIndex);
     void updateParameters(bool bIncludeHiddenParameters);
 
     String getParameterSkinName();
     void setParameterSkinName(const String &strSkinName);
 
+    int getMeterCrestFactor();
+
     void resetMeters();
 
+    void addMeterConsumer();
+    void removeMeterConsumer();
+
+    GainReductionHistory &getGainReductionHistory();
+
     float getGainReduction(int nChannel);
 
     float getPeakMeterInputLevel(int nChannel);
@@ -82,6 +106,8 @@ public:
     float getAverageMeterInputLevel(int nChannel);
     float getAverageMeterOutputLevel(int nChannel);
 
+    bool getMeterSnapshot(MeterSnapshot &snapshot);
+
     const String getName() const override;
 
     bool acceptsMidi() const override;
@@ -105,15 +131,41 @@ private:
 
     static BusesProperties getBusesProperties();
 
-    AudioBuffer<double> mainInput_;
-    AudioBuffer<double> sideChainInput_;
+    void timerCallback() override;
+
+    bool needsDoublePrecision();
+    bool selectEngine();
+
+    template <typename SampleType>
+    void process(AudioBuffer<SampleType> &buffer,
+                 Compressor<SampleType> &compressor);
+
+    // buffers for converting samples to the precision of the engine
+    AudioBuffer<float> floatBuffer_;
+    AudioBuffer<double> doubleBuffer_;
+
+    int maximumBlockSize_;
+    Atomic<int> requestedBlockSize_;
 
     frut::dsp::Dither dither_;
 
     bool hasSideChain_;
 
+    // meters are only updated while anybody reads them
+    Atomic<int> meterConsumers_;
+
+    // outlives compressors, which are re-created whenever the host
+    // prepares the plug-in
+    GainReductionHistory gainReductionHistory_;
+
     SqueezerPluginParameters pluginParameters_;
-    std::unique_ptr<Compressor> compressor_;
+    ParameterChangeQueue parameterChanges_;
+
+    // both engines are created together; only the one selected by
+    // "selectEngine" processes audio and runs meter threads
+    std::unique_ptr<Compressor<float>> compressorFloat_;
+    std::unique_ptr<Compressor<double>> compressorDouble_;
+    Atomic<bool> usesDoublePrecision_;
 
     bool sampleRateIsValid_;
 };
@@ -26,7 +26,11 @@
 #include "side_chain.h"
 
 
-SideChain::SideChain(
+constexpr double SideChainBase::SmoothingLength;
+
+
+template <typename SampleType>
+SideChain<SampleType>::SideChain(
     int nSampleRate) :
     gainStageFET(nSampleRate),
     gainStageOptical(nSampleRate)
@@ -38,7 +42,14 @@ SideChain::SideChain(
     */
 {
     dSampleRate = (double) nSampleRate;
-    dGainReductionIdeal = 0.0;
+    dGainReductionIdeal = SampleType(0.0);
+
+    // ramp threshold and ratio to prevent zipper noise
+    smoothedThreshold.reset(dSampleRate, SmoothingLength);
+    smoothedRatioInternal.reset(dSampleRate, SmoothingLength);
+
+    dThreshold = smoothedThreshold.getCurrentValue();
+    dRatioInternal = smoothedRatioInternal.getCurrentValue();
 
     setThreshold(-12.0);
     setRatio(2.0);
@@ -46,13 +57,16 @@ SideChain::SideChain(
 
     setRmsWindowSize(10.0);
     nCurveType = SideChain::CurveLogSmoothBranching;
-    nGainStageType = GainStage::FET;
+    nGainStageType = GainStageBase::FET;
 
-    setAttackRate(10.0);
+    setAttackRate(10.0, calculateAttackCoefficient(10.0, dSampleRate));
     setReleaseRate(100);
     setCurve(nCurveType);
     setGainStage(nGainStageType);
 
+    // start with initial values instead of ramping towards them
+    skipSmoothing();
+
     // reset (i.e. initialise) all relevant variables
     reset();
 
@@ -65,21 +79,126 @@ SideChain::SideChain(
 }
 
 
-void SideChain::reset()
+template <typename SampleType>
+void SideChain<SampleType>::reset()
 /*  Reset all relevant variables.
 
     return value: none
 */
 {
-    dGainReduction = 0.0;
-    dGainCompensation = 0.0;
-    dDetectorOutputLevelSquared = 0.0;
+    dGainReduction = SampleType(0.0);
+    dGainReductionIdeal = SampleType(0.0);
+    dGainReductionIntermediate = SampleType(0.0);
+    dDetectorOutputLevelSquared = SampleType(0.0);
+
+    gainStageFET.reset(dGainReduction);
+    gainStageOptical.reset(dGainReduction);
+
+    dCrestFactorAutoGain = SampleType(20.0);
+    updateGainCompensation();
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::skipSmoothing()
+/*  Finish all parameter ramps by jumping to their target values.
+    Call this after setting up a new side chain, so that processing
+    does not start with ramps from the default values.
+
+    return value: none
+*/
+{
+    smoothedThreshold.setCurrentAndTargetValue(
+        dThresholdTarget.get());
+    smoothedRatioInternal.setCurrentAndTargetValue(
+        dRatioInternalTarget.get());
+
+    dThreshold = smoothedThreshold.getCurrentValue();
+    dRatioInternal = smoothedRatioInternal.getCurrentValue();
+
+    // also updates gain compensation
+    updateKneeWidth();
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::updateSmoothingTargets()
+/*  Let parameter ramps head for the latest targets.  Must only be
+    called by the audio thread (before processing a block).
+
+    return value: none
+*/
+{
+    // does nothing if the target has not changed
+    smoothedThreshold.setTargetValue(dThresholdTarget.get());
+    smoothedRatioInternal.setTargetValue(dRatioInternalTarget.get());
+
+    // knee width is not ramped, so simply switch to new value
+    if (dKneeWidthTarget.get() != dKneeWidth)
+    {
+        updateKneeWidth();
+    }
+}
+
+
+template <typename SampleType>
+bool SideChain<SampleType>::isSmoothing()
+/*  Check whether any parameter is still ramping.
+
+    return value (boolean): returns true if threshold or ratio have
+    not yet reached their target values
+*/
+{
+    return smoothedThreshold.isSmoothing() ||
+           smoothedRatioInternal.isSmoothing();
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::updateSmoothedValues()
+/*  Advance parameter ramps by one sample.
+
+    return value: none
+*/
+{
+    dThreshold = smoothedThreshold.getNextValue();
+    dRatioInternal = smoothedRatioInternal.getNextValue();
+
+    updateGainCompensation();
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::updateKneeWidth()
+/*  Switch to latest knee width and update gain compensation.  Must
+    only be called by the audio thread or while the side chain is not
+    processing.
+
+    return value: none
+*/
+{
+    dKneeWidth = dKneeWidthTarget.get();
+    dKneeWidthHalf = dKneeWidth / SampleType(2.0);
+    dKneeWidthDouble = dKneeWidth * SampleType(2.0);
+
+    updateGainCompensation();
+}
 
-    dCrestFactorAutoGain = 20.0;
+
+template <typename SampleType>
+void SideChain<SampleType>::updateGainCompensation()
+/*  Update gain compensation from current threshold, ratio and knee
+    width.
+
+    return value: none
+*/
+{
+    dGainCompensation = queryGainComputer(dCrestFactorAutoGain) / SampleType(2.0);
 }
 
 
-double SideChain::getRmsWindowSize()
+template <typename SampleType>
+double SideChain<SampleType>::getRmsWindowSize()
 /*  Get current detector RMS window size.
 
     return value (double): returns current current detector RMS window
@@ -90,7 +209,8 @@ double SideChain::getRmsWindowSize()
 }
 
 
-void SideChain::setRmsWindowSize(
+template <typename SampleType>
+void SideChain<SampleType>::setRmsWindowSize(
     double dRmsWindowSizeMilliSecondsNew)
 /*  Set new detector RMS window size.
 
@@ -104,7 +224,7 @@ void SideChain::setRmsWindowSize(
     if (dRmsWindowSizeMilliSecondsNew <= 0.0)
     {
         dRmsWindowSizeMilliSeconds = 0.0;
-        dRmsWindowCoefficient = 0.0;
+        dRmsWindowCoefficient = SampleType(0.0);
     }
     else
     {
@@ -113,12 +233,13 @@ void SideChain::setRmsWindowSize(
 
         // logarithmic envelope reaches 90% of the final reading
         // in the given attack time
-        dRmsWindowCoefficient = exp(log(0.10) / (dRmsWindowSizeSeconds * dSampleRate));
+        dRmsWindowCoefficient = SampleType(exp(log(0.10) / (dRmsWindowSizeSeconds * dSampleRate)));
     }
 }
 
 
-int SideChain::getCurve()
+template <typename SampleType>
+int SideChain<SampleType>::getCurve()
 /*  Get current compressor curve type.
 
     return value (integer): returns compressor curve type
@@ -128,7 +249,8 @@ int SideChain::getCurve()
 }
 
 
-void SideChain::setCurve(
+template <typename SampleType>
+void SideChain<SampleType>::setCurve(
     int nCurveTypeNew)
 /*  Set new compressor curve type.
 
@@ -138,14 +260,17 @@ void SideChain::setCurve(
  */
 {
     nCurveType = nCurveTypeNew;
-    dGainReductionIntermediate = 0.0;
+    dGainReductionIntermediate = SampleType(0.0);
 
-    setAttackRate(dAttackRate);
+    // attack coefficient does not depend on curve type
     setReleaseRate(nReleaseRate);
+
+    selectBlockKernel();
 }
 
 
-int SideChain::getGainStage()
+template <typename SampleType>
+int SideChain<SampleType>::getGainStage()
 /*  Get current compressor gain stage type.
 
     return value (integer): returns compressor gain stage type
@@ -155,7 +280,8 @@ int SideChain::getGainStage()
 }
 
 
-void SideChain::setGainStage(
+template <typename SampleType>
+void SideChain<SampleType>::setGainStage(
     int nGainStageTypeNew)
 /*  Set new compressor gain stage type.
 
@@ -166,10 +292,7 @@ void SideChain::setGainStage(
 {
     nGainStageType = nGainStageTypeNew;
 
-    // update gain compensation
-    setThreshold(dThreshold);
-
-    if (nGainStageType == GainStage::FET)
+    if (nGainStageType == GainStageBase::FET)
     {
         gainStageFET.reset(dGainReduction);
     }
@@ -177,85 +300,91 @@ void SideChain::setGainStage(
     {
         gainStageOptical.reset(dGainReduction);
     }
+
+    selectBlockKernel();
 }
 
 
-double SideChain::getThreshold()
+template <typename SampleType>
+double SideChain<SampleType>::getThreshold()
 /*  Get current threshold.
 
     return value (double): returns the current threshold in decibels
  */
 {
-    return dThreshold;
+    return dThresholdTarget.get();
 }
 
 
-void SideChain::setThreshold(
+template <typename SampleType>
+void SideChain<SampleType>::setThreshold(
     double dThresholdNew)
-/*  Set new threshold.
+/*  Set new threshold.  The threshold ramps towards the new value
+    while processing.
 
     dThresholdNew (double): new threshold in decibels
 
     return value: none
  */
 {
-    dThreshold = dThresholdNew;
-    dGainCompensation = queryGainComputer(dCrestFactorAutoGain) / 2.0;
+    dThresholdTarget = SampleType(dThresholdNew);
 }
 
 
-double SideChain::getRatio()
+template <typename SampleType>
+double SideChain<SampleType>::getRatio()
 /*  Get current compression ratio.
 
     return value (double): returns the current compression ratio
  */
 {
-    return 1.0 / (1.0 - dRatioInternal);
+    return 1.0 / (1.0 - dRatioInternalTarget.get());
 }
 
 
-void SideChain::setRatio(
+template <typename SampleType>
+void SideChain<SampleType>::setRatio(
     double dRatioNew)
-/*  Set new compression ratio.
+/*  Set new compression ratio.  The ratio ramps towards the new
+    value while processing.
 
     dRatioNew (double): new compression ratio
 
     return value: none
  */
 {
-    dRatioInternal = 1.0 - (1.0 / dRatioNew);
-    dGainCompensation = queryGainComputer(dCrestFactorAutoGain) / 2.0;
+    dRatioInternalTarget = SampleType(1.0 - (1.0 / dRatioNew));
 }
 
 
-double SideChain::getKneeWidth()
+template <typename SampleType>
+double SideChain<SampleType>::getKneeWidth()
 /*  Get current knee width.
 
     return value (double): returns the current knee width in decibels
  */
 {
-    return dKneeWidth;
+    return dKneeWidthTarget.get();
 }
 
 
-void SideChain::setKneeWidth(
+template <typename SampleType>
+void SideChain<SampleType>::setKneeWidth(
     double dKneeWidthNew)
-/*  Set new knee width.
+/*  Set new knee width.  The audio thread switches to the new value
+    before processing the next block.
 
     dKneeWidthNew (double): new knee width in decibels
 
     return value: none
  */
 {
-    dKneeWidth = dKneeWidthNew;
-    dKneeWidthHalf = dKneeWidth / 2.0;
-    dKneeWidthDouble = dKneeWidth * 2.0;
-
-    dGainCompensation = queryGainComputer(dCrestFactorAutoGain) / 2.0;
+    dKneeWidthTarget = SampleType(dKneeWidthNew);
 }
 
 
-double SideChain::getAttackRate()
+template <typename SampleType>
+double SideChain<SampleType>::getAttackRate()
 /*  Get current attack rate.
 
     return value (double): returns the current attack rate in
@@ -266,33 +395,56 @@ double SideChain::getAttackRate()
 }
 
 
-void SideChain::setAttackRate(
-    double dAttackRateNew)
-/*  Set new attack rate.
+template <typename SampleType>
+void SideChain<SampleType>::setAttackRate(
+    double dAttackRateNew,
+    SampleType dAttackCoefficientNew)
+/*  Set new attack rate.  The attack coefficient is calculated by the
+    caller, so that it can be shared by all channels.
 
     dAttackRateNew (double): new attack rate in milliseconds
 
+    dAttackCoefficientNew (SampleType): matching attack coefficient
+    (see calculateAttackCoefficient)
+
     return value: none
  */
 {
     dAttackRate = dAttackRateNew;
+    dAttackCoefficient = dAttackCoefficientNew;
+}
 
-    if (dAttackRate <= 0.0)
+
+template <typename SampleType>
+SampleType SideChain<SampleType>::calculateAttackCoefficient(
+    double dAttackRateNew,
+    double dSampleRateNew)
+/*  Calculate attack coefficient.
+
+    dAttackRateNew (double): attack rate in milliseconds
+
+    dSampleRateNew (double): sample rate
+
+    return value (SampleType): attack coefficient
+ */
+{
+    if (dAttackRateNew <= 0.0)
     {
-        dAttackCoefficient = 0.0;
+        return SampleType(0.0);
     }
     else
     {
-        double dAttackRateSeconds = dAttackRate / 1000.0;
+        double dAttackRateSeconds = dAttackRateNew / 1000.0;
 
         // logarithmic envelope reaches 90% of the final reading in
         // the given attack time
-        dAttackCoefficient = exp(log(0.10) / (dAttackRateSeconds * dSampleRate));
+        return SampleType(exp(log(0.10) / (dAttackRateSeconds * dSampleRateNew)));
     }
 }
 
 
-int SideChain::getReleaseRate()
+template <typename SampleType>
+int SideChain<SampleType>::getReleaseRate()
 /*  Get current release rate.
 
     return value (integer): returns the current release rate in
@@ -303,7 +455,8 @@ int SideChain::getReleaseRate()
 }
 
 
-void SideChain::setReleaseRate(
+template <typename SampleType>
+void SideChain<SampleType>::setReleaseRate(
     int nReleaseRateNew)
 /*  Set new release rate.
 
@@ -316,7 +469,7 @@ void SideChain::setReleaseRate(
 
     if (nReleaseRate <= 0)
     {
-        dReleaseCoefficient = 0.0;
+        dReleaseCoefficient = SampleType(0.0);
     }
     else
     {
@@ -326,32 +479,33 @@ void SideChain::setReleaseRate(
         {
             // fall time: falls 10 dB per interval defined in release
             // rate (linear)
-            dReleaseCoefficient = 10.0 / (dReleaseRateSeconds * dSampleRate);
+            dReleaseCoefficient = SampleType(10.0 / (dReleaseRateSeconds * dSampleRate));
         }
         else
         {
             // logarithmic envelope reaches 90% of the final reading
             // in the given release time
-            dReleaseCoefficient = exp(log(0.10) / (dReleaseRateSeconds * dSampleRate));
+            dReleaseCoefficient = SampleType(exp(log(0.10) / (dReleaseRateSeconds * dSampleRate)));
         }
     }
 }
 
 
-double SideChain::getGainReduction(
+template <typename SampleType>
+SampleType SideChain<SampleType>::getGainReduction(
     bool bAutoMakeupGain)
 /*  Get current gain reduction.
 
     bAutoMakeupGain (boolean): determines whether the gain reduction
     should be level compensated or not
 
-    return value (double): returns the current gain reduction in
+    return value (SampleType): returns the current gain reduction in
     decibel
  */
 {
-    double dGainReductionTemp;
+    SampleType dGainReductionTemp;
 
-    if (nGainStageType == GainStage::FET)
+    if (nGainStageType == GainStageBase::FET)
     {
         dGainReductionTemp = gainStageFET.processGainReduction(dGainReduction, dGainReductionIdeal);
     }
@@ -372,22 +526,23 @@ double SideChain::getGainReduction(
 }
 
 
-double SideChain::queryGainComputer(
-    double dInputLevel)
+template <typename SampleType>
+SampleType SideChain<SampleType>::queryGainComputer(
+    SampleType dInputLevel)
 /*  Calculate gain reduction and envelopes from input level.
 
-    dInputLevel (double): current input level in decibels
+    dInputLevel (SampleType): current input level in decibels
 
     return value: calculated gain reduction in decibels
  */
 {
-    double dAboveThreshold = dInputLevel - dThreshold;
+    SampleType dAboveThreshold = dInputLevel - dThreshold;
 
     if (dKneeWidth == 0.0)
     {
         if (dInputLevel <= dThreshold)
         {
-            return 0.0;
+            return SampleType(0.0);
         }
         else
         {
@@ -401,7 +556,7 @@ double SideChain::queryGainComputer(
         // 60(6):399-408, 2012
         if (dAboveThreshold < -dKneeWidthHalf)
         {
-            return 0.0;
+            return SampleType(0.0);
         }
         else if (dAboveThreshold > dKneeWidthHalf)
         {
@@ -409,8 +564,8 @@ double SideChain::queryGainComputer(
         }
         else
         {
-            double dFactor = dAboveThreshold + dKneeWidthHalf;
-            double dFactorSquared = dFactor * dFactor;
+            SampleType dFactor = dAboveThreshold + dKneeWidthHalf;
+            SampleType dFactorSquared = dFactor * dFactor;
 
             return dFactorSquared / dKneeWidthDouble * dRatioInternal;
         }
@@ -418,20 +573,183 @@ double SideChain::queryGainComputer(
 }
 
 
-void SideChain::processSample(
-    double dInputLevel)
+template <typename SampleType>
+void SideChain<SampleType>::processSample(
+    SampleType dInputLevel)
 /*  Process a single audio sample value.
 
-    dInputLevel (double): current audio sample value in decibels
+    dInputLevel (SampleType): current audio sample value in decibels
 
     return value: current gain reduction in decibels
 */
 {
+    // advance parameter ramps
+    if (isSmoothing())
+    {
+        updateSmoothedValues();
+    }
+
     // feed input level to gain computer
     dGainReductionIdeal = queryGainComputer(dInputLevel);
 
+    // feed output from gain computer to level detector
+    applyDetector();
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::processBlock(
+    const SampleType *dInputLevels,
+    SampleType *dGainReductions,
+    SampleType *dGainReductionsWithMakeup,
+    int nNumSamples)
+/*  Process a block of audio sample values.
+
+    dInputLevels (pointer to SampleType): audio sample values in decibels
+
+    dGainReductions (pointer to SampleType): receives the gain reduction
+    of each sample in decibels
+
+    dGainReductionsWithMakeup (pointer to SampleType): receives the
+    level-compensated gain reduction of each sample in decibels
+
+    nNumSamples (integer): number of samples to process
+
+    return value: none
+*/
+{
+    // threshold and ratio are ramping, so gain computer and gain
+    // compensation have to be updated sample by sample (release rate
+    // is only measured by the generic level detector)
+    if (isSmoothing() || DEBUG_RELEASE_RATE)
+    {
+        for (int nSample = 0; nSample < nNumSamples; ++nSample)
+        {
+            processSample(dInputLevels[nSample]);
+
+            dGainReductions[nSample] = getGainReduction(false);
+            dGainReductionsWithMakeup[nSample] = getGainReduction(true);
+        }
+
+        return;
+    }
+
+    // the gain computer has no memory, so feed it the whole block
+    // at once (gain reductions are stored in place and handed to the
+    // level detector below)
+    for (int nSample = 0; nSample < nNumSamples; ++nSample)
+    {
+        dGainReductions[nSample] = queryGainComputer(dInputLevels[nSample]);
+    }
+
+    // level detector, envelopes and gain stage are recursive and
+    // must be run sample by sample
+    (this->*blockKernel)(dGainReductions, dGainReductionsWithMakeup,
+                         nNumSamples);
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::selectBlockKernel()
+/*  Select block kernel for current curve and gain stage type.  Call
+    this whenever one of these types changes.
+
+    return value: none
+*/
+{
+    // kernels are indexed by curve type and gain stage type
+    static const BlockKernel blockKernels[NumberOfCurves][GainStageBase::NumberOfGainStages] =
+    {
+        {
+            &SideChain::template processDetectorBlock<CurveLogLin, GainStageBase::FET>,
+            &SideChain::template processDetectorBlock<CurveLogLin, GainStageBase::Optical>
+        },
+        {
+            &SideChain::template processDetectorBlock<CurveLogSmoothDecoupled, GainStageBase::FET>,
+            &SideChain::template processDetectorBlock<CurveLogSmoothDecoupled, GainStageBase::Optical>
+        },
+        {
+            &SideChain::template processDetectorBlock<CurveLogSmoothBranching, GainStageBase::FET>,
+            &SideChain::template processDetectorBlock<CurveLogSmoothBranching, GainStageBase::Optical>
+        }
+    };
+
+    jassert((nCurveType >= 0) && (nCurveType < NumberOfCurves));
+    jassert((nGainStageType >= 0) && (nGainStageType < GainStageBase::NumberOfGainStages));
+
+    blockKernel = blockKernels[nCurveType][nGainStageType];
+}
+
+
+template <typename SampleType>
+template <int nCurveTypeKernel, int nGainStageTypeKernel>
+void SideChain<SampleType>::processDetectorBlock(
+    SampleType *dGainReductions,
+    SampleType *dGainReductionsWithMakeup,
+    int nNumSamples)
+/*  Feed a block of gain computer output to level detector, envelope
+    and gain stage.  Curve and gain stage type are resolved at compile
+    time, so the loop does not branch on them.
+
+    dGainReductions (pointer to SampleType): output of gain computer
+    in decibels; receives the gain reduction of each sample in
+    decibels
+
+    dGainReductionsWithMakeup (pointer to SampleType): receives the
+    level-compensated gain reduction of each sample in decibels
+
+    nNumSamples (integer): number of samples to process
+
+    return value: none
+*/
+{
+    std::integral_constant<int, nCurveTypeKernel> curveType;
+    auto &gainStage = selectGainStage(
+                          std::integral_constant<int, nGainStageTypeKernel>());
+
+    if (nNumSamples <= 0)
+    {
+        return;
+    }
+
+    // level detector does not depend on the gain stage, so it can
+    // run first (its output is buffered in the make-up array)
+    for (int nSample = 0; nSample < nNumSamples; ++nSample)
+    {
+        // filter calculated gain reduction through level detection
+        // filter and feed it to level detector
+        SampleType dGainReductionNew = applyRmsFilter(dGainReductions[nSample]);
+        applyCurve(dGainReductionNew, curveType);
+
+        dGainReductionsWithMakeup[nSample] = dGainReduction;
+    }
+
+    dGainReductionIdeal = dGainReductions[nNumSamples - 1];
+
+    // the gain stage processes every sample twice, exactly as in the
+    // per-sample path, because gain stages update their state on
+    // every call
+    gainStage.processGainReduction(dGainReductionsWithMakeup,
+                                   dGainReductions,
+                                   dGainReductions,
+                                   dGainReductionsWithMakeup,
+                                   nNumSamples);
+
+    FloatVectorOperations::add(dGainReductionsWithMakeup,
+                               -dGainCompensation,
+                               nNumSamples);
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::applyDetector()
+/*  Feed current output of gain computer to level detector.
+
+    return value: none
+*/
+{
     // filter calculated gain reduction through level detection filter
-    double dGainReductionNew = applyRmsFilter(dGainReductionIdeal);
+    SampleType dGainReductionNew = applyRmsFilter(dGainReductionIdeal);
 
     // feed output from gain computer to level detector
     switch (nCurveType)
@@ -449,7 +767,7 @@ void SideChain::processSample(
         break;
 
     default:
-        DBG("[Squeezer] sidechain::processSample ==> invalid detector");
+        DBG("[Squeezer] sidechain::applyDetector ==> invalid detector");
         break;
     }
 
@@ -499,8 +817,9 @@ void SideChain::processSample(
 }
 
 
-double SideChain::applyRmsFilter(
-    double dDetectorInputLevel)
+template <typename SampleType>
+SampleType SideChain<SampleType>::applyRmsFilter(
+    SampleType dDetectorInputLevel)
 {
     // bypass RMS sensing
     if (dRmsWindowSizeMilliSeconds <= 0.0)
@@ -509,23 +828,24 @@ double SideChain::applyRmsFilter(
     }
     else
     {
-        double dDetectorInputLevelSquared = dDetectorInputLevel * dDetectorInputLevel;
-        double dDetectorOutputLevelSquaredOld = dDetectorOutputLevelSquared;
+        SampleType dDetectorInputLevelSquared = dDetectorInputLevel * dDetectorInputLevel;
+        SampleType dDetectorOutputLevelSquaredOld = dDetectorOutputLevelSquared;
 
-        dDetectorOutputLevelSquared = (dRmsWindowCoefficient * dDetectorOutputLevelSquaredOld) + (1.0 - dRmsWindowCoefficient) * dDetectorInputLevelSquared;
+        dDetectorOutputLevelSquared = (dRmsWindowCoefficient * dDetectorOutputLevelSquaredOld) + (SampleType(1.0) - dRmsWindowCoefficient) * dDetectorInputLevelSquared;
 
-        double dDetectorOutputLevel = sqrt(dDetectorOutputLevelSquared);
+        SampleType dDetectorOutputLevel = std::sqrt(dDetectorOutputLevelSquared);
         return dDetectorOutputLevel;
     }
 }
 
 
-void SideChain::applyCurveLogLin(
-    double dGainReductionNew)
+template <typename SampleType>
+void SideChain<SampleType>::applyCurveLogLin(
+    SampleType dGainReductionNew)
 /*  Calculate detector with logarithmic attack and linear release
     ("Linear").
 
-    dGainReductionNew (double): calculated new gain reduction in
+    dGainReductionNew (SampleType): calculated new gain reduction in
     decibels
 
     return value: none
@@ -545,8 +865,8 @@ void SideChain::applyCurveLogLin(
             // Dynamic Range Compressor Design - A Tutorial and
             // Analysis", JAES, 60(6):399-408, 2012
 
-            double dGainReductionOld = dGainReduction;
-            dGainReduction = (dAttackCoefficient * dGainReductionOld) + (1.0 - dAttackCoefficient) * dGainReductionNew;
+            SampleType dGainReductionOld = dGainReduction;
+            dGainReduction = (dAttackCoefficient * dGainReductionOld) + (SampleType(1.0) - dAttackCoefficient) * dGainReductionNew;
         }
     }
     // otherwise, apply release rate if proposed gain reduction is
@@ -570,11 +890,12 @@ void SideChain::applyCurveLogLin(
 }
 
 
-void SideChain::applyCurveLogSmoothDecoupled(
-    double dGainReductionNew)
+template <typename SampleType>
+void SideChain<SampleType>::applyCurveLogSmoothDecoupled(
+    SampleType dGainReductionNew)
 /*  Calculate smooth decoupled detector ("Smooth").
 
-    dGainReductionNew (double): calculated gain reduction in decibels
+    dGainReductionNew (SampleType): calculated gain reduction in decibels
 
     return value: none
 */
@@ -590,8 +911,8 @@ void SideChain::applyCurveLogSmoothDecoupled(
     }
     else
     {
-        double dGainReductionIntermediateOld = dGainReductionIntermediate;
-        dGainReductionIntermediate = (dReleaseCoefficient * dGainReductionIntermediateOld) + (1.0 - dReleaseCoefficient) * dGainReductionNew;
+        SampleType dGainReductionIntermediateOld = dGainReductionIntermediate;
+        dGainReductionIntermediate = (dReleaseCoefficient * dGainReductionIntermediateOld) + (SampleType(1.0) - dReleaseCoefficient) * dGainReductionNew;
 
         // maximally fast peak detection
         if (dGainReductionNew > dGainReductionIntermediate)
@@ -607,17 +928,18 @@ void SideChain::applyCurveLogSmoothDecoupled(
     }
     else
     {
-        double dGainReductionOld = dGainReduction;
-        dGainReduction = (dAttackCoefficient * dGainReductionOld) + (1.0 - dAttackCoefficient) * dGainReductionIntermediate;
+        SampleType dGainReductionOld = dGainReduction;
+        dGainReduction = (dAttackCoefficient * dGainReductionOld) + (SampleType(1.0) - dAttackCoefficient) * dGainReductionIntermediate;
     }
 }
 
 
-void SideChain::applyCurveLogSmoothBranching(
-    double dGainReductionNew)
+template <typename SampleType>
+void SideChain<SampleType>::applyCurveLogSmoothBranching(
+    SampleType dGainReductionNew)
 /*  Calculate smooth branching detector ("Logarithmic").
 
-    dGainReductionNew (double): calculated gain reduction in decibels
+    dGainReductionNew (SampleType): calculated gain reduction in decibels
 
     return value: none
 */
@@ -636,8 +958,8 @@ void SideChain::applyCurveLogSmoothBranching(
             // Dynamic Range Compressor Design - A Tutorial and
             // Analysis", JAES, 60(6):399-408, 2012
 
-            double dGainReductionOld = dGainReduction;
-            dGainReduction = (dAttackCoefficient * dGainReductionOld) + (1.0 - dAttackCoefficient) * dGainReductionNew;
+            SampleType dGainReductionOld = dGainReduction;
+            dGainReduction = (dAttackCoefficient * dGainReductionOld) + (SampleType(1.0) - dAttackCoefficient) * dGainReductionNew;
         }
     }
     // otherwise, apply release rate if proposed gain reduction is
@@ -654,25 +976,26 @@ void SideChain::applyCurveLogSmoothBranching(
             // Dynamic Range Compressor Design - A Tutorial and
             // Analysis", JAES, 60(6):399-408, 2012
 
-            double dGainReductionOld = dGainReduction;
-            dGainReduction = (dReleaseCoefficient * dGainReductionOld) + (1.0 - dReleaseCoefficient) * dGainReductionNew;
+            SampleType dGainReductionOld = dGainReduction;
+            dGainReduction = (dReleaseCoefficient * dGainReductionOld) + (SampleType(1.0) - dReleaseCoefficient) * dGainReductionNew;
         }
     }
 }
 
 
-double SideChain::level2decibel(
-    double dLevel)
+template <typename SampleType>
+SampleType SideChain<SampleType>::level2decibel(
+    SampleType dLevel)
 /*  Convert level from linear scale to decibels (dB).
 
-    dLevel (double): audio level
+    dLevel (SampleType): audio level
 
-    return value (double): returns given level in decibels (dB) when
+    return value (SampleType): returns given level in decibels (dB) when
     above "dMeterMinimumDecibel", otherwise "dMeterMinimumDecibel"
 */
 {
     // just an inch below the meter's lowest segment
-    double dMeterMinimumDecibel = -70.01;
+    SampleType dMeterMinimumDecibel = SampleType(-70.01);
 
     // log(0) is not defined, so return "fMeterMinimumDecibel"
     if (dLevel == 0.0)
@@ -684,7 +1007,7 @@ double SideChain::level2decibel(
         // calculate decibels from audio level (a factor of 20.0 is
         // needed to calculate *level* ratios, whereas 10.0 is needed
         // for *power* ratios!)
-        double dDecibels = 20.0 * log10(dLevel);
+        SampleType dDecibels = SampleType(20.0) * std::log10(dLevel);
 
         // to make meter ballistics look nice for low levels, do not
         // return levels below "fMeterMinimumDecibel"
@@ -700,18 +1023,98 @@ double SideChain::level2decibel(
 }
 
 
-double SideChain::decibel2level(
-    double dDecibels)
+template <typename SampleType>
+SampleType SideChain<SampleType>::decibel2level(
+    SampleType dDecibels)
 /*  Convert level from decibels (dB) to linear scale.
 
-    dLevel (double): audio level in decibels (dB)
+    dLevel (SampleType): audio level in decibels (dB)
 
-    return value (double): given level in linear scale
+    return value (SampleType): given level in linear scale
 */
 {
     // calculate audio level from decibels (a divisor of 20.0 is
     // needed to calculate *level* ratios, whereas 10.0 is needed for
     // *power* ratios!)
-    double dLevel = pow(10.0, dDecibels / 20.0);
+    SampleType dLevel = std::pow(SampleType(10.0), dDecibels / SampleType(20.0));
     return dLevel;
 }
+
+
+template <typename SampleType>
+void SideChain<SampleType>::level2decibel(
+    const SampleType *dLevels,
+    SampleType *dDecibels,
+    int nNumSamples)
+/*  Convert block of levels from linear scale to decibels (dB) using
+    a fast approximation (error is below 1e-10 dB in double and 1e-4
+    dB in single precision).  Input and output may point to the same
+    memory.
+
+    dLevels (SampleType pointer): audio levels
+
+    dDecibels (SampleType pointer): receives given levels in decibels
+    (dB) when above "dMeterMinimumDecibel", otherwise
+    "dMeterMinimumDecibel"
+
+    nNumSamples (integer): number of levels to convert
+
+    return value: none
+*/
+{
+    // just an inch below the meter's lowest segment
+    SampleType dMeterMinimumDecibel = SampleType(-70.01);
+
+    // zero levels yield very low decibel values which are then
+    // limited to "dMeterMinimumDecibel"
+    frut::math::FastMath::log10(dLevels, dDecibels, nNumSamples);
+
+    for (int nSample = 0; nSample < nNumSamples; ++nSample)
+    {
+        // calculate decibels from audio level (a factor of 20.0 is
+        // needed to calculate *level* ratios, whereas 10.0 is needed
+        // for *power* ratios!)
+        SampleType dDecibelsNew = SampleType(20.0) * dDecibels[nSample];
+
+        // to make meter ballistics look nice for low levels, do not
+        // return levels below "fMeterMinimumDecibel"
+        dDecibels[nSample] = (dDecibelsNew < dMeterMinimumDecibel) ?
+                             dMeterMinimumDecibel : dDecibelsNew;
+    }
+}
+
+
+template <typename SampleType>
+void SideChain<SampleType>::decibel2level(
+    const SampleType *dDecibels,
+    SampleType *dLevels,
+    int nNumSamples)
+/*  Convert block of levels from decibels (dB) to linear scale using
+    a fast approximation (error is below 1e-12 dB in double and 1e-4
+    dB in single precision).  Input and output may point to the same
+    memory.
+
+    dDecibels (SampleType pointer): audio levels in decibels (dB)
+
+    dLevels (SampleType pointer): receives given levels in linear scale
+
+    nNumSamples (integer): number of levels to convert
+
+    return value: none
+*/
+{
+    // calculate audio level from decibels (a divisor of 20.0 is
+    // needed to calculate *level* ratios, whereas 10.0 is needed for
+    // *power* ratios!)
+    for (int nSample = 0; nSample < nNumSamples; ++nSample)
+    {
+        dLevels[nSample] = dDecibels[nSample] / SampleType(20.0);
+    }
+
+    frut::math::FastMath::exp10(dLevels, dLevels, nNumSamples);
+}
+
+
+// explicit instantiation of all template instances
+template class SideChain<float>;
+template class SideChain<double>;
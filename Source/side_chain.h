@@ -34,7 +34,7 @@
 #include "gain_stage_optical.h"
 
 
-class SideChain
+class SideChainBase
 {
 public:
     enum Parameters  // public namespace!
@@ -45,9 +45,21 @@ public:
         NumberOfCurves,
     };
 
+    // length of parameter ramps in seconds
+    static constexpr double SmoothingLength = 0.020;
+};
+
+
+template <typename SampleType>
+class SideChain :
+    public SideChainBase
+{
+public:
     explicit SideChain(int nSampleRate);
 
     void reset();
+    void skipSmoothing();
+    void updateSmoothingTargets();
 
     double getRmsWindowSize();
     void setRmsWindowSize(double dRmsWindowSizeMilliSecondsNew);
@@ -68,61 +80,136 @@ public:
     void setKneeWidth(double dKneeWidthNew);
 
     double getAttackRate();
-    void setAttackRate(double dAttackRateNew);
+    void setAttackRate(double dAttackRateNew,
+                       SampleType dAttackCoefficientNew);
+
+    static SampleType calculateAttackCoefficient(double dAttackRateNew,
+                                                 double dSampleRateNew);
 
     int getReleaseRate();
     void setReleaseRate(int nReleaseRateNew);
 
-    double getGainReduction(bool bAutoMakeupGain);
+    SampleType getGainReduction(bool bAutoMakeupGain);
+
+    void processSample(SampleType dSampleValue);
+    void processBlock(const SampleType *dInputLevels,
+                      SampleType *dGainReductions,
+                      SampleType *dGainReductionsWithMakeup,
+                      int nNumSamples);
 
-    void processSample(double dSampleValue);
+    static SampleType level2decibel(SampleType dLevel);
+    static SampleType decibel2level(SampleType dDecibels);
 
-    static double level2decibel(double dLevel);
-    static double decibel2level(double dDecibels);
+    static void level2decibel(const SampleType *dLevels,
+                              SampleType *dDecibels,
+                              int nNumSamples);
+    static void decibel2level(const SampleType *dDecibels,
+                              SampleType *dLevels,
+                              int nNumSamples);
 private:
     JUCE_LEAK_DETECTOR(SideChain);
 
 #if DEBUG_RELEASE_RATE
-    double dTimePassed;
+    SampleType dTimePassed;
 
-    double dDebugFinalValue90;
-    double dDebugTimeInReleasePhase;
+    SampleType dDebugFinalValue90;
+    SampleType dDebugTimeInReleasePhase;
 #endif
 
-    GainStageFET gainStageFET;
-    GainStageOptical gainStageOptical;
+    GainStageFET<SampleType> gainStageFET;
+    GainStageOptical<SampleType> gainStageOptical;
 
     double dSampleRate;
-    double dCrestFactorAutoGain;
-    double dGainReduction;
-    double dGainReductionIdeal;
-    double dGainReductionIntermediate;
-    double dGainCompensation;
+    SampleType dCrestFactorAutoGain;
+    SampleType dGainReduction;
+    SampleType dGainReductionIdeal;
+    SampleType dGainReductionIntermediate;
+    SampleType dGainCompensation;
 
-    double dRmsWindowCoefficient;
-    double dDetectorOutputLevelSquared;
+    SampleType dRmsWindowCoefficient;
+    SampleType dDetectorOutputLevelSquared;
 
     double dRmsWindowSizeMilliSeconds;
     int nCurveType;
     int nGainStageType;
 
-    double dThreshold;
-    double dRatioInternal;
-    double dKneeWidth;
-    double dKneeWidthHalf;
-    double dKneeWidthDouble;
+    SampleType dThreshold;
+    SampleType dRatioInternal;
+
+    // targets are set by any thread, but ramps are only touched by
+    // the audio thread
+    Atomic<SampleType> dThresholdTarget;
+    Atomic<SampleType> dRatioInternalTarget;
+    Atomic<SampleType> dKneeWidthTarget;
+
+    SmoothedValue<SampleType> smoothedThreshold;
+    SmoothedValue<SampleType> smoothedRatioInternal;
+    SampleType dKneeWidth;
+    SampleType dKneeWidthHalf;
+    SampleType dKneeWidthDouble;
 
     double dAttackRate;
-    double dAttackCoefficient;
+    SampleType dAttackCoefficient;
 
     int nReleaseRate;
-    double dReleaseCoefficient;
+    SampleType dReleaseCoefficient;
+
+    // block kernel specialised for current curve and gain stage type
+    typedef void (SideChain::*BlockKernel)(SampleType *dGainReductions,
+                                           SampleType *dGainReductionsWithMakeup,
+                                           int nNumSamples);
+    BlockKernel blockKernel;
+
+    void selectBlockKernel();
+
+    template <int nCurveTypeKernel, int nGainStageTypeKernel>
+    void processDetectorBlock(SampleType *dGainReductions,
+                              SampleType *dGainReductionsWithMakeup,
+                              int nNumSamples);
+
+    bool isSmoothing();
+    void updateSmoothedValues();
+    void updateKneeWidth();
+    void updateGainCompensation();
+
+    SampleType queryGainComputer(SampleType dInputLevel);
+    void applyDetector();
+    SampleType applyRmsFilter(SampleType dDetectorInputLevel);
+    void applyCurveLogLin(SampleType dGainReductionNew);
+    void applyCurveLogSmoothDecoupled(SampleType dGainReductionNew);
+    void applyCurveLogSmoothBranching(SampleType dGainReductionNew);
+
+    // resolve curve and gain stage type at compile time (used by
+    // block kernels)
+    void applyCurve(SampleType dGainReductionNew,
+                    std::integral_constant<int, CurveLogLin>)
+    {
+        applyCurveLogLin(dGainReductionNew);
+    }
+
+    void applyCurve(SampleType dGainReductionNew,
+                    std::integral_constant<int, CurveLogSmoothDecoupled>)
+    {
+        applyCurveLogSmoothDecoupled(dGainReductionNew);
+    }
+
+    void applyCurve(SampleType dGainReductionNew,
+                    std::integral_constant<int, CurveLogSmoothBranching>)
+    {
+        applyCurveLogSmoothBranching(dGainReductionNew);
+    }
+
+    GainStageFET<SampleType> &selectGainStage(
+        std::integral_constant<int, GainStageBase::FET>)
+    {
+        return gainStageFET;
+    }
 
-    double queryGainComputer(double dInputLevel);
-    double applyRmsFilter(double dDetectorInputLevel);
-    void applyCurveLogLin(double dGainReductionNew);
-    void applyCurveLogSmoothDecoupled(double dGainReductionNew);
-    void applyCurveLogSmoothBranching(double dGainReductionNew);
+    GainStageOptical<SampleType> &selectGainStage(
+        std::integral_constant<int, GainStageBase::Optical>)
+    {
+        return gainStageOptical;
+    }
 };
 
 #endif  // SQUEEZER_SIDE_CHAIN_H
@@ -0,0 +1,225 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+// Replaces the global allocation functions of the validator, so that
+// memory allocated while a frut::audio::AllocationGuard is alive
+// triggers an assertion.  Only compile this file into executables;
+// in a plug-in, the replacement would affect the whole host process.
+
+#include "FrutHeader.h"
+
+#include <cstdlib>
+#include <new>
+
+
+#if FRUT_AUDIO_ALLOCATION_GUARD
+
+static void *allocateMemory(std::size_t Size)
+{
+    frut::audio::AllocationGuard::checkAllocation();
+
+    return std::malloc((Size > 0) ? Size : 1);
+}
+
+
+void *operator new(std::size_t Size)
+{
+    void *Memory = allocateMemory(Size);
+
+    if (Memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return Memory;
+}
+
+
+void *operator new[](std::size_t Size)
+{
+    return operator new(Size);
+}
+
+
+void *operator new(std::size_t Size, const std::nothrow_t &) noexcept
+{
+    return allocateMemory(Size);
+}
+
+
+void *operator new[](std::size_t Size, const std::nothrow_t &) noexcept
+{
+    return allocateMemory(Size);
+}
+
+
+void operator delete(void *Memory) noexcept
+{
+    std::free(Memory);
+}
+
+
+void operator delete[](void *Memory) noexcept
+{
+    std::free(Memory);
+}
+
+
+void operator delete(void *Memory, std::size_t) noexcept
+{
+    std::free(Memory);
+}
+
+
+void operator delete[](void *Memory, std::size_t) noexcept
+{
+    std::free(Memory);
+}
+
+
+void operator delete(void *Memory, const std::nothrow_t &) noexcept
+{
+    std::free(Memory);
+}
+
+
+void operator delete[](void *Memory, const std::nothrow_t &) noexcept
+{
+    std::free(Memory);
+}
+
+
+#if __cpp_aligned_new
+
+// over-aligned types (C++17)
+
+static void *allocateAlignedMemory(std::size_t Size,
+                                   std::align_val_t Alignment)
+{
+    frut::audio::AllocationGuard::checkAllocation();
+
+    std::size_t AlignmentBytes = jmax(static_cast<std::size_t>(Alignment),
+                                      sizeof(void *));
+
+    Size = (Size > 0) ? Size : 1;
+
+#ifdef _MSC_VER
+    return _aligned_malloc(Size, AlignmentBytes);
+#else
+    void *Memory = nullptr;
+
+    if (posix_memalign(&Memory, AlignmentBytes, Size) != 0)
+    {
+        return nullptr;
+    }
+
+    return Memory;
+#endif
+}
+
+
+static void freeAlignedMemory(void *Memory)
+{
+#ifdef _MSC_VER
+    _aligned_free(Memory);
+#else
+    std::free(Memory);
+#endif
+}
+
+
+void *operator new(std::size_t Size, std::align_val_t Alignment)
+{
+    void *Memory = allocateAlignedMemory(Size, Alignment);
+
+    if (Memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return Memory;
+}
+
+
+void *operator new[](std::size_t Size, std::align_val_t Alignment)
+{
+    return operator new(Size, Alignment);
+}
+
+
+void *operator new(std::size_t Size, std::align_val_t Alignment,
+                   const std::nothrow_t &) noexcept
+{
+    return allocateAlignedMemory(Size, Alignment);
+}
+
+
+void *operator new[](std::size_t Size, std::align_val_t Alignment,
+                     const std::nothrow_t &) noexcept
+{
+    return allocateAlignedMemory(Size, Alignment);
+}
+
+
+void operator delete(void *Memory, std::align_val_t) noexcept
+{
+    freeAlignedMemory(Memory);
+}
+
+
+void operator delete[](void *Memory, std::align_val_t) noexcept
+{
+    freeAlignedMemory(Memory);
+}
+
+
+void operator delete(void *Memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAlignedMemory(Memory);
+}
+
+
+void operator delete[](void *Memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAlignedMemory(Memory);
+}
+
+
+void operator delete(void *Memory, std::align_val_t,
+                     const std::nothrow_t &) noexcept
+{
+    freeAlignedMemory(Memory);
+}
+
+
+void operator delete[](void *Memory, std::align_val_t,
+                       const std::nothrow_t &) noexcept
+{
+    freeAlignedMemory(Memory);
+}
+
+#endif  // __cpp_aligned_new
+
+#endif  // FRUT_AUDIO_ALLOCATION_GUARD
@@ -0,0 +1,375 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "batch_renderer.h"
+
+
+BatchRenderer::BatchRenderer(int number_of_threads, int maximum_block_size)
+{
+    jassert(number_of_threads > 0);
+
+    for (int WorkerIndex = 0; WorkerIndex < number_of_threads; ++WorkerIndex)
+    {
+        Workers.add(new Worker(*this, WorkerIndex, maximum_block_size));
+    }
+
+    StartTicks = 0;
+    StopTicks = 0;
+}
+
+
+BatchRenderer::~BatchRenderer()
+{
+    stop();
+}
+
+
+bool BatchRenderer::loadPreset(const File &PresetFile)
+/*  Load parameter values from preset file into all workers.
+
+    PresetFile (File): preset file
+
+    return value (boolean): returns false on error
+ */
+{
+    for (auto CurrentWorker : Workers)
+    {
+        if (!CurrentWorker->Renderer.loadPreset(PresetFile))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void BatchRenderer::addJob(const File &InputFile,
+                           const File &OutputFile)
+/*  Add file to be rendered.  Must not be called after start().
+
+    InputFile (File): audio file to be rendered
+
+    OutputFile (File): rendered WAV file (will be overwritten)
+
+    return value: none
+ */
+{
+    jassert(StartTicks == 0);
+
+    Job NewJob;
+
+    NewJob.InputFile = InputFile;
+    NewJob.OutputFile = OutputFile;
+    NewJob.HasFailed = false;
+
+    Jobs.add(NewJob);
+}
+
+
+void BatchRenderer::start()
+/*  Deal out jobs to workers and start rendering.
+
+    return value: none
+ */
+{
+    jassert(StartTicks == 0);
+
+    for (int JobIndex = 0; JobIndex < Jobs.size(); ++JobIndex)
+    {
+        Workers[JobIndex % Workers.size()]->pushJob(JobIndex);
+    }
+
+    StartTicks = Time::getHighResolutionTicks();
+
+    if (Jobs.isEmpty())
+    {
+        StopTicks = StartTicks;
+        return;
+    }
+
+    for (auto CurrentWorker : Workers)
+    {
+        CurrentWorker->startThread();
+    }
+}
+
+
+void BatchRenderer::stop()
+/*  Wait for workers to finish their current file and stop them.
+    Jobs that have not been started yet are skipped.
+
+    return value: none
+ */
+{
+    for (auto CurrentWorker : Workers)
+    {
+        CurrentWorker->signalThreadShouldExit();
+    }
+
+    for (auto CurrentWorker : Workers)
+    {
+        CurrentWorker->stopThread(-1);
+    }
+}
+
+
+bool BatchRenderer::isFinished()
+/*  Check whether all jobs have been rendered.
+
+    return value (boolean): returns true if all jobs have been
+    rendered (successfully or not)
+ */
+{
+    return FinishedJobs.get() == Jobs.size();
+}
+
+
+int BatchRenderer::getNumberOfThreads()
+{
+    return Workers.size();
+}
+
+
+int BatchRenderer::getNumberOfJobs()
+{
+    return Jobs.size();
+}
+
+
+int BatchRenderer::getNumberOfFinishedJobs()
+{
+    return FinishedJobs.get();
+}
+
+
+int BatchRenderer::getNumberOfFailedJobs()
+{
+    return FailedJobs.get();
+}
+
+
+int64 BatchRenderer::getNumberOfSamples()
+/*  Get number of samples rendered so far (per channel, summed over
+    all files).
+
+    return value (int64): number of rendered samples
+ */
+{
+    return RenderedSamples.get();
+}
+
+
+double BatchRenderer::getElapsedTime()
+/*  Get wall-clock time since start of rendering.  Stops counting
+    once the last job has been rendered.
+
+    return value (double): elapsed time in seconds
+ */
+{
+    if (StartTicks == 0)
+    {
+        return 0.0;
+    }
+
+    int64 CurrentTicks = StopTicks.get();
+
+    if (CurrentTicks == 0)
+    {
+        CurrentTicks = Time::getHighResolutionTicks();
+    }
+
+    return Time::highResolutionTicksToSeconds(CurrentTicks - StartTicks);
+}
+
+
+double BatchRenderer::getSamplesPerSecond()
+/*  Get aggregate throughput of all workers.
+
+    return value (double): rendered samples per second of wall-clock
+    time
+ */
+{
+    double ElapsedTime = getElapsedTime();
+
+    if (ElapsedTime <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return (double) getNumberOfSamples() / ElapsedTime;
+}
+
+
+StringArray BatchRenderer::getErrorMessages()
+/*  Get error messages of all failed jobs.  Only call this after
+    rendering has finished or has been stopped.
+
+    return value (StringArray): one message per failed job
+ */
+{
+    StringArray ErrorMessages;
+
+    for (auto &CurrentJob : Jobs)
+    {
+        if (CurrentJob.HasFailed)
+        {
+            ErrorMessages.add(CurrentJob.InputFile.getFullPathName() +
+                              ": " + CurrentJob.ErrorMessage);
+        }
+    }
+
+    return ErrorMessages;
+}
+
+
+bool BatchRenderer::findJob(int WorkerIndex,
+                            int &JobIndex)
+/*  Find next job for a worker: take the oldest job from its own
+    queue or, if that is empty, steal the newest job of another
+    worker (starting with its neighbour to spread the thieves).
+
+    WorkerIndex (integer): index of worker looking for work
+
+    JobIndex (integer): receives index of found job
+
+    return value (boolean): returns false if no jobs are left
+ */
+{
+    if (Workers[WorkerIndex]->popJob(JobIndex))
+    {
+        return true;
+    }
+
+    for (int Offset = 1; Offset < Workers.size(); ++Offset)
+    {
+        int VictimIndex = (WorkerIndex + Offset) % Workers.size();
+
+        if (Workers[VictimIndex]->stealJob(JobIndex))
+        {
+            return true;
+        }
+    }
+
+    // jobs are never added after start, so all queues stay empty
+    return false;
+}
+
+
+void BatchRenderer::finishJob(int JobIndex,
+                              int64 NumberOfSamples)
+/*  Book-keeping after a job has been rendered (called by workers).
+
+    JobIndex (integer): index of rendered job
+
+    NumberOfSamples (int64): number of rendered samples
+
+    return value: none
+ */
+{
+    if (Jobs.getReference(JobIndex).HasFailed)
+    {
+        ++FailedJobs;
+    }
+    else
+    {
+        RenderedSamples += NumberOfSamples;
+    }
+
+    if (++FinishedJobs == Jobs.size())
+    {
+        StopTicks = Time::getHighResolutionTicks();
+    }
+}
+
+
+BatchRenderer::Worker::Worker(BatchRenderer &owner,
+                              int index,
+                              int maximum_block_size) :
+    Thread("Squeezer batch worker " + String(index + 1)),
+    Renderer(maximum_block_size),
+    Owner(owner),
+    Index(index)
+{
+}
+
+
+void BatchRenderer::Worker::run()
+{
+    int JobIndex;
+
+    while (!threadShouldExit() && Owner.findJob(Index, JobIndex))
+    {
+        // every job is only taken once, so no locking is needed
+        Job &CurrentJob = Owner.Jobs.getReference(JobIndex);
+
+        if (!Renderer.render(CurrentJob.InputFile, CurrentJob.OutputFile))
+        {
+            CurrentJob.HasFailed = true;
+            CurrentJob.ErrorMessage = Renderer.getErrorMessage();
+        }
+
+        Owner.finishJob(JobIndex, Renderer.getNumberOfSamples());
+    }
+}
+
+
+bool BatchRenderer::Worker::popJob(int &JobIndex)
+{
+    const ScopedLock Lock(QueueLock);
+
+    if (Queue.empty())
+    {
+        return false;
+    }
+
+    JobIndex = Queue.front();
+    Queue.pop_front();
+
+    return true;
+}
+
+
+bool BatchRenderer::Worker::stealJob(int &JobIndex)
+{
+    const ScopedLock Lock(QueueLock);
+
+    if (Queue.empty())
+    {
+        return false;
+    }
+
+    JobIndex = Queue.back();
+    Queue.pop_back();
+
+    return true;
+}
+
+
+void BatchRenderer::Worker::pushJob(int JobIndex)
+{
+    const ScopedLock Lock(QueueLock);
+    Queue.push_back(JobIndex);
+}
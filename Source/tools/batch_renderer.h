@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_BATCH_RENDERER_H
+#define SQUEEZER_BATCH_RENDERER_H
+
+#include "offline_renderer.h"
+
+#include <deque>
+
+
+// renders many audio files in parallel.  Every worker thread owns an
+// offline renderer (and thus a compressor plus buffers that are
+// re-used from file to file) and a queue of jobs.  Jobs are dealt
+// out round-robin; workers that run out of jobs steal from the back
+// of other workers' queues, so long files do not leave cores idle.
+class BatchRenderer
+{
+public:
+    BatchRenderer(int number_of_threads, int maximum_block_size);
+    ~BatchRenderer();
+
+    bool loadPreset(const File &PresetFile);
+    void addJob(const File &InputFile, const File &OutputFile);
+
+    void start();
+    void stop();
+
+    bool isFinished();
+
+    int getNumberOfThreads();
+    int getNumberOfJobs();
+    int getNumberOfFinishedJobs();
+    int getNumberOfFailedJobs();
+
+    int64 getNumberOfSamples();
+    double getElapsedTime();
+    double getSamplesPerSecond();
+
+    StringArray getErrorMessages();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(BatchRenderer);
+
+    struct Job
+    {
+        File InputFile;
+        File OutputFile;
+
+        bool HasFailed;
+        String ErrorMessage;
+    };
+
+    class Worker :
+        public Thread
+    {
+    public:
+        Worker(BatchRenderer &owner, int index, int maximum_block_size);
+
+        void run() override;
+
+        bool popJob(int &JobIndex);
+        bool stealJob(int &JobIndex);
+        void pushJob(int JobIndex);
+
+        OfflineRenderer Renderer;
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(Worker);
+
+        BatchRenderer &Owner;
+        int Index;
+
+        CriticalSection QueueLock;
+        std::deque<int> Queue;
+    };
+
+    bool findJob(int WorkerIndex, int &JobIndex);
+    void finishJob(int JobIndex, int64 RenderedSamples);
+
+    OwnedArray<Worker> Workers;
+    Array<Job> Jobs;
+
+    Atomic<int> FinishedJobs;
+    Atomic<int> FailedJobs;
+    Atomic<int64> RenderedSamples;
+
+    int64 StartTicks;
+    Atomic<int64> StopTicks;
+};
+
+#endif  // SQUEEZER_BATCH_RENDERER_H
@@ -0,0 +1,732 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "dsp_benchmark.h"
+
+
+// sample rates supported by the plug-in
+const int DspBenchmark::SampleRates[] = {44100, 48000, 88200, 96000, 176400, 192000};
+const int DspBenchmark::NumberOfSampleRates = sizeof(SampleRates) / sizeof(SampleRates[0]);
+
+// block sizes are swept in powers of two
+const int DspBenchmark::MinimumBlockSize = 16;
+const int DspBenchmark::MaximumBlockSize = 4096;
+
+
+static const char *DesignNames[] = {"feed_forward", "feed_back"};
+static const char *EngineNames[] = {"blockwise", "per_sample"};
+static const char *CurveNames[] = {"log_lin", "log_smooth_decoupled", "log_smooth_branching"};
+static const char *GainStageNames[] = {"fet", "optical"};
+
+
+DspBenchmark::DspBenchmark(double minimum_trial_time, int number_of_trials) :
+    MinimumTrialTime(minimum_trial_time),
+    NumberOfTrials(number_of_trials)
+{
+    jassert(MinimumTrialTime > 0.0);
+    jassert(NumberOfTrials > 0);
+
+    Sink = 0.0;
+}
+
+
+void DspBenchmark::run(const String &Filter)
+/*  Run all benchmarks.
+
+    Filter (String): only run benchmarks whose name contains this
+    string (empty string runs all benchmarks)
+
+    return value: none
+ */
+{
+    CurrentFilter = Filter;
+
+    benchmarkCompressor<float>();
+    benchmarkCompressor<double>();
+
+    benchmarkSideChain<float>();
+    benchmarkSideChain<double>();
+
+    benchmarkGainStageOptical<float>();
+    benchmarkGainStageOptical<double>();
+
+    benchmarkMeterBallistics<float>();
+    benchmarkMeterBallistics<double>();
+
+    benchmarkBiquadFilter();
+    benchmarkDither();
+}
+
+
+int DspBenchmark::getNumberOfResults()
+{
+    return Results.size();
+}
+
+
+String DspBenchmark::toJson()
+/*  Format results as JSON.  Settings that do not apply to a
+    benchmark (such as the curve of the dither) are left out.
+
+    return value (String): JSON document
+ */
+{
+    String Json = "{\n";
+
+    Json += "  \"minimum_trial_time\": " + String(MinimumTrialTime) + ",\n";
+    Json += "  \"trials\": " + String(NumberOfTrials) + ",\n";
+    Json += "  \"results\": [";
+
+    for (int n = 0; n < Results.size(); ++n)
+    {
+        const Result &CurrentResult = Results.getReference(n);
+
+        Json += (n == 0) ? "\n" : ",\n";
+        Json += "    {\"name\": \"" + CurrentResult.Name + "\"";
+
+        if (CurrentResult.Precision.isNotEmpty())
+        {
+            Json += ", \"precision\": \"" + CurrentResult.Precision + "\"";
+        }
+
+        if (CurrentResult.SampleRate > 0)
+        {
+            Json += ", \"sample_rate\": " + String(CurrentResult.SampleRate);
+        }
+
+        if (CurrentResult.BlockSize > 0)
+        {
+            Json += ", \"block_size\": " + String(CurrentResult.BlockSize);
+        }
+
+        Json += ", \"channels\": " + String(CurrentResult.NumberOfChannels);
+
+        if (CurrentResult.Design.isNotEmpty())
+        {
+            Json += ", \"design\": \"" + CurrentResult.Design + "\"";
+        }
+
+        if (CurrentResult.Engine.isNotEmpty())
+        {
+            Json += ", \"engine\": \"" + CurrentResult.Engine + "\"";
+        }
+
+        if (CurrentResult.Curve.isNotEmpty())
+        {
+            Json += ", \"curve\": \"" + CurrentResult.Curve + "\"";
+        }
+
+        if (CurrentResult.GainStage.isNotEmpty())
+        {
+            Json += ", \"gain_stage\": \"" + CurrentResult.GainStage + "\"";
+        }
+
+        Json += ", \"ns_per_sample\": " +
+                String(CurrentResult.NanosecondsPerSample, 3) + "}";
+    }
+
+    Json += "\n  ]\n}\n";
+
+    return Json;
+}
+
+
+template <typename SampleType>
+void DspBenchmark::benchmarkCompressor()
+/*  Benchmark Compressor::process() for all sample rates, block
+    sizes, designs, engines, curves and gain stages.  Timings include
+    copying the input block (the compressor processes in-place).
+
+    return value: none
+ */
+{
+    String Name = "compressor_process";
+
+    if (!isSelected(Name))
+    {
+        return;
+    }
+
+    for (int RateIndex = 0; RateIndex < NumberOfSampleRates; ++RateIndex)
+    {
+        int SampleRate = SampleRates[RateIndex];
+
+        AudioBuffer<SampleType> Signal;
+        generateSignal(Signal, SampleRate);
+
+        for (int BlockSize = MinimumBlockSize; BlockSize <= MaximumBlockSize; BlockSize *= 2)
+        {
+            AudioBuffer<SampleType> MainBuffer(2, BlockSize);
+            AudioBuffer<SampleType> SideChainBuffer(2, BlockSize);
+            SideChainBuffer.clear();
+
+            Compressor<SampleType> Processor(2, SampleRate, BlockSize);
+
+            Processor.setThreshold(-30.0);
+            Processor.setRatio(4.0);
+            Processor.setAttackRate(10.0);
+            Processor.setReleaseRate(100);
+
+            // bypass side-chain low-pass filter (a cutoff of 0 Hz
+            // would silence the side chain)
+            Processor.setSidechainLPFCutoff(15000);
+
+            for (int Design = 0; Design < Compressor<SampleType>::NumberOfDesigns; ++Design)
+            {
+                for (int Engine = 0; Engine < Compressor<SampleType>::NumberOfProcessingModes; ++Engine)
+                {
+                    for (int Curve = 0; Curve < SideChain<SampleType>::NumberOfCurves; ++Curve)
+                    {
+                        for (int GainStage = 0; GainStage < GainStageBase::NumberOfGainStages; ++GainStage)
+                        {
+                            Processor.setDesign(Design);
+                            Processor.setProcessingMode(Engine);
+                            Processor.setCurve(Curve);
+                            Processor.setGainStage(GainStage);
+
+                            Processor.reset();
+
+                            int Position = 0;
+
+                            auto Kernel = [&]()
+                            {
+                                for (int Channel = 0; Channel < 2; ++Channel)
+                                {
+                                    MainBuffer.copyFrom(Channel, 0, Signal,
+                                                        Channel, Position, BlockSize);
+                                }
+
+                                Processor.process(MainBuffer, SideChainBuffer);
+
+                                Position += BlockSize;
+
+                                if (Position + BlockSize > Signal.getNumSamples())
+                                {
+                                    Position = 0;
+                                }
+                            };
+
+                            Result NewResult;
+
+                            NewResult.Name = Name;
+                            NewResult.Precision = getPrecisionName<SampleType>();
+                            NewResult.SampleRate = SampleRate;
+                            NewResult.BlockSize = BlockSize;
+                            NewResult.NumberOfChannels = 2;
+                            NewResult.Design = DesignNames[Design];
+                            NewResult.Engine = EngineNames[Engine];
+                            NewResult.Curve = CurveNames[Curve];
+                            NewResult.GainStage = GainStageNames[GainStage];
+                            NewResult.NanosecondsPerSample = measure(Kernel, BlockSize);
+
+                            addResult(NewResult);
+                        }
+                    }
+                }
+            }
+
+            Sink += (double) MainBuffer.getSample(0, 0);
+        }
+    }
+}
+
+
+template <typename SampleType>
+void DspBenchmark::benchmarkSideChain()
+/*  Benchmark SideChain::processSample() for all sample rates, curves
+    and gain stages.
+
+    return value: none
+ */
+{
+    String Name = "side_chain_process_sample";
+
+    if (!isSelected(Name))
+    {
+        return;
+    }
+
+    const int SamplesPerCall = 256;
+
+    for (int RateIndex = 0; RateIndex < NumberOfSampleRates; ++RateIndex)
+    {
+        int SampleRate = SampleRates[RateIndex];
+
+        AudioBuffer<SampleType> Signal;
+        generateSignal(Signal, SampleRate);
+
+        // the side chain expects levels in decibels
+        AudioBuffer<SampleType> Levels(1, Signal.getNumSamples());
+        FloatVectorOperations::abs(Levels.getWritePointer(0),
+                                   Signal.getReadPointer(0),
+                                   Signal.getNumSamples());
+        SideChain<SampleType>::level2decibel(Levels.getReadPointer(0),
+                                             Levels.getWritePointer(0),
+                                             Signal.getNumSamples());
+
+        const SampleType *InputLevels = Levels.getReadPointer(0);
+        int NumberOfLevels = Levels.getNumSamples() - SamplesPerCall;
+
+        for (int Curve = 0; Curve < SideChain<SampleType>::NumberOfCurves; ++Curve)
+        {
+            for (int GainStage = 0; GainStage < GainStageBase::NumberOfGainStages; ++GainStage)
+            {
+                SideChain<SampleType> Processor(SampleRate);
+
+                Processor.setThreshold(-30.0);
+                Processor.setRatio(4.0);
+                Processor.setCurve(Curve);
+                Processor.setGainStage(GainStage);
+                Processor.skipSmoothing();
+
+                int Position = 0;
+
+                auto Kernel = [&]()
+                {
+                    for (int Sample = 0; Sample < SamplesPerCall; ++Sample)
+                    {
+                        Processor.processSample(InputLevels[Position + Sample]);
+                    }
+
+                    Position += SamplesPerCall;
+
+                    if (Position > NumberOfLevels)
+                    {
+                        Position = 0;
+                    }
+                };
+
+                Result NewResult;
+
+                NewResult.Name = Name;
+                NewResult.Precision = getPrecisionName<SampleType>();
+                NewResult.SampleRate = SampleRate;
+                NewResult.BlockSize = 0;
+                NewResult.NumberOfChannels = 1;
+                NewResult.Curve = CurveNames[Curve];
+                NewResult.GainStage = GainStageNames[GainStage];
+                NewResult.NanosecondsPerSample = measure(Kernel, SamplesPerCall);
+
+                addResult(NewResult);
+
+                Sink += (double) Processor.getGainReduction(false);
+            }
+        }
+    }
+}
+
+
+template <typename SampleType>
+void DspBenchmark::benchmarkGainStageOptical()
+/*  Benchmark GainStageOptical::processGainReduction() for all sample
+    rates.
+
+    return value: none
+ */
+{
+    String Name = "gain_stage_optical_process_gain_reduction";
+
+    if (!isSelected(Name))
+    {
+        return;
+    }
+
+    const int SamplesPerCall = 256;
+
+    for (int RateIndex = 0; RateIndex < NumberOfSampleRates; ++RateIndex)
+    {
+        int SampleRate = SampleRates[RateIndex];
+
+        AudioBuffer<SampleType> Signal;
+        generateSignal(Signal, SampleRate);
+
+        // gain reduction of a hard-knee compressor (threshold -30 dB,
+        // ratio 4:1) without envelopes
+        AudioBuffer<SampleType> GainReductions(1, Signal.getNumSamples());
+        SampleType *IdealGainReductions = GainReductions.getWritePointer(0);
+
+        for (int Sample = 0; Sample < Signal.getNumSamples(); ++Sample)
+        {
+            SampleType Level = SideChain<SampleType>::level2decibel(
+                                   std::abs(Signal.getSample(0, Sample)));
+
+            IdealGainReductions[Sample] = jmax(
+                                              SampleType(0.0),
+                                              (Level + SampleType(30.0)) * SampleType(0.75));
+        }
+
+        int NumberOfGainReductions = GainReductions.getNumSamples() - SamplesPerCall;
+
+        GainStageOptical<SampleType> Processor(SampleRate);
+        SampleType GainReduction = SampleType(0.0);
+
+        int Position = 0;
+
+        auto Kernel = [&]()
+        {
+            for (int Sample = 0; Sample < SamplesPerCall; ++Sample)
+            {
+                SampleType IdealGainReduction = IdealGainReductions[Position + Sample];
+                GainReduction = Processor.processGainReduction(
+                                    IdealGainReduction, IdealGainReduction);
+            }
+
+            Position += SamplesPerCall;
+
+            if (Position > NumberOfGainReductions)
+            {
+                Position = 0;
+            }
+        };
+
+        Result NewResult;
+
+        NewResult.Name = Name;
+        NewResult.Precision = getPrecisionName<SampleType>();
+        NewResult.SampleRate = SampleRate;
+        NewResult.BlockSize = 0;
+        NewResult.NumberOfChannels = 1;
+        NewResult.NanosecondsPerSample = measure(Kernel, SamplesPerCall);
+
+        addResult(NewResult);
+
+        Sink += (double) GainReduction;
+    }
+}
+
+
+template <typename SampleType>
+void DspBenchmark::benchmarkMeterBallistics()
+/*  Benchmark Compressor::updateMeterLevels() for all sample rates
+    (accumulation of peak and average levels plus meter ballistics).
+    Every call processes a full meter buffer (50 ms), so nanoseconds
+    per sample are directly comparable to the other benchmarks.
+
+    return value: none
+ */
+{
+    String Name = "compressor_update_meter_ballistics";
+
+    if (!isSelected(Name))
+    {
+        return;
+    }
+
+    const int BlockSize = 512;
+
+    for (int RateIndex = 0; RateIndex < NumberOfSampleRates; ++RateIndex)
+    {
+        int SampleRate = SampleRates[RateIndex];
+
+        AudioBuffer<SampleType> Signal;
+        generateSignal(Signal, SampleRate);
+
+        Compressor<SampleType> Processor(2, SampleRate, BlockSize);
+
+        AudioBuffer<SampleType> MainBuffer(2, BlockSize);
+        AudioBuffer<SampleType> SideChainBuffer(2, BlockSize);
+        SideChainBuffer.clear();
+
+        // settle meter ballistics with real signal
+        for (int Position = 0;
+                Position + BlockSize <= Signal.getNumSamples();
+                Position += BlockSize)
+        {
+            for (int Channel = 0; Channel < 2; ++Channel)
+            {
+                MainBuffer.copyFrom(Channel, 0, Signal,
+                                    Channel, Position, BlockSize);
+            }
+
+            Processor.process(MainBuffer, SideChainBuffer);
+        }
+
+        Processor.MeterBufferPosition = 0;
+        int MeterBufferSize = Processor.MeterBufferSize;
+
+        auto Kernel = [&]()
+        {
+            // fills up the meter buffer, thus updates meters
+            Processor.updateMeterLevels(Signal, Signal, MeterBufferSize);
+        };
+
+        Result NewResult;
+
+        NewResult.Name = Name;
+        NewResult.Precision = getPrecisionName<SampleType>();
+        NewResult.SampleRate = SampleRate;
+        NewResult.BlockSize = 0;
+        NewResult.NumberOfChannels = 2;
+        NewResult.NanosecondsPerSample = measure(Kernel, MeterBufferSize);
+
+        addResult(NewResult);
+
+        Sink += Processor.getPeakMeterOutputLevel(0);
+    }
+}
+
+
+void DspBenchmark::benchmarkBiquadFilter()
+/*  Benchmark frut::dsp::BiquadFilter::processInPlace() (stereo
+    second-order high-pass as used by the side-chain filters) for all
+    sample rates and block sizes.  Timings include copying the input
+    block.
+
+    return value: none
+ */
+{
+    String Name = "biquad_filter_process_in_place";
+
+    if (!isSelected(Name))
+    {
+        return;
+    }
+
+    for (int RateIndex = 0; RateIndex < NumberOfSampleRates; ++RateIndex)
+    {
+        int SampleRate = SampleRates[RateIndex];
+
+        AudioBuffer<double> Signal;
+        generateSignal(Signal, SampleRate);
+
+        for (int BlockSize = MinimumBlockSize; BlockSize <= MaximumBlockSize; BlockSize *= 2)
+        {
+            AudioBuffer<double> Buffer(2, BlockSize);
+
+            frut::dsp::IirFilterBox Filter(2, SampleRate);
+            Filter.passFilterSecondOrder(100.0, 0.7071, false);
+
+            int Position = 0;
+
+            auto Kernel = [&]()
+            {
+                for (int Channel = 0; Channel < 2; ++Channel)
+                {
+                    Buffer.copyFrom(Channel, 0, Signal,
+                                    Channel, Position, BlockSize);
+                }
+
+                Filter.processInPlace(Buffer);
+
+                Position += BlockSize;
+
+                if (Position + BlockSize > Signal.getNumSamples())
+                {
+                    Position = 0;
+                }
+            };
+
+            Result NewResult;
+
+            NewResult.Name = Name;
+            NewResult.Precision = "double";
+            NewResult.SampleRate = SampleRate;
+            NewResult.BlockSize = BlockSize;
+            NewResult.NumberOfChannels = 2;
+            NewResult.NanosecondsPerSample = measure(Kernel, BlockSize);
+
+            addResult(NewResult);
+
+            Sink += Buffer.getSample(0, 0);
+        }
+    }
+}
+
+
+void DspBenchmark::benchmarkDither()
+/*  Benchmark frut::dsp::Dither::ditherToFloat() (stereo, 24 bits)
+    for all block sizes.  Dithering does not depend on the sample
+    rate.
+
+    return value: none
+ */
+{
+    String Name = "dither_to_float";
+
+    if (!isSelected(Name))
+    {
+        return;
+    }
+
+    AudioBuffer<double> Signal;
+    generateSignal(Signal, SampleRates[0]);
+
+    for (int BlockSize = MinimumBlockSize; BlockSize <= MaximumBlockSize; BlockSize *= 2)
+    {
+        AudioBuffer<float> Buffer(2, BlockSize);
+
+        frut::dsp::Dither Dither;
+        Dither.initialise(2, 24);
+
+        int Position = 0;
+
+        auto Kernel = [&]()
+        {
+            // refer to block of signal (does not allocate memory)
+            const AudioBuffer<double> Block(
+                Signal.getArrayOfWritePointers(),
+                2, Position, BlockSize);
+
+            Dither.ditherToFloat(Block, Buffer);
+
+            Position += BlockSize;
+
+            if (Position + BlockSize > Signal.getNumSamples())
+            {
+                Position = 0;
+            }
+        };
+
+        Result NewResult;
+
+        NewResult.Name = Name;
+        NewResult.Precision = "double";
+        NewResult.SampleRate = 0;
+        NewResult.BlockSize = BlockSize;
+        NewResult.NumberOfChannels = 2;
+        NewResult.NanosecondsPerSample = measure(Kernel, BlockSize);
+
+        addResult(NewResult);
+
+        Sink += (double) Buffer.getSample(0, 0);
+    }
+}
+
+
+template <typename Kernel>
+double DspBenchmark::measure(Kernel &&Function,
+                             int SamplesPerCall)
+/*  Time a benchmark kernel.
+
+    Function (callable): kernel to be timed
+
+    SamplesPerCall (integer): number of samples (per channel)
+    processed by a single call of the kernel
+
+    return value (double): nanoseconds per sample of fastest trial
+ */
+{
+    // reading the timer costs time, so small kernels are called
+    // several times in between
+    int CallsPerCheck = jmax(1, 4096 / SamplesPerCall);
+
+    // warm up caches and branch predictors
+    for (int Call = 0; Call < CallsPerCheck; ++Call)
+    {
+        Function();
+    }
+
+    double FastestTrial = 0.0;
+
+    for (int Trial = 0; Trial < NumberOfTrials; ++Trial)
+    {
+        int64 NumberOfCalls = 0;
+        int64 StartTicks = Time::getHighResolutionTicks();
+        double ElapsedTime;
+
+        do
+        {
+            for (int Call = 0; Call < CallsPerCheck; ++Call)
+            {
+                Function();
+            }
+
+            NumberOfCalls += CallsPerCheck;
+            ElapsedTime = Time::highResolutionTicksToSeconds(
+                              Time::getHighResolutionTicks() - StartTicks);
+        }
+        while (ElapsedTime < MinimumTrialTime);
+
+        double Nanoseconds = 1.0e9 * ElapsedTime /
+                             ((double) NumberOfCalls * SamplesPerCall);
+
+        if ((Trial == 0) || (Nanoseconds < FastestTrial))
+        {
+            FastestTrial = Nanoseconds;
+        }
+    }
+
+    return FastestTrial;
+}
+
+
+template <typename SampleType>
+void DspBenchmark::generateSignal(AudioBuffer<SampleType> &Signal,
+                                  int SampleRate)
+/*  Create one second of stereo test signal: a 1 kHz sine wave that
+    changes between loud (-6 dBFS) and quiet (-26 dBFS) every 100 ms
+    plus a little noise, so that the compressor keeps attacking and
+    releasing.  The signal does not change between runs.
+
+    Signal (AudioBuffer): receives test signal
+
+    SampleRate (integer): sample rate
+
+    return value: none
+ */
+{
+    Random Generator(42);
+    Signal.setSize(2, SampleRate);
+
+    int SamplesPerSection = SampleRate / 10;
+
+    for (int Channel = 0; Channel < 2; ++Channel)
+    {
+        SampleType *Samples = Signal.getWritePointer(Channel);
+
+        for (int Sample = 0; Sample < SampleRate; ++Sample)
+        {
+            bool IsLoud = ((Sample / SamplesPerSection) % 2) == 0;
+            double Amplitude = IsLoud ? 0.5 : 0.05;
+            double Phase = MathConstants<double>::twoPi * 1000.0 * Sample / SampleRate;
+            double Noise = 0.01 * (2.0 * Generator.nextDouble() - 1.0);
+
+            Samples[Sample] = SampleType(Amplitude * std::sin(Phase) + Noise);
+        }
+    }
+}
+
+
+template <typename SampleType>
+String DspBenchmark::getPrecisionName()
+{
+    return (sizeof(SampleType) == sizeof(float)) ? "float" : "double";
+}
+
+
+bool DspBenchmark::isSelected(const String &Name)
+{
+    return CurrentFilter.isEmpty() || Name.contains(CurrentFilter);
+}
+
+
+void DspBenchmark::addResult(const Result &NewResult)
+{
+    // report progress (results go to standard output)
+    Logger::outputDebugString(NewResult.Name + " " + NewResult.Precision + " " +
+                              String(NewResult.NanosecondsPerSample, 3) + " ns/sample");
+
+    Results.add(NewResult);
+}
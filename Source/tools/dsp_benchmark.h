@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_DSP_BENCHMARK_H
+#define SQUEEZER_DSP_BENCHMARK_H
+
+#include "FrutHeader.h"
+#include "../compressor.h"
+
+
+// measures the hot paths of the compressor in nanoseconds per sample
+// (processing all channels of a sample counts as one sample); every
+// measurement is repeated and the fastest trial is kept, as slower
+// trials only tell how busy the machine was
+class DspBenchmark
+{
+public:
+    DspBenchmark(double minimum_trial_time, int number_of_trials);
+
+    void run(const String &Filter);
+
+    int getNumberOfResults();
+    String toJson();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(DspBenchmark);
+
+    struct Result
+    {
+        String Name;
+        String Precision;
+
+        int SampleRate;
+        int BlockSize;
+        int NumberOfChannels;
+
+        String Design;
+        String Engine;
+        String Curve;
+        String GainStage;
+
+        double NanosecondsPerSample;
+    };
+
+    template <typename SampleType>
+    void benchmarkCompressor();
+
+    template <typename SampleType>
+    void benchmarkSideChain();
+
+    template <typename SampleType>
+    void benchmarkGainStageOptical();
+
+    template <typename SampleType>
+    void benchmarkMeterBallistics();
+
+    void benchmarkBiquadFilter();
+    void benchmarkDither();
+
+    template <typename Kernel>
+    double measure(Kernel &&Function, int SamplesPerCall);
+
+    template <typename SampleType>
+    static void generateSignal(AudioBuffer<SampleType> &Signal,
+                               int SampleRate);
+
+    template <typename SampleType>
+    static String getPrecisionName();
+
+    bool isSelected(const String &Name);
+    void addResult(const Result &NewResult);
+
+    static const int SampleRates[];
+    static const int NumberOfSampleRates;
+
+    static const int MinimumBlockSize;
+    static const int MaximumBlockSize;
+
+    double MinimumTrialTime;
+    int NumberOfTrials;
+
+    String CurrentFilter;
+    Array<Result> Results;
+
+    // keeps the optimiser from removing benchmarked code
+    double Sink;
+};
+
+#endif  // SQUEEZER_DSP_BENCHMARK_H
@@ -0,0 +1,871 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "golden_validator.h"
+
+#include <iostream>
+
+
+// block sizes cycle through this list, so that block boundaries fall
+// on different samples (like in hosts with varying buffer sizes)
+static const int BlockSizes[] = {512, 1, 64, 1024, 37, 300, 999, 128};
+static const int NumberOfBlockSizes = sizeof(BlockSizes) / sizeof(BlockSizes[0]);
+
+static const char *DesignNames[] = {"feed_forward", "feed_back"};
+static const char *CurveNames[] = {"log_lin", "log_smooth_decoupled", "log_smooth_branching"};
+static const char *GainStageNames[] = {"fet", "optical"};
+
+
+GoldenValidator::GoldenValidator(double signal_length,
+                                 int maximum_block_size) :
+    SignalLength(signal_length),
+    MaximumBlockSize(maximum_block_size)
+{
+    jassert(SignalLength > 0.0);
+    jassert(MaximumBlockSize > 0);
+
+    FormatManager.registerBasicFormats();
+
+    IsVerbose = false;
+
+    NumberOfChecks = 0;
+    NumberOfFailures = 0;
+
+    for (int Design = 0; Design < CompressorBase::NumberOfDesigns; ++Design)
+    {
+        SinglePrecisionDifferences[Design] = -400.0;
+    }
+
+    addGeneratedSignals();
+    addVariants();
+
+    // the reference engine (per-sample, double precision) is not
+    // listed, as all other engines are compared against it
+    Engine NewEngine;
+
+    NewEngine.Name = "blockwise_double";
+    NewEngine.IsDoublePrecision = true;
+    NewEngine.ProcessingMode = Compressor<double>::ProcessBlockwise;
+    Engines.add(NewEngine);
+
+    NewEngine.Name = "per_sample_float";
+    NewEngine.IsDoublePrecision = false;
+    NewEngine.ProcessingMode = Compressor<float>::ProcessPerSample;
+    Engines.add(NewEngine);
+
+    NewEngine.Name = "blockwise_float";
+    NewEngine.IsDoublePrecision = false;
+    NewEngine.ProcessingMode = Compressor<float>::ProcessBlockwise;
+    Engines.add(NewEngine);
+}
+
+
+bool GoldenValidator::addRecordings(const File &MaterialDirectory)
+/*  Add recordings (such as the material of the trim test) to the
+    test signals.  Recordings are cut to the length of the generated
+    signals; mono recordings are played on both channels.
+
+    MaterialDirectory (File): directory containing audio files
+
+    return value (boolean): returns false if no recording could be
+    read
+ */
+{
+    Array<File> MaterialFiles = MaterialDirectory.findChildFiles(
+                                    File::findFiles, false, FormatManager.getWildcardForAllFormats());
+
+    // keep order of signals independent of file system
+    MaterialFiles.sort();
+
+    int NumberOfRecordings = 0;
+
+    for (auto &MaterialFile : MaterialFiles)
+    {
+        std::unique_ptr<AudioFormatReader> Reader(
+            FormatManager.createReaderFor(MaterialFile));
+
+        if (!Reader || (Reader->numChannels < 1) || (Reader->numChannels > 2))
+        {
+            continue;
+        }
+
+        int SampleRate = (int) Reader->sampleRate;
+        int NumberOfSamples = (int) jmin((int64)(SignalLength * SampleRate),
+                                         Reader->lengthInSamples);
+
+        // AudioFormatReader only reads float and int buffers
+        AudioBuffer<float> Recording(2, NumberOfSamples);
+        Reader->read(&Recording, 0, NumberOfSamples, 0, true, true);
+
+        auto NewSignal = new TestSignal();
+
+        NewSignal->Name = MaterialFile.getFileNameWithoutExtension()
+                          .toLowerCase()
+                          .retainCharacters("abcdefghijklmnopqrstuvwxyz0123456789 ")
+                          .trim()
+                          .replaceCharacter(' ', '_');
+        NewSignal->SampleRate = SampleRate;
+        NewSignal->Samples.setSize(2, NumberOfSamples);
+
+        for (int Channel = 0; Channel < 2; ++Channel)
+        {
+            const float *Source = Recording.getReadPointer(Channel);
+            double *Destination = NewSignal->Samples.getWritePointer(Channel);
+
+            for (int Sample = 0; Sample < NumberOfSamples; ++Sample)
+            {
+                Destination[Sample] = (double) Source[Sample];
+            }
+        }
+
+        Signals.add(NewSignal);
+        ++NumberOfRecordings;
+    }
+
+    if (NumberOfRecordings == 0)
+    {
+        ErrorMessage = "no recordings found in \"" +
+                       MaterialDirectory.getFullPathName() + "\"";
+        return false;
+    }
+
+    return true;
+}
+
+
+void GoldenValidator::setFilter(const String &Filter)
+/*  Only validate test cases whose name contains a given string.
+
+    Filter (String): string to look for (empty string validates all
+    test cases)
+
+    return value: none
+ */
+{
+    CurrentFilter = Filter;
+}
+
+
+void GoldenValidator::setVerbose(bool Verbose)
+/*  Report passed checks, too.
+
+    Verbose (boolean): if true, all checks are reported
+
+    return value: none
+ */
+{
+    IsVerbose = Verbose;
+}
+
+
+bool GoldenValidator::run(const File &ReferenceDirectory,
+                          bool RecordReferences)
+/*  Render all test cases and compare engines against the reference
+    engine.  Failed checks are reported on standard output.
+
+    ReferenceDirectory (File): directory for stored reference renders
+    (pass File() to only compare engines against each other)
+
+    RecordReferences (boolean): if true, reference renders are written
+    to ReferenceDirectory; otherwise, they are read from it and
+    compared
+
+    return value (boolean): returns false on errors (failed checks
+    are no errors)
+ */
+{
+    NumberOfChecks = 0;
+    NumberOfFailures = 0;
+
+    for (int Design = 0; Design < CompressorBase::NumberOfDesigns; ++Design)
+    {
+        SinglePrecisionDifferences[Design] = -400.0;
+    }
+
+    bool UseStoredReferences = ReferenceDirectory.getFullPathName().isNotEmpty();
+
+    if (UseStoredReferences && RecordReferences &&
+            !ReferenceDirectory.createDirectory())
+    {
+        ErrorMessage = "could not create \"" + ReferenceDirectory.getFullPathName() + "\"";
+        return false;
+    }
+
+    for (auto Signal : Signals)
+    {
+        for (int Design = 0; Design < CompressorBase::NumberOfDesigns; ++Design)
+        {
+            for (int Curve = 0; Curve < SideChainBase::NumberOfCurves; ++Curve)
+            {
+                for (int GainStage = 0; GainStage < GainStageBase::NumberOfGainStages; ++GainStage)
+                {
+                    for (auto &Settings : Variants)
+                    {
+                        String CaseName = Signal->Name + " " +
+                                          DesignNames[Design] + " " +
+                                          CurveNames[Curve] + " " +
+                                          GainStageNames[GainStage] + " " +
+                                          Settings.Name;
+
+                        if (CurrentFilter.isNotEmpty() && !CaseName.contains(CurrentFilter))
+                        {
+                            continue;
+                        }
+
+                        AudioBuffer<double> Reference;
+                        render<double>(*Signal, Design, Curve, GainStage, Settings,
+                                       Compressor<double>::ProcessPerSample, Reference);
+
+                        if (UseStoredReferences)
+                        {
+                            File ReferenceFile = ReferenceDirectory.getChildFile(
+                                                     CaseName.replaceCharacter(' ', '-') + ".wav");
+
+                            if (RecordReferences)
+                            {
+                                if (!writeReference(ReferenceFile, Reference, Signal->SampleRate))
+                                {
+                                    return false;
+                                }
+                            }
+                            else
+                            {
+                                AudioBuffer<double> StoredReference;
+
+                                if (!readReference(ReferenceFile, StoredReference))
+                                {
+                                    return false;
+                                }
+
+                                // references are stored in single
+                                // precision (24-bit mantissa)
+                                check(CaseName, "stored_reference", Reference, StoredReference,
+                                      -120.0);
+                            }
+                        }
+
+                        for (auto &CurrentEngine : Engines)
+                        {
+                            AudioBuffer<double> Output;
+
+                            if (CurrentEngine.IsDoublePrecision)
+                            {
+                                render<double>(*Signal, Design, Curve, GainStage, Settings,
+                                               CurrentEngine.ProcessingMode, Output);
+                            }
+                            else
+                            {
+                                render<float>(*Signal, Design, Curve, GainStage, Settings,
+                                              CurrentEngine.ProcessingMode, Output);
+                            }
+
+                            double Difference = check(
+                                                    CaseName, CurrentEngine.Name, Output, Reference,
+                                                    getTolerance(CurrentEngine.IsDoublePrecision, Design, Settings));
+
+                            if (!CurrentEngine.IsDoublePrecision)
+                            {
+                                SinglePrecisionDifferences[Design] = jmax(
+                                        SinglePrecisionDifferences[Design], Difference);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (NumberOfChecks == 0)
+    {
+        ErrorMessage = "no test case matches \"" + CurrentFilter + "\"";
+        return false;
+    }
+
+    return true;
+}
+
+
+int GoldenValidator::getNumberOfChecks()
+{
+    return NumberOfChecks;
+}
+
+
+int GoldenValidator::getNumberOfFailures()
+{
+    return NumberOfFailures;
+}
+
+
+double GoldenValidator::getSinglePrecisionDifference(int Design)
+/*  Get worst peak difference of single-precision engines from the
+    reference engine in the last run.
+
+    Design (integer): compressor design
+
+    return value (double): peak difference in dBFS (-400 dB if no
+    single-precision engine has been checked)
+ */
+{
+    jassert(Design >= 0);
+    jassert(Design < CompressorBase::NumberOfDesigns);
+
+    return SinglePrecisionDifferences[Design];
+}
+
+
+String GoldenValidator::getErrorMessage()
+{
+    return ErrorMessage;
+}
+
+
+void GoldenValidator::addGeneratedSignals()
+/*  Create test signals (48 kHz, stereo).  Signals are generated
+    from fixed seeds and thus never change.
+
+    return value: none
+ */
+{
+    const int SampleRate = 48000;
+    const int NumberOfSamples = (int)(SignalLength * SampleRate);
+    const double TwoPi = MathConstants<double>::twoPi;
+
+    // logarithmic sine sweep (20 Hz to 20 kHz); right channel is
+    // 6 dB quieter, so that stereo linking makes a difference
+    auto SineSweep = new TestSignal();
+
+    SineSweep->Name = "sine_sweep";
+    SineSweep->SampleRate = SampleRate;
+    SineSweep->Samples.setSize(2, NumberOfSamples);
+
+    double SweepRate = std::log(20000.0 / 20.0) / NumberOfSamples;
+    double Phase = 0.0;
+
+    for (int Sample = 0; Sample < NumberOfSamples; ++Sample)
+    {
+        double Frequency = 20.0 * std::exp(SweepRate * Sample);
+        Phase += TwoPi * Frequency / SampleRate;
+
+        SineSweep->Samples.setSample(0, Sample, 0.5 * std::sin(Phase));
+        SineSweep->Samples.setSample(1, Sample, 0.25 * std::sin(Phase));
+    }
+
+    Signals.add(SineSweep);
+
+    // tone bursts (-1 dBFS) of varying length separated by quiet
+    // passages (-40 dBFS); channels are out of step to keep stereo
+    // linking busy
+    auto Bursts = new TestSignal();
+
+    Bursts->Name = "bursts";
+    Bursts->SampleRate = SampleRate;
+    Bursts->Samples.setSize(2, NumberOfSamples);
+
+    for (int Channel = 0; Channel < 2; ++Channel)
+    {
+        double Frequency = (Channel == 0) ? 1000.0 : 400.0;
+        int Offset = Channel * SampleRate / 20;
+
+        for (int Sample = 0; Sample < NumberOfSamples; ++Sample)
+        {
+            // periods of 300 ms; burst lengths of 10, 50 and 150 ms
+            int Period = (Sample + Offset) / (3 * SampleRate / 10);
+            int Position = (Sample + Offset) % (3 * SampleRate / 10);
+            int BurstLength = ((Period % 3 == 0) ? 10 : ((Period % 3 == 1) ? 50 : 150)) * SampleRate / 1000;
+
+            double Amplitude = (Position < BurstLength) ? 0.89 : 0.01;
+            Bursts->Samples.setSample(Channel, Sample,
+                                      Amplitude * std::sin(TwoPi * Frequency * Sample / SampleRate));
+        }
+    }
+
+    Signals.add(Bursts);
+
+    // white noise with level steps (-6, -30, -12 and -42 dBFS) every
+    // 500 ms
+    auto Noise = new TestSignal();
+
+    Noise->Name = "noise";
+    Noise->SampleRate = SampleRate;
+    Noise->Samples.setSize(2, NumberOfSamples);
+
+    const double Levels[] = {0.5, 0.0316, 0.25, 0.0079};
+    Random Generator(4711);
+
+    for (int Sample = 0; Sample < NumberOfSamples; ++Sample)
+    {
+        double Level = Levels[(Sample / (SampleRate / 2)) % 4];
+
+        for (int Channel = 0; Channel < 2; ++Channel)
+        {
+            Noise->Samples.setSample(Channel, Sample,
+                                     Level * (2.0 * Generator.nextDouble() - 1.0));
+        }
+    }
+
+    Signals.add(Noise);
+}
+
+
+void GoldenValidator::addVariants()
+/*  Create parameter variants that are validated for every design,
+    curve and gain stage.  Together, they cover all remaining
+    switches and the extremes of continuous parameters.
+
+    return value: none
+ */
+{
+    // in single precision, rounding errors may flip the detector
+    // between attack and release, so differences are much larger
+    // than the resolution of single precision suggests; feed-back
+    // compression processes these errors again and again.
+    // Tolerances keep a margin of about 10 dB from worst results.
+    Variant Default;
+
+    Default.Name = "hard_knee";
+    Default.RmsWindowSize = 0.0;
+    Default.Threshold = -30.0;
+    Default.Ratio = 4.0;
+    Default.KneeWidth = 0.0;
+    Default.AttackRate = 10.0;
+    Default.ReleaseRate = 100;
+    Default.InputTrim = 0.0;
+    Default.AutoMakeupGain = false;
+    Default.MakeupGain = 0.0;
+    Default.StereoLink = 100;
+    Default.WetMix = 100;
+    Default.SidechainInput = false;
+    Default.SidechainHPFCutoff = 0;
+    Default.SidechainLPFCutoff = 15000;
+    Default.SidechainListen = false;
+    Default.LookAhead = 0.0;
+    Default.Oversampling = 1;
+    Default.ToleranceFeedForward = -75.0;
+    Default.ToleranceFeedBack = -80.0;
+
+    Variants.add(Default);
+
+    Variant SoftKnee = Default;
+    SoftKnee.Name = "soft_knee_auto_gain";
+    SoftKnee.RmsWindowSize = 30.0;
+    SoftKnee.Threshold = -24.0;
+    SoftKnee.Ratio = 2.0;
+    SoftKnee.KneeWidth = 48.0;
+    SoftKnee.AttackRate = 2.0;
+    SoftKnee.ReleaseRate = 50;
+    SoftKnee.AutoMakeupGain = true;
+    SoftKnee.ToleranceFeedForward = -85.0;
+    SoftKnee.ToleranceFeedBack = -85.0;
+    Variants.add(SoftKnee);
+
+    Variant Fast = Default;
+    Fast.Name = "fast_unlinked";
+    Fast.Threshold = -36.0;
+    Fast.Ratio = 10.0;
+    Fast.KneeWidth = 24.0;
+    Fast.AttackRate = 0.0;
+    Fast.ReleaseRate = 0;
+    Fast.StereoLink = 0;
+    Fast.ToleranceFeedForward = -140.0;
+    Fast.ToleranceFeedBack = -120.0;
+    Variants.add(Fast);
+
+    // upward expansion amplifies rounding errors, and in feed-back
+    // designs, it amplifies them without bound; here, single
+    // precision can only be checked for gross errors
+    Variant Expansion = Default;
+    Expansion.Name = "upward_expansion";
+    Expansion.Threshold = -40.0;
+    Expansion.Ratio = 0.5;
+    Expansion.ReleaseRate = 250;
+    Expansion.StereoLink = 50;
+    Expansion.ToleranceFeedForward = -45.0;
+    Expansion.ToleranceFeedBack = +6.0;
+    Variants.add(Expansion);
+
+    Variant Parallel = Default;
+    Parallel.Name = "filtered_parallel";
+    Parallel.InputTrim = -3.0;
+    Parallel.MakeupGain = 6.0;
+    Parallel.WetMix = 50;
+    Parallel.SidechainHPFCutoff = 100;
+    Parallel.SidechainLPFCutoff = 5000;
+    Parallel.ToleranceFeedForward = -75.0;
+    Parallel.ToleranceFeedBack = -55.0;
+    Variants.add(Parallel);
+
+    Variant External = Default;
+    External.Name = "external_side_chain";
+    External.SidechainInput = true;
+    Variants.add(External);
+
+    // listening to the side chain of a feed-back design outputs the
+    // feed-back loop itself (same as above)
+    Variant Listen = Default;
+    Listen.Name = "side_chain_listen";
+    Listen.SidechainHPFCutoff = 200;
+    Listen.SidechainListen = true;
+    Listen.ToleranceFeedForward = -135.0;
+    Listen.ToleranceFeedBack = +6.0;
+    Variants.add(Listen);
+
+    Variant LookAhead = Default;
+    LookAhead.Name = "look_ahead";
+    LookAhead.AttackRate = 2.0;
+    LookAhead.LookAhead = 5.0;
+    Variants.add(LookAhead);
+
+    Variant Oversampling = Default;
+    Oversampling.Name = "oversampling";
+    Oversampling.AttackRate = 2.0;
+    Oversampling.Oversampling = 4;
+    Variants.add(Oversampling);
+}
+
+
+template <typename SampleType>
+void GoldenValidator::render(const TestSignal &Signal,
+                             int Design,
+                             int Curve,
+                             int GainStage,
+                             const Variant &Settings,
+                             int ProcessingMode,
+                             AudioBuffer<double> &Output)
+/*  Render test signal.  The external side chain is fed with the
+    test signal's channels swapped.
+
+    Signal (TestSignal): test signal
+
+    Design (integer): compressor design
+
+    Curve (integer): curve type
+
+    GainStage (integer): gain stage type
+
+    Settings (Variant): remaining parameter values
+
+    ProcessingMode (integer): processing engine
+
+    Output (AudioBuffer): receives rendered signal
+
+    return value: none
+ */
+{
+    int NumberOfSamples = Signal.Samples.getNumSamples();
+    Compressor<SampleType> Processor(2, Signal.SampleRate, MaximumBlockSize);
+
+    Processor.setProcessingMode(ProcessingMode);
+    Processor.setRmsWindowSize(Settings.RmsWindowSize);
+    Processor.setDesign(Design);
+    Processor.setCurve(Curve);
+    Processor.setGainStage(GainStage);
+
+    Processor.setThreshold(Settings.Threshold);
+    Processor.setRatio(Settings.Ratio);
+    Processor.setKneeWidth(Settings.KneeWidth);
+
+    Processor.setAttackRate(Settings.AttackRate);
+    Processor.setReleaseRate(Settings.ReleaseRate);
+
+    Processor.setInputTrim(Settings.InputTrim);
+    Processor.setAutoMakeupGain(Settings.AutoMakeupGain);
+    Processor.setMakeupGain(Settings.MakeupGain);
+    Processor.setStereoLink(Settings.StereoLink);
+    Processor.setWetMix(Settings.WetMix);
+
+    Processor.setSidechainInput(Settings.SidechainInput);
+    Processor.setSidechainHPFCutoff(Settings.SidechainHPFCutoff);
+    Processor.setSidechainLPFCutoff(Settings.SidechainLPFCutoff);
+    Processor.setSidechainListen(Settings.SidechainListen);
+    Processor.setLookAhead(Settings.LookAhead);
+    Processor.setOversampling(Settings.Oversampling);
+
+    Processor.skipSmoothing();
+
+    AudioBuffer<SampleType> MainBuffer(2, MaximumBlockSize);
+    AudioBuffer<SampleType> SideChainBuffer(2, MaximumBlockSize);
+
+    Output.setSize(2, NumberOfSamples);
+
+    int BlockIndex = 0;
+
+    for (int Position = 0; Position < NumberOfSamples;)
+    {
+        int BlockSize = jmin(BlockSizes[BlockIndex % NumberOfBlockSizes],
+                             jmin(MaximumBlockSize, NumberOfSamples - Position));
+        ++BlockIndex;
+
+        // refer to work buffers (does not allocate memory)
+        AudioBuffer<SampleType> MainBlock(
+            MainBuffer.getArrayOfWritePointers(), 2, BlockSize);
+        AudioBuffer<SampleType> SideChainBlock(
+            SideChainBuffer.getArrayOfWritePointers(), 2, BlockSize);
+
+        for (int Channel = 0; Channel < 2; ++Channel)
+        {
+            const double *Input = Signal.Samples.getReadPointer(Channel, Position);
+            const double *InputOther = Signal.Samples.getReadPointer(1 - Channel, Position);
+
+            SampleType *Main = MainBlock.getWritePointer(Channel);
+            SampleType *SideChain = SideChainBlock.getWritePointer(Channel);
+
+            for (int Sample = 0; Sample < BlockSize; ++Sample)
+            {
+                Main[Sample] = (SampleType) Input[Sample];
+                SideChain[Sample] = (SampleType) InputOther[Sample];
+            }
+        }
+
+        {
+            // assert on memory allocation (debug builds only)
+            frut::audio::AllocationGuard Guard;
+            Processor.process(MainBlock, SideChainBlock);
+        }
+
+        for (int Channel = 0; Channel < 2; ++Channel)
+        {
+            const SampleType *Main = MainBlock.getReadPointer(Channel);
+            double *Rendered = Output.getWritePointer(Channel, Position);
+
+            for (int Sample = 0; Sample < BlockSize; ++Sample)
+            {
+                Rendered[Sample] = (double) Main[Sample];
+            }
+        }
+
+        Position += BlockSize;
+    }
+}
+
+
+bool GoldenValidator::readReference(const File &ReferenceFile,
+                                    AudioBuffer<double> &Reference)
+{
+    std::unique_ptr<AudioFormatReader> Reader(
+        FormatManager.createReaderFor(ReferenceFile));
+
+    if (!Reader)
+    {
+        ErrorMessage = "could not read \"" + ReferenceFile.getFullPathName() +
+                       "\" (record references first)";
+        return false;
+    }
+
+    int NumberOfSamples = (int) Reader->lengthInSamples;
+
+    AudioBuffer<float> StoredReference(2, NumberOfSamples);
+    Reader->read(&StoredReference, 0, NumberOfSamples, 0, true, true);
+
+    Reference.setSize(2, NumberOfSamples);
+
+    for (int Channel = 0; Channel < 2; ++Channel)
+    {
+        const float *Source = StoredReference.getReadPointer(Channel);
+        double *Destination = Reference.getWritePointer(Channel);
+
+        for (int Sample = 0; Sample < NumberOfSamples; ++Sample)
+        {
+            Destination[Sample] = (double) Source[Sample];
+        }
+    }
+
+    return true;
+}
+
+
+bool GoldenValidator::writeReference(const File &ReferenceFile,
+                                     const AudioBuffer<double> &Reference,
+                                     int SampleRate)
+{
+    // FileOutputStream appends to existing files
+    if (ReferenceFile.exists() && !ReferenceFile.deleteFile())
+    {
+        ErrorMessage = "could not overwrite \"" + ReferenceFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    std::unique_ptr<FileOutputStream> OutputStream(ReferenceFile.createOutputStream());
+
+    if (!OutputStream)
+    {
+        ErrorMessage = "could not create \"" + ReferenceFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    // store references in 32-bit floating point, so that level
+    // differences way below the tolerances can be detected
+    WavAudioFormat WavFormat;
+    std::unique_ptr<AudioFormatWriter> Writer(
+        WavFormat.createWriterFor(OutputStream.get(),
+                                  SampleRate,
+                                  2,
+                                  32,
+                                  StringPairArray(),
+                                  0));
+
+    if (!Writer)
+    {
+        ErrorMessage = "could not write \"" + ReferenceFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    // writer now owns the stream
+    OutputStream.release();
+
+    AudioBuffer<float> StoredReference(2, Reference.getNumSamples());
+
+    for (int Channel = 0; Channel < 2; ++Channel)
+    {
+        const double *Source = Reference.getReadPointer(Channel);
+        float *Destination = StoredReference.getWritePointer(Channel);
+
+        for (int Sample = 0; Sample < Reference.getNumSamples(); ++Sample)
+        {
+            Destination[Sample] = (float) Source[Sample];
+        }
+    }
+
+    if (!Writer->writeFromAudioSampleBuffer(StoredReference, 0, StoredReference.getNumSamples()))
+    {
+        ErrorMessage = "could not write \"" + ReferenceFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    return true;
+}
+
+
+double GoldenValidator::check(const String &CaseName,
+                              const String &EngineName,
+                              const AudioBuffer<double> &Output,
+                              const AudioBuffer<double> &Reference,
+                              double Tolerance)
+/*  Compare rendered signal with reference and report result.
+
+    CaseName (String): name of test case
+
+    EngineName (String): name of tested engine
+
+    Output (AudioBuffer): rendered signal
+
+    Reference (AudioBuffer): reference signal
+
+    Tolerance (double): maximum allowed peak difference in dBFS
+
+    return value (double): peak difference in dBFS (+400 dB if the
+    lengths differ)
+ */
+{
+    ++NumberOfChecks;
+
+    if (Output.getNumSamples() != Reference.getNumSamples())
+    {
+        ++NumberOfFailures;
+
+        std::cout << "FAIL  " << CaseName << "  " << EngineName
+                  << ": length differs (" << Output.getNumSamples()
+                  << " instead of " << Reference.getNumSamples() << " samples)\n";
+        return 400.0;
+    }
+
+    double Difference = getPeakDifference(Output, Reference);
+    bool HasPassed = (Difference <= Tolerance);
+
+    if (!HasPassed)
+    {
+        ++NumberOfFailures;
+    }
+
+    if (!HasPassed || IsVerbose)
+    {
+        std::cout << (HasPassed ? "ok    " : "FAIL  ") << CaseName << "  " << EngineName
+                  << ": " << String(Difference, 1) << " dB (tolerance "
+                  << String(Tolerance, 1) << " dB)\n";
+    }
+
+    return Difference;
+}
+
+
+double GoldenValidator::getPeakDifference(const AudioBuffer<double> &Output,
+                                          const AudioBuffer<double> &Reference)
+/*  Get peak level of the difference of two signals.
+
+    Output (AudioBuffer): first signal
+
+    Reference (AudioBuffer): second signal
+
+    return value (double): peak level of difference in dBFS (-400 dB
+    for identical signals)
+ */
+{
+    double PeakDifference = 0.0;
+
+    for (int Channel = 0; Channel < 2; ++Channel)
+    {
+        const double *OutputSamples = Output.getReadPointer(Channel);
+        const double *ReferenceSamples = Reference.getReadPointer(Channel);
+
+        for (int Sample = 0; Sample < Output.getNumSamples(); ++Sample)
+        {
+            PeakDifference = jmax(PeakDifference,
+                                  std::abs(OutputSamples[Sample] - ReferenceSamples[Sample]));
+        }
+    }
+
+    return jmax(-400.0, 20.0 * std::log10(PeakDifference));
+}
+
+
+double GoldenValidator::getTolerance(bool IsDoublePrecision,
+                                     int Design,
+                                     const Variant &Settings)
+/*  Get allowed peak difference from the reference engine.
+
+    IsDoublePrecision (boolean): precision of tested engine
+
+    Design (integer): compressor design
+
+    Settings (Variant): parameter values of test case
+
+    return value (double): tolerance in dBFS
+ */
+{
+    // "nulls" in double precision
+    if (IsDoublePrecision)
+    {
+        return -180.0;
+    }
+
+    if (Design == CompressorBase::DesignFeedForward)
+    {
+        return Settings.ToleranceFeedForward;
+    }
+    else
+    {
+        return Settings.ToleranceFeedBack;
+    }
+}
@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_GOLDEN_VALIDATOR_H
+#define SQUEEZER_GOLDEN_VALIDATOR_H
+
+#include "FrutHeader.h"
+#include "../compressor.h"
+
+
+// renders fixed test signals through every design, curve and gain
+// stage (each with a set of parameter variants) and proves that all
+// processing engines null against the reference engine (per-sample
+// processing in double precision) within tolerances given in dB.
+// Reference renders can also be stored and compared against later,
+// so that changes to the reference engine itself are caught.
+class GoldenValidator
+{
+public:
+    GoldenValidator(double signal_length, int maximum_block_size);
+
+    bool addRecordings(const File &MaterialDirectory);
+    void setFilter(const String &Filter);
+    void setVerbose(bool Verbose);
+
+    bool run(const File &ReferenceDirectory,
+             bool RecordReferences);
+
+    int getNumberOfChecks();
+    int getNumberOfFailures();
+    double getSinglePrecisionDifference(int Design);
+    String getErrorMessage();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(GoldenValidator);
+
+    struct TestSignal
+    {
+        String Name;
+        int SampleRate;
+        AudioBuffer<double> Samples;
+    };
+
+    struct Variant
+    {
+        String Name;
+
+        double RmsWindowSize;
+        double Threshold;
+        double Ratio;
+        double KneeWidth;
+        double AttackRate;
+        int ReleaseRate;
+
+        double InputTrim;
+        bool AutoMakeupGain;
+        double MakeupGain;
+        int StereoLink;
+        int WetMix;
+
+        bool SidechainInput;
+        int SidechainHPFCutoff;
+        int SidechainLPFCutoff;
+        bool SidechainListen;
+        double LookAhead;
+        int Oversampling;
+
+        // allowed peak difference of single-precision engines (dBFS)
+        double ToleranceFeedForward;
+        double ToleranceFeedBack;
+    };
+
+    struct Engine
+    {
+        String Name;
+        bool IsDoublePrecision;
+        int ProcessingMode;
+    };
+
+    void addGeneratedSignals();
+    void addVariants();
+
+    template <typename SampleType>
+    void render(const TestSignal &Signal,
+                int Design,
+                int Curve,
+                int GainStage,
+                const Variant &Settings,
+                int ProcessingMode,
+                AudioBuffer<double> &Output);
+
+    bool readReference(const File &ReferenceFile,
+                       AudioBuffer<double> &Reference);
+    bool writeReference(const File &ReferenceFile,
+                        const AudioBuffer<double> &Reference,
+                        int SampleRate);
+
+    double check(const String &CaseName,
+                 const String &EngineName,
+                 const AudioBuffer<double> &Output,
+                 const AudioBuffer<double> &Reference,
+                 double Tolerance);
+
+    static double getPeakDifference(const AudioBuffer<double> &Output,
+                                    const AudioBuffer<double> &Reference);
+    static double getTolerance(bool IsDoublePrecision,
+                               int Design,
+                               const Variant &Settings);
+
+    double SignalLength;
+    int MaximumBlockSize;
+
+    String CurrentFilter;
+    bool IsVerbose;
+
+    OwnedArray<TestSignal> Signals;
+    Array<Variant> Variants;
+    Array<Engine> Engines;
+
+    AudioFormatManager FormatManager;
+
+    int NumberOfChecks;
+    int NumberOfFailures;
+    String ErrorMessage;
+
+    // worst peak difference of single-precision engines from the
+    // reference engine (dBFS)
+    double SinglePrecisionDifferences[CompressorBase::NumberOfDesigns];
+};
+
+#endif  // SQUEEZER_GOLDEN_VALIDATOR_H
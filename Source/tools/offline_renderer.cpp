@@ -0,0 +1,318 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "offline_renderer.h"
+
+
+OfflineRenderer::OfflineRenderer(int maximum_block_size) :
+    MaximumBlockSize(maximum_block_size),
+    // up to four channels (main signal plus external side chain)
+    Buffer(4, maximum_block_size)
+{
+    jassert(MaximumBlockSize > 0);
+
+    FormatManager.registerBasicFormats();
+
+    NumberOfSamples = 0;
+    SampleRate = 0.0;
+
+    ProcessorChannels = 0;
+    ProcessorSampleRate = 0.0;
+
+    ProcessingTime = 0.0;
+    TotalTime = 0.0;
+}
+
+
+bool OfflineRenderer::loadPreset(const File &PresetFile)
+/*  Load parameter values from preset file.  Presets use the XML
+    format of the plug-in's settings; parameters missing from the
+    preset keep their default values.
+
+    PresetFile (File): preset file
+
+    return value (boolean): returns false on error
+ */
+{
+    std::unique_ptr<XmlElement> Preset(XmlDocument::parse(PresetFile));
+
+    if (!Preset)
+    {
+        ErrorMessage = "could not parse preset \"" +
+                       PresetFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    // Juggler silently ignores XML documents with a different ID
+    String ExpectedTagName = Parameters.storeAsXml().getTagName();
+
+    if (!Preset->hasTagName(ExpectedTagName))
+    {
+        ErrorMessage = "\"" + PresetFile.getFullPathName() +
+                       "\" is not a Squeezer preset (expected <" +
+                       ExpectedTagName + ">)";
+        return false;
+    }
+
+    Parameters.loadFromXml(Preset.get());
+    return true;
+}
+
+
+bool OfflineRenderer::render(const File &InputFile,
+                             const File &OutputFile)
+/*  Render audio file.  Mono and stereo files are compressed using
+    their own signal as side chain; four-channel files are treated
+    as stereo main signal (channels 1 and 2) plus stereo external
+    side chain (channels 3 and 4), just like the plug-in's buses.
+    The output file is a WAV file with the input's bit depth.
+
+    InputFile (File): audio file to be rendered
+
+    OutputFile (File): rendered WAV file (will be overwritten)
+
+    return value (boolean): returns false on error
+ */
+{
+    uint32 StartTime = Time::getMillisecondCounter();
+
+    std::unique_ptr<AudioFormatReader> Reader(
+        FormatManager.createReaderFor(InputFile));
+
+    if (!Reader)
+    {
+        ErrorMessage = "could not open \"" + InputFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    SampleRate = Reader->sampleRate;
+    NumberOfSamples = Reader->lengthInSamples;
+
+    // the plug-in supports the same range of sample rates
+    if ((SampleRate < 44100) || (SampleRate > 192000))
+    {
+        ErrorMessage = "sample rate of " + String(SampleRate) +
+                       " Hz not supported";
+        return false;
+    }
+
+    int NumberOfChannels = (int) Reader->numChannels;
+    int NumberOfMainChannels;
+    bool HasExternalSideChain;
+
+    if ((NumberOfChannels == 1) || (NumberOfChannels == 2))
+    {
+        NumberOfMainChannels = NumberOfChannels;
+        HasExternalSideChain = false;
+    }
+    else if (NumberOfChannels == 4)
+    {
+        NumberOfMainChannels = 2;
+        HasExternalSideChain = true;
+    }
+    else
+    {
+        ErrorMessage = String(NumberOfChannels) +
+                       " channels not supported (use 1, 2 or 4)";
+        return false;
+    }
+
+    // FileOutputStream appends to existing files
+    if (OutputFile.exists() && !OutputFile.deleteFile())
+    {
+        ErrorMessage = "could not overwrite \"" + OutputFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    std::unique_ptr<FileOutputStream> OutputStream(OutputFile.createOutputStream());
+
+    if (!OutputStream)
+    {
+        ErrorMessage = "could not create \"" + OutputFile.getFullPathName() + "\"";
+        return false;
+    }
+
+    WavAudioFormat WavFormat;
+    std::unique_ptr<AudioFormatWriter> Writer(
+        WavFormat.createWriterFor(OutputStream.get(),
+                                  SampleRate,
+                                  (unsigned int) NumberOfMainChannels,
+                                  (int) Reader->bitsPerSample,
+                                  StringPairArray(),
+                                  0));
+
+    if (!Writer)
+    {
+        ErrorMessage = "could not write " + String(Reader->bitsPerSample) +
+                       "-bit WAV file";
+        return false;
+    }
+
+    // writer now owns the stream
+    OutputStream.release();
+
+    prepareCompressor(NumberOfMainChannels);
+
+    int SideChainOffset = HasExternalSideChain ? NumberOfMainChannels : 0;
+
+    int64 ProcessingTicks = 0;
+
+    // compensate latency caused by look-ahead: process silence past
+    // the end of the input file and drop the first output samples
+    int64 LatencySamples = Processor->getLatencySamples();
+    int64 NumberOfSamplesDelayed = NumberOfSamples + LatencySamples;
+
+    for (int64 Position = 0; Position < NumberOfSamplesDelayed; Position += MaximumBlockSize)
+    {
+        int BlockSize = (int) jmin((int64) MaximumBlockSize,
+                                   NumberOfSamplesDelayed - Position);
+
+        // reading past the end of the file returns silence
+        Reader->read(&Buffer, 0, BlockSize, Position, true, true);
+
+        // refer to channels of buffer (does not allocate memory)
+        AudioBuffer<float> MainBuffer(
+            Buffer.getArrayOfWritePointers(),
+            NumberOfMainChannels, BlockSize);
+
+        AudioBuffer<float> SideChainBuffer(
+            Buffer.getArrayOfWritePointers() + SideChainOffset,
+            NumberOfMainChannels, BlockSize);
+
+        int64 StartTicks = Time::getHighResolutionTicks();
+        Processor->process(MainBuffer, SideChainBuffer);
+        ProcessingTicks += Time::getHighResolutionTicks() - StartTicks;
+
+        int SamplesToDrop = (int) jlimit((int64) 0, (int64) BlockSize,
+                                         LatencySamples - Position);
+
+        if (SamplesToDrop == BlockSize)
+        {
+            continue;
+        }
+
+        if (!Writer->writeFromAudioSampleBuffer(MainBuffer, SamplesToDrop,
+                                                BlockSize - SamplesToDrop))
+        {
+            ErrorMessage = "could not write to \"" + OutputFile.getFullPathName() + "\"";
+            return false;
+        }
+    }
+
+    // flush output file
+    Writer = nullptr;
+
+    ProcessingTime = Time::highResolutionTicksToSeconds(ProcessingTicks);
+    TotalTime = (Time::getMillisecondCounter() - StartTime) / 1000.0;
+
+    return true;
+}
+
+
+void OfflineRenderer::prepareCompressor(int NumberOfMainChannels)
+/*  Set up compressor for the current file.  The compressor of the
+    previous render is re-used if channel count and sample rate have
+    not changed; otherwise, a new one is created.
+
+    NumberOfMainChannels (integer): number of main channels
+
+    return value: none
+ */
+{
+    if (!Processor ||
+            (ProcessorChannels != NumberOfMainChannels) ||
+            (ProcessorSampleRate != SampleRate))
+    {
+        Processor = std::make_unique<Compressor<float>>(
+                        NumberOfMainChannels,
+                        (int) SampleRate,
+                        MaximumBlockSize);
+
+        ProcessorChannels = NumberOfMainChannels;
+        ProcessorSampleRate = SampleRate;
+    }
+    else
+    {
+        // do not let the previous file bleed into this one
+        Processor->reset();
+    }
+
+    Parameters.applyToCompressor(*Processor);
+}
+
+
+String OfflineRenderer::getErrorMessage()
+{
+    return ErrorMessage;
+}
+
+
+int64 OfflineRenderer::getNumberOfSamples()
+{
+    return NumberOfSamples;
+}
+
+
+double OfflineRenderer::getSampleRate()
+{
+    return SampleRate;
+}
+
+
+double OfflineRenderer::getProcessingTime()
+/*  Get time spent in the compressor during last render.
+
+    return value (double): processing time in seconds
+ */
+{
+    return ProcessingTime;
+}
+
+
+double OfflineRenderer::getTotalTime()
+/*  Get time spent on last render (including file access).
+
+    return value (double): total time in seconds
+ */
+{
+    return TotalTime;
+}
+
+
+double OfflineRenderer::getRealtimeFactor()
+/*  Get realtime factor of last render.
+
+    return value (double): length of rendered audio divided by
+    processing time (i.e. 100.0 means that one second of audio took
+    10 ms to process)
+ */
+{
+    if (ProcessingTime <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return (NumberOfSamples / SampleRate) / ProcessingTime;
+}
@@ -0,0 +1,81 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_OFFLINE_RENDERER_H
+#define SQUEEZER_OFFLINE_RENDERER_H
+
+#include "FrutHeader.h"
+#include "../compressor.h"
+#include "../plugin_parameters.h"
+
+
+// renders audio files through the compressor without a host; input
+// is read and output is written block by block, so files of any
+// length can be processed.  Compressor and buffers are kept between
+// renders, so rendering many files does not allocate over and over.
+class OfflineRenderer
+{
+public:
+    explicit OfflineRenderer(int maximum_block_size);
+
+    bool loadPreset(const File &PresetFile);
+    bool render(const File &InputFile,
+                const File &OutputFile);
+
+    String getErrorMessage();
+
+    int64 getNumberOfSamples();
+    double getSampleRate();
+
+    double getProcessingTime();
+    double getTotalTime();
+    double getRealtimeFactor();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(OfflineRenderer);
+
+    void prepareCompressor(int NumberOfMainChannels);
+
+    int MaximumBlockSize;
+
+    SqueezerPluginParameters Parameters;
+    AudioFormatManager FormatManager;
+
+    std::unique_ptr<Compressor<float>> Processor;
+    int ProcessorChannels;
+    double ProcessorSampleRate;
+
+    AudioBuffer<float> Buffer;
+
+    String ErrorMessage;
+
+    int64 NumberOfSamples;
+    double SampleRate;
+
+    double ProcessingTime;
+    double TotalTime;
+};
+
+#endif  // SQUEEZER_OFFLINE_RENDERER_H
@@ -0,0 +1,207 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+// Batch renderer: compresses many audio files in parallel using a
+// preset and reports progress and aggregate throughput.
+//
+//   squeezer_batch [--threads N] [--block-size N] [--list FILE]
+//                  PRESET OUTPUT_DIRECTORY [INPUT...]
+
+#include "batch_renderer.h"
+
+#include <iostream>
+
+
+static void printUsage()
+{
+    std::cerr << "usage: squeezer_batch [--threads N] [--block-size N] [--list FILE]\n"
+              << "                      PRESET OUTPUT_DIRECTORY [INPUT...]\n"
+              << "\n"
+              << "  PRESET            Squeezer settings (XML)\n"
+              << "  OUTPUT_DIRECTORY  rendered files are written here as WAV files\n"
+              << "                    with the input's name (will be overwritten)\n"
+              << "  INPUT             audio files (1, 2 or 4 channels; channels 3\n"
+              << "                    and 4 feed the external side chain)\n"
+              << "\n"
+              << "  --threads N     number of worker threads (default: number of CPUs)\n"
+              << "  --block-size N  process N samples at a time (default: 512)\n"
+              << "  --list FILE     read input files from FILE (one per line)\n";
+}
+
+
+static void printProgress(BatchRenderer &Renderer)
+{
+    std::cout << "\r[" << Renderer.getNumberOfFinishedJobs()
+              << "/" << Renderer.getNumberOfJobs() << "] "
+              << Renderer.getNumberOfFailedJobs() << " failed, "
+              << String(Renderer.getSamplesPerSecond() / 1.0e6, 2)
+              << " MSamples/s" << std::flush;
+}
+
+
+int main(int argc, char *argv[])
+{
+    File CurrentDirectory = File::getCurrentWorkingDirectory();
+
+    StringArray Arguments;
+    StringArray InputFileNames;
+
+    int NumberOfThreads = SystemStats::getNumCpus();
+    int BlockSize = 512;
+
+    for (int n = 1; n < argc; ++n)
+    {
+        String Argument(argv[n]);
+
+        if ((Argument == "--threads") ||
+                (Argument == "--block-size") ||
+                (Argument == "--list"))
+        {
+            if (++n >= argc)
+            {
+                printUsage();
+                return 1;
+            }
+
+            String Value(argv[n]);
+
+            if (Argument == "--list")
+            {
+                File ListFile = CurrentDirectory.getChildFile(Value);
+
+                if (!ListFile.existsAsFile())
+                {
+                    std::cerr << "could not open \"" << ListFile.getFullPathName() << "\"\n";
+                    return 1;
+                }
+
+                StringArray Lines;
+                ListFile.readLines(Lines);
+                Lines.trim();
+                Lines.removeEmptyStrings();
+
+                InputFileNames.addArray(Lines);
+            }
+            else if (Value.getIntValue() <= 0)
+            {
+                std::cerr << Argument << " must be positive\n";
+                return 1;
+            }
+            else if (Argument == "--threads")
+            {
+                NumberOfThreads = Value.getIntValue();
+            }
+            else
+            {
+                BlockSize = Value.getIntValue();
+            }
+        }
+        else if ((Argument == "--help") || (Argument == "-h"))
+        {
+            printUsage();
+            return 0;
+        }
+        else
+        {
+            Arguments.add(Argument);
+        }
+    }
+
+    if (Arguments.size() < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    File PresetFile = CurrentDirectory.getChildFile(Arguments[0]);
+    File OutputDirectory = CurrentDirectory.getChildFile(Arguments[1]);
+
+    for (int n = 2; n < Arguments.size(); ++n)
+    {
+        InputFileNames.add(Arguments[n]);
+    }
+
+    if (InputFileNames.isEmpty())
+    {
+        std::cerr << "no input files given\n";
+        return 1;
+    }
+
+    if (!OutputDirectory.createDirectory())
+    {
+        std::cerr << "could not create \"" << OutputDirectory.getFullPathName() << "\"\n";
+        return 1;
+    }
+
+    BatchRenderer Renderer(NumberOfThreads, BlockSize);
+
+    if (!Renderer.loadPreset(PresetFile))
+    {
+        std::cerr << "could not load preset \"" << PresetFile.getFullPathName() << "\"\n";
+        return 1;
+    }
+
+    for (auto &InputFileName : InputFileNames)
+    {
+        File InputFile = CurrentDirectory.getChildFile(InputFileName);
+        File OutputFile = OutputDirectory.getChildFile(
+                              InputFile.getFileNameWithoutExtension() + ".wav");
+
+        // never overwrite input files
+        if (OutputFile == InputFile)
+        {
+            std::cerr << "output would overwrite \"" << InputFile.getFullPathName() << "\"\n";
+            return 1;
+        }
+
+        Renderer.addJob(InputFile, OutputFile);
+    }
+
+    std::cout << "rendering " << Renderer.getNumberOfJobs() << " files using "
+              << Renderer.getNumberOfThreads() << " threads\n";
+
+    Renderer.start();
+
+    while (!Renderer.isFinished())
+    {
+        printProgress(Renderer);
+        Thread::sleep(250);
+    }
+
+    Renderer.stop();
+    printProgress(Renderer);
+
+    std::cout << "\n"
+              << String(Renderer.getElapsedTime(), 3) << " s, "
+              << Renderer.getNumberOfSamples() << " samples ("
+              << String(Renderer.getSamplesPerSecond(), 0) << " samples/s)\n";
+
+    for (auto &ErrorMessage : Renderer.getErrorMessages())
+    {
+        std::cerr << "error: " << ErrorMessage << "\n";
+    }
+
+    return (Renderer.getNumberOfFailedJobs() > 0) ? 1 : 0;
+}
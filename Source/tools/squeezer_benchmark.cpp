@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+// Micro-benchmarks for the DSP hot paths; results are written as JSON
+// (nanoseconds per sample).
+//
+//   squeezer_benchmark [--filter NAME] [--min-time MS] [--trials N]
+//                      [--output FILE]
+
+#include "dsp_benchmark.h"
+
+#include <iostream>
+
+
+static void printUsage()
+{
+    std::cerr << "usage: squeezer_benchmark [--filter NAME] [--min-time MS] [--trials N]\n"
+              << "                          [--output FILE]\n"
+              << "\n"
+              << "  --filter NAME   only run benchmarks whose name contains NAME\n"
+              << "  --min-time MS   minimum duration of a trial (default: 10 ms)\n"
+              << "  --trials N      trials per measurement; the fastest one is\n"
+              << "                  reported (default: 3)\n"
+              << "  --output FILE   write JSON to FILE instead of standard output\n";
+}
+
+
+int main(int argc, char *argv[])
+{
+    String Filter;
+    String OutputFileName;
+
+    double MinimumTrialTime = 0.010;
+    int NumberOfTrials = 3;
+
+    for (int n = 1; n < argc; ++n)
+    {
+        String Argument(argv[n]);
+
+        if ((Argument == "--help") || (Argument == "-h"))
+        {
+            printUsage();
+            return 0;
+        }
+
+        if ((Argument != "--filter") &&
+                (Argument != "--min-time") &&
+                (Argument != "--trials") &&
+                (Argument != "--output"))
+        {
+            printUsage();
+            return 1;
+        }
+
+        if (++n >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        String Value(argv[n]);
+
+        if (Argument == "--filter")
+        {
+            Filter = Value;
+        }
+        else if (Argument == "--output")
+        {
+            OutputFileName = Value;
+        }
+        else if (Argument == "--min-time")
+        {
+            MinimumTrialTime = Value.getDoubleValue() / 1000.0;
+
+            if (MinimumTrialTime <= 0.0)
+            {
+                std::cerr << "minimum trial time must be positive\n";
+                return 1;
+            }
+        }
+        else
+        {
+            NumberOfTrials = Value.getIntValue();
+
+            if (NumberOfTrials <= 0)
+            {
+                std::cerr << "number of trials must be positive\n";
+                return 1;
+            }
+        }
+    }
+
+    DspBenchmark Benchmark(MinimumTrialTime, NumberOfTrials);
+    Benchmark.run(Filter);
+
+    if (Benchmark.getNumberOfResults() == 0)
+    {
+        std::cerr << "no benchmark matches \"" << Filter << "\"\n";
+        return 1;
+    }
+
+    String Json = Benchmark.toJson();
+
+    if (OutputFileName.isEmpty())
+    {
+        std::cout << Json;
+    }
+    else
+    {
+        File OutputFile = File::getCurrentWorkingDirectory().getChildFile(OutputFileName);
+
+        if (!OutputFile.replaceWithText(Json))
+        {
+            std::cerr << "could not write \"" << OutputFile.getFullPathName() << "\"\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
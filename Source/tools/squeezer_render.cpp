@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+// Headless renderer: compresses audio files using a preset and
+// reports how much faster than realtime they were processed.
+//
+//   squeezer_render [--block-size N] PRESET INPUT OUTPUT
+
+#include "offline_renderer.h"
+
+#include <iostream>
+
+
+static void printUsage()
+{
+    std::cerr << "usage: squeezer_render [--block-size N] PRESET INPUT OUTPUT\n"
+              << "\n"
+              << "  PRESET  Squeezer settings (XML)\n"
+              << "  INPUT   audio file (1, 2 or 4 channels; channels 3 and 4\n"
+              << "          feed the external side chain)\n"
+              << "  OUTPUT  rendered WAV file (will be overwritten)\n"
+              << "\n"
+              << "  --block-size N  process N samples at a time (default: 512)\n";
+}
+
+
+int main(int argc, char *argv[])
+{
+    StringArray Arguments;
+    int BlockSize = 512;
+
+    for (int n = 1; n < argc; ++n)
+    {
+        String Argument(argv[n]);
+
+        if (Argument == "--block-size")
+        {
+            if (++n >= argc)
+            {
+                printUsage();
+                return 1;
+            }
+
+            BlockSize = String(argv[n]).getIntValue();
+
+            if (BlockSize <= 0)
+            {
+                std::cerr << "block size must be positive\n";
+                return 1;
+            }
+        }
+        else if ((Argument == "--help") || (Argument == "-h"))
+        {
+            printUsage();
+            return 0;
+        }
+        else
+        {
+            Arguments.add(Argument);
+        }
+    }
+
+    if (Arguments.size() != 3)
+    {
+        printUsage();
+        return 1;
+    }
+
+    File CurrentDirectory = File::getCurrentWorkingDirectory();
+
+    File PresetFile = CurrentDirectory.getChildFile(Arguments[0]);
+    File InputFile = CurrentDirectory.getChildFile(Arguments[1]);
+    File OutputFile = CurrentDirectory.getChildFile(Arguments[2]);
+
+    OfflineRenderer Renderer(BlockSize);
+
+    if (!Renderer.loadPreset(PresetFile) ||
+            !Renderer.render(InputFile, OutputFile))
+    {
+        std::cerr << "error: " << Renderer.getErrorMessage() << "\n";
+        return 1;
+    }
+
+    double AudioLength = Renderer.getNumberOfSamples() / Renderer.getSampleRate();
+    double RealtimeFactorTotal = 0.0;
+
+    if (Renderer.getTotalTime() > 0.0)
+    {
+        RealtimeFactorTotal = AudioLength / Renderer.getTotalTime();
+    }
+
+    std::cout << InputFile.getFileName() << ": "
+              << String(AudioLength, 2) << " s of audio, "
+              << String(Renderer.getProcessingTime(), 3) << " s processing ("
+              << String(Renderer.getRealtimeFactor(), 1) << "x realtime), "
+              << String(Renderer.getTotalTime(), 3) << " s total ("
+              << String(RealtimeFactorTotal, 1) << "x realtime)\n";
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+// Golden-output regression test: renders fixed test signals through
+// all designs, curves and gain stages and checks that every engine
+// nulls against the reference engine (per-sample, double precision).
+// Afterwards, audio is processed through the plug-in itself, so that
+// debug builds assert on memory allocation in its audio thread.
+//
+//   squeezer_validate [--material DIR] [--seconds N] [--filter NAME]
+//                     [--record DIR | --compare DIR] [--verbose]
+
+#include "golden_validator.h"
+#include "../plugin_processor.h"
+
+#include <iostream>
+
+
+static void printUsage()
+{
+    std::cerr << "usage: squeezer_validate [--material DIR] [--seconds N] [--filter NAME]\n"
+              << "                         [--record DIR | --compare DIR] [--verbose]\n"
+              << "\n"
+              << "  --material DIR  add recordings from DIR to the test signals\n"
+              << "                  (default: validation/trim_test/Recorded)\n"
+              << "  --seconds N     length of test signals (default: 3)\n"
+              << "  --filter NAME   only validate test cases containing NAME\n"
+              << "  --record DIR    store reference renders in DIR\n"
+              << "  --compare DIR   also compare reference engine with renders\n"
+              << "                  stored in DIR\n"
+              << "  --verbose       report passed checks, too\n";
+}
+
+
+template <typename SampleType>
+static void processPlugin(SqueezerAudioProcessor &Processor,
+                          double SampleRate,
+                          int MaximumBlockSize)
+/*  Process noise through the plug-in in blocks of varying size
+    (including empty blocks and blocks exceeding the announced
+    size).  The plug-in guards its audio thread, so debug builds
+    assert on memory allocation.
+
+    Processor (SqueezerAudioProcessor): plug-in to be tested
+
+    SampleRate (double): sample rate of the host
+
+    MaximumBlockSize (integer): block size announced by the host
+
+    return value: none
+ */
+{
+    bool IsDoublePrecision = std::is_same<SampleType, double>::value;
+
+    Processor.setProcessingPrecision(
+        IsDoublePrecision ? AudioProcessor::doublePrecision :
+        AudioProcessor::singlePrecision);
+
+    Processor.setRateAndBufferSizeDetails(SampleRate, MaximumBlockSize);
+    Processor.prepareToPlay(SampleRate, MaximumBlockSize);
+
+    const int NumberOfBlockSizes = 5;
+    int BlockSizes[NumberOfBlockSizes] = {MaximumBlockSize,
+                                          1,
+                                          0,
+                                          MaximumBlockSize / 3,
+                                          MaximumBlockSize * 2
+                                         };
+
+    int NumberOfChannels = jmax(Processor.getTotalNumInputChannels(),
+                                Processor.getTotalNumOutputChannels());
+
+    // allocate before processing
+    AudioBuffer<SampleType> Buffer(NumberOfChannels, MaximumBlockSize * 2);
+    MidiBuffer MidiMessages;
+    Random Generator(42);
+
+    for (int BlockIndex = 0; BlockIndex < 200; ++BlockIndex)
+    {
+        int BlockSize = BlockSizes[BlockIndex % NumberOfBlockSizes];
+
+        // refers to existing data (does not allocate memory)
+        AudioBuffer<SampleType> Block(Buffer.getArrayOfWritePointers(),
+                                      NumberOfChannels,
+                                      BlockSize);
+
+        for (int Channel = 0; Channel < NumberOfChannels; ++Channel)
+        {
+            SampleType *Samples = Block.getWritePointer(Channel);
+
+            for (int Sample = 0; Sample < BlockSize; ++Sample)
+            {
+                Samples[Sample] = (SampleType)(Generator.nextFloat() - 0.5f);
+            }
+        }
+
+        Processor.processBlock(Block, MidiMessages);
+    }
+
+    Processor.releaseResources();
+}
+
+
+static void validatePlugin()
+/*  Process audio through the plug-in in both designs (and thus with
+    both engines) for hosts with float and double buffers.  The
+    golden test only drives the compressor, so this covers buffer
+    conversion, look-ahead, oversampling and metering in the
+    plug-in's audio thread.
+
+    return value: none
+ */
+{
+    // the plug-in starts a timer, which needs a message manager
+    ScopedJuceInitialiser_GUI JuceInitialiser;
+    SqueezerAudioProcessor Processor;
+
+    // meters are only updated while anybody reads them
+    Processor.addMeterConsumer();
+
+    // normalised values; select maximum look-ahead and oversampling
+    Processor.setParameter(SqueezerPluginParameters::selLookAhead, 1.0f);
+    Processor.setParameter(SqueezerPluginParameters::selOversampling, 1.0f);
+    Processor.setParameter(SqueezerPluginParameters::selTruePeakMeters, 1.0f);
+    Processor.setParameter(SqueezerPluginParameters::selLoudnessMeters, 1.0f);
+
+    for (int Design = 0; Design < CompressorBase::NumberOfDesigns; ++Design)
+    {
+        float DesignNormalised = (float) Design /
+                                 (float)(CompressorBase::NumberOfDesigns - 1);
+
+        Processor.setParameter(SqueezerPluginParameters::selDesign,
+                               DesignNormalised);
+
+        processPlugin<float>(Processor, 44100.0, 512);
+        processPlugin<double>(Processor, 44100.0, 512);
+    }
+
+    Processor.removeMeterConsumer();
+}
+
+
+int main(int argc, char *argv[])
+{
+    File CurrentDirectory = File::getCurrentWorkingDirectory();
+
+    File MaterialDirectory = CurrentDirectory.getChildFile("validation/trim_test/Recorded");
+    bool MaterialIsOptional = true;
+
+    File ReferenceDirectory;
+    bool RecordReferences = false;
+
+    String Filter;
+    double SignalLength = 3.0;
+    bool Verbose = false;
+
+    for (int n = 1; n < argc; ++n)
+    {
+        String Argument(argv[n]);
+
+        if ((Argument == "--help") || (Argument == "-h"))
+        {
+            printUsage();
+            return 0;
+        }
+        else if (Argument == "--verbose")
+        {
+            Verbose = true;
+            continue;
+        }
+        else if ((Argument != "--material") &&
+                 (Argument != "--seconds") &&
+                 (Argument != "--filter") &&
+                 (Argument != "--record") &&
+                 (Argument != "--compare"))
+        {
+            printUsage();
+            return 1;
+        }
+
+        if (++n >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+
+        String Value(argv[n]);
+
+        if (Argument == "--material")
+        {
+            MaterialDirectory = CurrentDirectory.getChildFile(Value);
+            MaterialIsOptional = false;
+        }
+        else if (Argument == "--seconds")
+        {
+            SignalLength = Value.getDoubleValue();
+
+            if (SignalLength <= 0.0)
+            {
+                std::cerr << "length of test signals must be positive\n";
+                return 1;
+            }
+        }
+        else if (Argument == "--filter")
+        {
+            Filter = Value;
+        }
+        else
+        {
+            if (ReferenceDirectory.getFullPathName().isNotEmpty())
+            {
+                printUsage();
+                return 1;
+            }
+
+            ReferenceDirectory = CurrentDirectory.getChildFile(Value);
+            RecordReferences = (Argument == "--record");
+        }
+    }
+
+    // block sizes of up to 1024 samples are validated
+    GoldenValidator Validator(SignalLength, 1024);
+
+    if (MaterialDirectory.isDirectory() || !MaterialIsOptional)
+    {
+        if (!Validator.addRecordings(MaterialDirectory))
+        {
+            std::cerr << "error: " << Validator.getErrorMessage() << "\n";
+            return 1;
+        }
+    }
+
+    Validator.setFilter(Filter);
+    Validator.setVerbose(Verbose);
+
+    if (!Validator.run(ReferenceDirectory, RecordReferences))
+    {
+        std::cerr << "error: " << Validator.getErrorMessage() << "\n";
+        return 1;
+    }
+
+    std::cout << Validator.getNumberOfChecks() << " checks, "
+              << Validator.getNumberOfFailures() << " failed\n";
+
+    // justifies processing feed-back designs in double precision
+    std::cout << "single precision, worst peak difference from reference: "
+              << String(Validator.getSinglePrecisionDifference(
+                            CompressorBase::DesignFeedForward), 1)
+              << " dB (feed-forward), "
+              << String(Validator.getSinglePrecisionDifference(
+                            CompressorBase::DesignFeedBack), 1)
+              << " dB (feed-back)\n";
+
+    // assert on memory allocation in the plug-in's audio thread
+    // (debug builds only)
+    validatePlugin();
+
+    return (Validator.getNumberOfFailures() > 0) ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "true_peak_analyser.h"
+
+
+template <typename SampleType>
+TruePeakAnalyser<SampleType>::TruePeakAnalyser(int channels,
+                                               int meter_buffer_size) :
+    Thread("Squeezer true-peak meter"),
+    NumberOfChannels(channels),
+    MeterBufferSize(meter_buffer_size),
+    QueuedSlots(NumberOfSlots),
+    WriteSlot(-1),
+    WritePosition(0),
+    SlotSamples(2 * NumberOfChannels, NumberOfSlots * MeterBufferSize),
+    OversampledSamples(1, OversamplingFactor * MeterBufferSize),
+    Levels(new Atomic<float>[2 * NumberOfChannels])
+{
+    jassert(NumberOfChannels > 0);
+    jassert(MeterBufferSize > 0);
+
+    InputOversampler.reset(
+        new frut::dsp::Oversampler<SampleType>(
+            NumberOfChannels, OversamplingFactor, MeterBufferSize));
+
+    OutputOversampler.reset(
+        new frut::dsp::Oversampler<SampleType>(
+            NumberOfChannels, OversamplingFactor, MeterBufferSize));
+}
+
+
+template <typename SampleType>
+TruePeakAnalyser<SampleType>::~TruePeakAnalyser()
+{
+    stopThread(1000);
+}
+
+
+template <typename SampleType>
+void TruePeakAnalyser<SampleType>::start()
+/*  Discard queued meter buffers and measured levels, and start
+    background thread.  Must not be called while samples are pushed.
+
+    return value: none
+ */
+{
+    QueuedSlots.reset();
+    WriteSlot = -1;
+    WritePosition = 0;
+
+    for (int Index = 0; Index < 2 * NumberOfChannels; ++Index)
+    {
+        Levels[Index] = 0.0f;
+    }
+
+    // meters are not important enough to compete with anything else
+    startThread(1);
+}
+
+
+template <typename SampleType>
+void TruePeakAnalyser<SampleType>::stop()
+/*  Stop background thread.  Blocks until the thread has exited, so
+    do not call this function on the audio thread!
+
+    return value: none
+ */
+{
+    stopThread(1000);
+}
+
+
+template <typename SampleType>
+void TruePeakAnalyser<SampleType>::push(
+    const AudioBuffer<SampleType> &InputBuffer,
+    const AudioBuffer<SampleType> &OutputBuffer,
+    int NumberOfSamples)
+/*  Add samples to meter buffer; full meter buffers are queued for
+    analysis.  Lock-free; must only be called by a single writer
+    (usually the audio thread).
+
+    InputBuffer (AudioBuffer): input samples
+
+    OutputBuffer (AudioBuffer): output samples
+
+    NumberOfSamples (integer): number of samples to add
+
+    return value: none
+ */
+{
+    jassert(InputBuffer.getNumSamples() >= NumberOfSamples);
+    jassert(OutputBuffer.getNumSamples() >= NumberOfSamples);
+
+    int StartSample = 0;
+
+    while (StartSample < NumberOfSamples)
+    {
+        // start new meter buffer
+        if (WritePosition == 0)
+        {
+            int StartIndex1, BlockSize1, StartIndex2, BlockSize2;
+            QueuedSlots.prepareToWrite(1, StartIndex1, BlockSize1,
+                                       StartIndex2, BlockSize2);
+
+            // drop meter buffer when the worker has fallen behind
+            WriteSlot = (BlockSize1 > 0) ? StartIndex1 : -1;
+        }
+
+        // copy samples up to the end of the meter buffer
+        int SamplesToCopy = jmin(NumberOfSamples - StartSample,
+                                 MeterBufferSize - WritePosition);
+
+        if (WriteSlot >= 0)
+        {
+            int SlotSample = WriteSlot * MeterBufferSize + WritePosition;
+
+            for (int CurrentChannel = 0; CurrentChannel < NumberOfChannels; ++CurrentChannel)
+            {
+                SlotSamples.copyFrom(CurrentChannel, SlotSample,
+                                     InputBuffer, CurrentChannel,
+                                     StartSample, SamplesToCopy);
+
+                SlotSamples.copyFrom(NumberOfChannels + CurrentChannel, SlotSample,
+                                     OutputBuffer, CurrentChannel,
+                                     StartSample, SamplesToCopy);
+            }
+        }
+
+        WritePosition += SamplesToCopy;
+        StartSample += SamplesToCopy;
+
+        // queue full meter buffer
+        if (WritePosition == MeterBufferSize)
+        {
+            WritePosition = 0;
+
+            if (WriteSlot >= 0)
+            {
+                QueuedSlots.finishedWrite(1);
+            }
+        }
+    }
+}
+
+
+template <typename SampleType>
+SampleType TruePeakAnalyser<SampleType>::popInputLevel(int CurrentChannel)
+/*  Get highest input true-peak level measured since the last call.
+    Lock-free.
+
+    CurrentChannel (integer): selected audio channel
+
+    return value (SampleType): returns linear true-peak level (zero
+    when nothing has been measured since the last call)
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return SampleType(Levels[CurrentChannel].exchange(0.0f));
+}
+
+
+template <typename SampleType>
+SampleType TruePeakAnalyser<SampleType>::popOutputLevel(int CurrentChannel)
+/*  Get highest output true-peak level measured since the last call.
+    Lock-free.
+
+    CurrentChannel (integer): selected audio channel
+
+    return value (SampleType): returns linear true-peak level (zero
+    when nothing has been measured since the last call)
+*/
+{
+    jassert(CurrentChannel >= 0);
+    jassert(CurrentChannel < NumberOfChannels);
+
+    return SampleType(Levels[NumberOfChannels + CurrentChannel].exchange(0.0f));
+}
+
+
+template <typename SampleType>
+void TruePeakAnalyser<SampleType>::run()
+{
+    while (!threadShouldExit())
+    {
+        int StartIndex1, BlockSize1, StartIndex2, BlockSize2;
+        QueuedSlots.prepareToRead(1, StartIndex1, BlockSize1,
+                                  StartIndex2, BlockSize2);
+
+        // polling keeps the audio thread from having to wake up this
+        // thread (which might block)
+        if (BlockSize1 == 0)
+        {
+            wait(PollingIntervalMilliSeconds);
+            continue;
+        }
+
+        analyseSlot(StartIndex1);
+        QueuedSlots.finishedRead(1);
+    }
+}
+
+
+template <typename SampleType>
+void TruePeakAnalyser<SampleType>::analyseSlot(int Slot)
+{
+    int StartSample = Slot * MeterBufferSize;
+    int NumberOfOversampledSamples = OversamplingFactor * MeterBufferSize;
+
+    for (int CurrentChannel = 0; CurrentChannel < 2 * NumberOfChannels; ++CurrentChannel)
+    {
+        bool IsInput = (CurrentChannel < NumberOfChannels);
+
+        frut::dsp::Oversampler<SampleType> &ChannelOversampler =
+            IsInput ? *InputOversampler : *OutputOversampler;
+        int OversamplerChannel = IsInput ? CurrentChannel :
+                                 CurrentChannel - NumberOfChannels;
+
+        // the oversampler keeps the original samples, so true peaks
+        // are never lower than sample peaks
+        ChannelOversampler.upsample(
+            OversamplerChannel,
+            SlotSamples.getReadPointer(CurrentChannel, StartSample),
+            OversampledSamples.getWritePointer(0),
+            MeterBufferSize);
+
+        SampleType TruePeak = OversampledSamples.getMagnitude(
+                                  0, 0, NumberOfOversampledSamples);
+
+        raiseLevel(CurrentChannel, (float) TruePeak);
+    }
+}
+
+
+template <typename SampleType>
+void TruePeakAnalyser<SampleType>::raiseLevel(int Index, float Level)
+{
+    // the reader may reset the level at any time
+    float OldLevel = Levels[Index].get();
+
+    while (Level > OldLevel)
+    {
+        if (Levels[Index].compareAndSetBool(Level, OldLevel))
+        {
+            break;
+        }
+
+        OldLevel = Levels[Index].get();
+    }
+}
+
+
+// explicit instantiation of all template instances
+template class TruePeakAnalyser<float>;
+template class TruePeakAnalyser<double>;
@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_TRUE_PEAK_ANALYSER_H
+#define SQUEEZER_TRUE_PEAK_ANALYSER_H
+
+#include "FrutHeader.h"
+
+
+// measures true-peak levels (ITU-R BS.1770) on a low-priority
+// background thread; the audio thread collects samples in meter
+// buffers of fixed size and hands them over through a lock-free
+// FIFO, so it neither waits for the analysis nor allocates memory;
+// the thread only runs between "start" and "stop"
+template <typename SampleType>
+class TruePeakAnalyser :
+    private Thread
+{
+public:
+    enum Parameters  // public namespace!
+    {
+        // BS.1770 oversamples by a factor of four
+        OversamplingFactor = 4,
+
+        // meter buffers that may be queued (dropped when exceeded)
+        NumberOfSlots = 8,
+
+        // time between checks for queued meter buffers
+        PollingIntervalMilliSeconds = 20,
+    };
+
+    TruePeakAnalyser(int channels,
+                     int meter_buffer_size);
+    ~TruePeakAnalyser();
+
+    void start();
+    void stop();
+
+    void push(const AudioBuffer<SampleType> &InputBuffer,
+              const AudioBuffer<SampleType> &OutputBuffer,
+              int NumberOfSamples);
+
+    SampleType popInputLevel(int CurrentChannel);
+    SampleType popOutputLevel(int CurrentChannel);
+
+private:
+    JUCE_LEAK_DETECTOR(TruePeakAnalyser);
+
+    void run() override;
+    void analyseSlot(int Slot);
+    void raiseLevel(int Index, float Level);
+
+    const int NumberOfChannels;
+    const int MeterBufferSize;
+
+    AbstractFifo QueuedSlots;
+
+    // slot that is currently filled by the writer (negative while
+    // samples are dropped) and number of samples written to it
+    int WriteSlot;
+    int WritePosition;
+
+    // input channels followed by output channels; holds one meter
+    // buffer per slot
+    AudioBuffer<SampleType> SlotSamples;
+    AudioBuffer<SampleType> OversampledSamples;
+
+    std::unique_ptr<frut::dsp::Oversampler<SampleType>> InputOversampler;
+    std::unique_ptr<frut::dsp::Oversampler<SampleType>> OutputOversampler;
+
+    // highest linear level since last read (input channels followed
+    // by output channels)
+    std::unique_ptr<Atomic<float>[]> Levels;
+};
+
+#endif  // SQUEEZER_TRUE_PEAK_ANALYSER_H
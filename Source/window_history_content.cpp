@@ -0,0 +1,230 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "window_history_content.h"
+
+
+WindowHistoryContent::WindowHistoryContent(
+    AudioProcessorEditor *PluginEditor,
+    GainReductionHistory *History) :
+    PluginEditor_(PluginEditor),
+    History_(History),
+    BinMinima_(GainReductionHistory::BinsPerLevel),
+    BinMaxima_(GainReductionHistory::BinsPerLevel),
+    BinLevelMinima_(GainReductionHistory::BinsPerLevel),
+    BinLevelMaxima_(GainReductionHistory::BinsPerLevel)
+{
+    jassert(History_ != nullptr);
+
+    // item IDs are time spans in seconds
+    ComboBoxTimeSpan_.addItem("10 s", 10);
+    ComboBoxTimeSpan_.addItem("30 s", 30);
+    ComboBoxTimeSpan_.addItem("1 min", 60);
+    ComboBoxTimeSpan_.addItem("3 min", 180);
+    ComboBoxTimeSpan_.addItem("10 min", 600);
+
+    ComboBoxTimeSpan_.setSelectedId(10, dontSendNotification);
+    ComboBoxTimeSpan_.addListener(this);
+    addAndMakeVisible(ComboBoxTimeSpan_);
+
+    ButtonClose_.setButtonText("Close");
+    ButtonClose_.setColour(TextButton::buttonColourId, Colours::yellow);
+    ButtonClose_.setColour(TextButton::textColourOffId, Colours::black);
+    ButtonClose_.addListener(this);
+    addAndMakeVisible(ButtonClose_);
+
+    setSize(600, 260);
+
+    // the processor merges new bins into the history, so only redraw
+    startTimerHz(20);
+}
+
+
+DialogWindow *WindowHistoryContent::createDialogWindow(
+    AudioProcessorEditor *PluginEditor,
+    GainReductionHistory *History)
+{
+    // prepare dialog window
+    DialogWindow::LaunchOptions WindowHistoryLauncher;
+
+    WindowHistoryLauncher.dialogTitle = String("Gain Reduction History");
+    WindowHistoryLauncher.dialogBackgroundColour = Colours::white;
+    WindowHistoryLauncher.content.setOwned(
+        new WindowHistoryContent(PluginEditor, History));
+    WindowHistoryLauncher.componentToCentreAround = PluginEditor;
+
+    WindowHistoryLauncher.escapeKeyTriggersCloseButton = true;
+    WindowHistoryLauncher.useNativeTitleBar = false;
+    WindowHistoryLauncher.resizable = false;
+    WindowHistoryLauncher.useBottomRightCornerResizer = false;
+
+    // launch dialog window
+    DialogWindow *WindowHistory = WindowHistoryLauncher.launchAsync();
+    WindowHistory->setAlwaysOnTop(true);
+
+    return WindowHistory;
+}
+
+
+void WindowHistoryContent::paint(Graphics &g)
+{
+    // gain reduction meters show the same range; output level is
+    // drawn at half the scale (right-hand labels)
+    const float MaximumGainReduction = 18.0f;
+    const float MinimumLevel = -36.0f;
+
+    Rectangle<int> PlotArea = getLocalBounds().withTrimmedLeft(30).withTrimmedRight(30).withTrimmedBottom(37).reduced(5);
+
+    float Top = (float) PlotArea.getY();
+    float Height = (float) PlotArea.getHeight();
+
+    g.fillAll(Colours::black);
+
+    // scale (every 3 dB)
+    g.setFont(12.0f);
+
+    for (int Decibel = 0; Decibel <= MaximumGainReduction; Decibel += 3)
+    {
+        int Y = roundToInt(Top + Height * Decibel / MaximumGainReduction);
+
+        g.setColour(Colours::darkgrey);
+        g.drawHorizontalLine(Y, (float) PlotArea.getX(), (float) PlotArea.getRight());
+
+        g.setColour(Colours::lightgrey);
+        g.drawText(String(-Decibel), 0, Y - 6, 28, 12,
+                   Justification::centredRight, false);
+
+        g.drawText(String(roundToInt(Decibel * MinimumLevel / MaximumGainReduction)),
+                   getWidth() - 28, Y - 6, 28, 12,
+                   Justification::centredLeft, false);
+    }
+
+    // history may not be read once the editor has been closed
+    if (PluginEditor_ == nullptr)
+    {
+        return;
+    }
+
+    double TimeSpan = ComboBoxTimeSpan_.getSelectedId();
+    int Width = PlotArea.getWidth();
+
+    int Level = GainReductionHistory::getLevel(TimeSpan, Width);
+    int BinsInTimeSpan = jmax(
+                             roundToInt(TimeSpan / GainReductionHistory::getBinLength(Level)),
+                             1);
+
+    // right-align history that is shorter than the time span
+    int NumberOfBins = jmin(BinsInTimeSpan, History_->getNumberOfBins(Level));
+    History_->getBins(Level, NumberOfBins, BinMinima_, BinMaxima_,
+                      BinLevelMinima_, BinLevelMaxima_);
+
+    float BinWidth = Width / (float) BinsInTimeSpan;
+    float Left = PlotArea.getRight() - NumberOfBins * BinWidth;
+
+    // output level is drawn behind gain reduction
+    g.setColour(Colours::darkgrey.brighter(0.4f));
+
+    for (int Bin = 0; Bin < NumberOfBins; ++Bin)
+    {
+        float Minimum = jlimit(MinimumLevel, 0.0f, BinLevelMinima_[Bin]);
+        float Maximum = jlimit(MinimumLevel, 0.0f, BinLevelMaxima_[Bin]);
+
+        float BinTop = Top + Height * Maximum / MinimumLevel;
+        float BinHeight = Height * (Maximum - Minimum) / -MinimumLevel;
+
+        g.fillRect(Left + Bin * BinWidth, BinTop,
+                   jmax(BinWidth, 1.0f), jmax(BinHeight, 1.0f));
+    }
+
+    // same colour as gain reduction meters
+    g.setColour(Colour(0.58f, 1.0f, 1.0f, 1.0f));
+
+    for (int Bin = 0; Bin < NumberOfBins; ++Bin)
+    {
+        float Minimum = jlimit(0.0f, MaximumGainReduction, BinMinima_[Bin]);
+        float Maximum = jlimit(0.0f, MaximumGainReduction, BinMaxima_[Bin]);
+
+        float BinTop = Top + Height * Minimum / MaximumGainReduction;
+        float BinHeight = Height * (Maximum - Minimum) / MaximumGainReduction;
+
+        g.fillRect(Left + Bin * BinWidth, BinTop,
+                   jmax(BinWidth, 1.0f), jmax(BinHeight, 1.0f));
+    }
+}
+
+
+void WindowHistoryContent::resized()
+{
+    int Width = getWidth();
+    int Height = getHeight();
+
+    ComboBoxTimeSpan_.setBounds(35, Height - 29, 80, 20);
+    ButtonClose_.setBounds(Width / 2 - 30, Height - 29, 60, 20);
+}
+
+
+void WindowHistoryContent::buttonClicked(Button *Button)
+{
+    // user wants to close the window
+    if (Button == &ButtonClose_)
+    {
+        closeButtonPressed();
+    }
+}
+
+
+void WindowHistoryContent::comboBoxChanged(ComboBox *ComboBox)
+{
+    if (ComboBox == &ComboBoxTimeSpan_)
+    {
+        repaint();
+    }
+}
+
+
+void WindowHistoryContent::closeButtonPressed()
+{
+    // get parent dialog window
+    DialogWindow *WindowHistory = findParentComponentOfClass<DialogWindow>();
+
+    if (WindowHistory != nullptr)
+    {
+        // close dialog window (exit value 0)
+        WindowHistory->exitModalState(0);
+    }
+}
+
+
+void WindowHistoryContent::timerCallback()
+{
+    // close window along with the editor
+    if (PluginEditor_ == nullptr)
+    {
+        closeButtonPressed();
+        return;
+    }
+
+    repaint();
+}
@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+
+   Squeezer
+   ========
+   Flexible general-purpose audio compressor with a touch of citrus
+
+   Copyright (c) 2013-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef SQUEEZER_WINDOW_HISTORY_CONTENT_H
+#define SQUEEZER_WINDOW_HISTORY_CONTENT_H
+
+#include "FrutHeader.h"
+#include "gain_reduction_history.h"
+
+
+// dialog window that draws the gain reduction and output level
+// history of a selectable time span (10 seconds to 10 minutes); every
+// span is drawn from the history level with at most one bin per
+// pixel, so drawing costs the same regardless of the time span
+class WindowHistoryContent :
+    public Component,
+    public Button::Listener,
+    public ComboBox::Listener,
+    private Timer
+{
+public:
+    WindowHistoryContent(AudioProcessorEditor *PluginEditor,
+                         GainReductionHistory *History);
+
+    static DialogWindow *createDialogWindow(AudioProcessorEditor *PluginEditor,
+                                            GainReductionHistory *History);
+
+    void paint(Graphics &g);
+    void resized();
+
+    void buttonClicked(Button *Button);
+    void comboBoxChanged(ComboBox *ComboBox);
+    void closeButtonPressed();
+
+private:
+    JUCE_LEAK_DETECTOR(WindowHistoryContent);
+
+    void timerCallback();
+
+    // the history is owned by the processor, which may already be
+    // gone once the editor has been closed
+    Component::SafePointer<AudioProcessorEditor> PluginEditor_;
+    GainReductionHistory *History_;
+
+    HeapBlock<float> BinMinima_;
+    HeapBlock<float> BinMaxima_;
+    HeapBlock<float> BinLevelMinima_;
+    HeapBlock<float> BinLevelMaxima_;
+
+    ComboBox ComboBoxTimeSpan_;
+    TextButton ButtonClose_;
+};
+
+#endif  // SQUEEZER_WINDOW_HISTORY_CONTENT_H